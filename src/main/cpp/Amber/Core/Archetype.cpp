@@ -0,0 +1,281 @@
+#include "Archetype.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace Amber
+{
+    namespace Core
+    {
+        namespace
+        {
+            std::size_t alignUp(std::size_t offset, std::size_t alignment)
+            {
+                return (offset + alignment - 1) / alignment * alignment;
+            }
+        }
+
+        const std::size_t Archetype::ChunkByteSize;
+        const std::size_t Archetype::npos;
+        const std::uint32_t Archetype::InvalidEntity;
+
+        Archetype::Chunk::Chunk(ChunkPool &pool, std::size_t byteSize, std::size_t alignment, std::size_t columnCount)
+            : pool(nullptr),
+              size(0),
+              columnCount(columnCount),
+              changeVersions(new std::atomic<std::uint32_t>[columnCount])
+        {
+            setChangeVersion(0);
+
+            if (byteSize <= pool.getChunkByteSize() && alignment <= ChunkPool::Alignment)
+            {
+                this->pool = &pool;
+                data = static_cast<unsigned char *>(pool.allocate());
+            }
+            else
+            {
+                memory.reset(new unsigned char[byteSize + alignment]);
+                std::uintptr_t address = reinterpret_cast<std::uintptr_t>(memory.get());
+                data = memory.get() + (alignUp(address, alignment) - address);
+            }
+        }
+
+        Archetype::Chunk::~Chunk()
+        {
+            if (pool != nullptr)
+            {
+                pool->deallocate(data);
+            }
+        }
+
+        std::size_t Archetype::Chunk::getSize() const
+        {
+            return size;
+        }
+
+        std::uint32_t Archetype::Chunk::getChangeVersion(std::size_t column) const
+        {
+            return changeVersions[column].load(std::memory_order_relaxed);
+        }
+
+        void Archetype::Chunk::setChangeVersion(std::size_t column, std::uint32_t version)
+        {
+            changeVersions[column].store(version, std::memory_order_relaxed);
+        }
+
+        void Archetype::Chunk::setChangeVersion(std::uint32_t version)
+        {
+            for (std::size_t column = 0; column < columnCount; column++)
+            {
+                setChangeVersion(column, version);
+            }
+        }
+
+        Archetype::Archetype(std::vector<const ComponentInfo *> components, ChunkPool &chunkPool)
+            : components(std::move(components)),
+              chunkPool(&chunkPool),
+              chunkAlignment(alignof(std::uint32_t)),
+              size(0)
+        {
+            columnsByType.fill(npos);
+            addTargets.fill(nullptr);
+            removeTargets.fill(nullptr);
+
+            for (std::size_t column = 0; column < this->components.size(); column++)
+            {
+                signature.set(this->components[column]->typeId);
+                columnsByType[this->components[column]->typeId] = column;
+            }
+
+            std::size_t rowSize = sizeof(std::uint32_t);
+            for (const ComponentInfo *component : this->components)
+            {
+                rowSize += component->size;
+                chunkAlignment = std::max(chunkAlignment, component->alignment);
+            }
+
+            // Shrink the capacity until the padding between columns fits as well
+            std::size_t capacity = std::max<std::size_t>(1, ChunkByteSize / rowSize);
+            while (true)
+            {
+                std::size_t offset = capacity * sizeof(std::uint32_t);
+
+                columnOffsets.clear();
+                for (const ComponentInfo *component : this->components)
+                {
+                    offset = alignUp(offset, component->alignment);
+                    columnOffsets.push_back(offset);
+                    offset += capacity * component->size;
+                }
+
+                if (offset <= ChunkByteSize || capacity == 1)
+                {
+                    chunkCapacity = capacity;
+                    chunkByteSize = offset;
+                    break;
+                }
+
+                capacity--;
+            }
+        }
+
+        Archetype::~Archetype()
+        {
+            for (std::size_t row = 0; row < size; row++)
+            {
+                for (std::size_t column = 0; column < components.size(); column++)
+                {
+                    components[column]->destroyFunction(getComponent(row, column));
+                }
+            }
+        }
+
+        const std::vector<const ComponentInfo *> &Archetype::getComponents() const
+        {
+            return components;
+        }
+
+        const ComponentSignature &Archetype::getSignature() const
+        {
+            return signature;
+        }
+
+        std::size_t Archetype::findColumn(ComponentTypeId typeId) const
+        {
+            return columnsByType[typeId];
+        }
+
+        std::size_t Archetype::getSize() const
+        {
+            return size;
+        }
+
+        std::size_t Archetype::getChunkCapacity() const
+        {
+            return chunkCapacity;
+        }
+
+        std::size_t Archetype::getChunkCount() const
+        {
+            return chunks.size();
+        }
+
+        Archetype::Chunk &Archetype::getChunk(std::size_t index)
+        {
+            return *chunks[index];
+        }
+
+        const Archetype::Chunk &Archetype::getChunk(std::size_t index) const
+        {
+            return *chunks[index];
+        }
+
+        void *Archetype::getColumn(Chunk &chunk, std::size_t column) const
+        {
+            return chunk.data + columnOffsets[column];
+        }
+
+        const void *Archetype::getColumn(const Chunk &chunk, std::size_t column) const
+        {
+            return chunk.data + columnOffsets[column];
+        }
+
+        const std::uint32_t *Archetype::getEntities(const Chunk &chunk) const
+        {
+            return reinterpret_cast<const std::uint32_t *>(chunk.data);
+        }
+
+        std::uint32_t *Archetype::getEntitySlots(Chunk &chunk) const
+        {
+            return reinterpret_cast<std::uint32_t *>(chunk.data);
+        }
+
+        void *Archetype::getComponent(std::size_t row, std::size_t column)
+        {
+            Chunk &chunk = *chunks[row / chunkCapacity];
+            return static_cast<unsigned char *>(getColumn(chunk, column)) + (row % chunkCapacity) * components[column]->size;
+        }
+
+        const void *Archetype::getComponent(std::size_t row, std::size_t column) const
+        {
+            const Chunk &chunk = *chunks[row / chunkCapacity];
+            return static_cast<const unsigned char *>(getColumn(chunk, column)) + (row % chunkCapacity) * components[column]->size;
+        }
+
+        std::uint32_t Archetype::getEntity(std::size_t row) const
+        {
+            return getEntities(*chunks[row / chunkCapacity])[row % chunkCapacity];
+        }
+
+        void Archetype::markChanged(std::size_t row, std::size_t column, std::uint32_t version)
+        {
+            chunks[row / chunkCapacity]->setChangeVersion(column, version);
+        }
+
+        std::size_t Archetype::allocate(std::uint32_t entity, std::uint32_t version)
+        {
+            if (size == chunks.size() * chunkCapacity)
+            {
+                chunks.emplace_back(new Chunk(*chunkPool, chunkByteSize, chunkAlignment, components.size()));
+            }
+
+            Chunk &chunk = *chunks.back();
+            getEntitySlots(chunk)[chunk.size] = entity;
+            chunk.size++;
+            chunk.setChangeVersion(version);
+
+            return size++;
+        }
+
+        std::uint32_t Archetype::remove(std::size_t row, std::uint32_t version)
+        {
+            assert(row < size);
+
+            std::size_t last = size - 1;
+            std::uint32_t movedEntity = InvalidEntity;
+
+            if (row != last)
+            {
+                for (std::size_t column = 0; column < components.size(); column++)
+                {
+                    void *source = getComponent(last, column);
+                    components[column]->moveConstructFunction(getComponent(row, column), source);
+                    components[column]->destroyFunction(source);
+                }
+
+                movedEntity = getEntity(last);
+                getEntitySlots(*chunks[row / chunkCapacity])[row % chunkCapacity] = movedEntity;
+                chunks[row / chunkCapacity]->setChangeVersion(version);
+            }
+
+            chunks.back()->size--;
+            if (chunks.back()->size == 0)
+            {
+                chunks.pop_back();
+            }
+
+            size--;
+            return movedEntity;
+        }
+
+        Archetype *Archetype::getAddTarget(ComponentTypeId typeId) const
+        {
+            return addTargets[typeId];
+        }
+
+        void Archetype::setAddTarget(ComponentTypeId typeId, Archetype *archetype)
+        {
+            addTargets[typeId] = archetype;
+        }
+
+        Archetype *Archetype::getRemoveTarget(ComponentTypeId typeId) const
+        {
+            return removeTargets[typeId];
+        }
+
+        void Archetype::setRemoveTarget(ComponentTypeId typeId, Archetype *archetype)
+        {
+            removeTargets[typeId] = archetype;
+        }
+    }
+}
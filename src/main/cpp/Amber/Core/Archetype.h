@@ -0,0 +1,125 @@
+#ifndef ARCHETYPE_H
+#define ARCHETYPE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <array>
+#include <memory>
+#include <vector>
+
+#include "Amber/Core/ChunkPool.h"
+#include "Amber/Core/ComponentInfo.h"
+#include "Amber/Core/ComponentType.h"
+
+namespace Amber
+{
+    namespace Core
+    {
+        // Stores all entities that have exactly the same set of components.
+        // Each component type gets its own contiguous column inside fixed size
+        // chunks, so iterating one component type touches memory linearly.
+        //
+        // Every column of a chunk carries the change version at which it was
+        // last written to, so readers can skip chunks that did not change.
+        class Archetype
+        {
+            public:
+                class Chunk
+                {
+                    public:
+                        // Takes its memory from the pool unless it does not fit there
+                        Chunk(ChunkPool &pool, std::size_t byteSize, std::size_t alignment, std::size_t columnCount);
+                        Chunk(const Chunk &other) = delete;
+                        ~Chunk();
+
+                        Chunk &operator =(const Chunk &other) = delete;
+
+                        std::size_t getSize() const;
+
+                        // May be called concurrently for the same chunk
+                        std::uint32_t getChangeVersion(std::size_t column) const;
+                        void setChangeVersion(std::size_t column, std::uint32_t version);
+
+                    private:
+                        friend class Archetype;
+
+                        void setChangeVersion(std::uint32_t version);
+
+                        ChunkPool *pool;
+                        std::unique_ptr<unsigned char[]> memory;
+                        unsigned char *data;
+                        std::size_t size;
+                        std::size_t columnCount;
+                        std::unique_ptr<std::atomic<std::uint32_t>[]> changeVersions;
+                };
+
+                static const std::size_t ChunkByteSize = 16 * 1024;
+                static const std::size_t npos = static_cast<std::size_t>(-1);
+                static const std::uint32_t InvalidEntity = static_cast<std::uint32_t>(-1);
+
+                Archetype(std::vector<const ComponentInfo *> components, ChunkPool &chunkPool);
+                Archetype(const Archetype &other) = delete;
+                ~Archetype();
+
+                Archetype &operator =(const Archetype &other) = delete;
+
+                const std::vector<const ComponentInfo *> &getComponents() const;
+                const ComponentSignature &getSignature() const;
+                std::size_t findColumn(ComponentTypeId typeId) const;
+
+                std::size_t getSize() const;
+                std::size_t getChunkCapacity() const;
+                std::size_t getChunkCount() const;
+
+                Chunk &getChunk(std::size_t index);
+                const Chunk &getChunk(std::size_t index) const;
+
+                void *getColumn(Chunk &chunk, std::size_t column) const;
+                const void *getColumn(const Chunk &chunk, std::size_t column) const;
+                const std::uint32_t *getEntities(const Chunk &chunk) const;
+
+                void *getComponent(std::size_t row, std::size_t column);
+                const void *getComponent(std::size_t row, std::size_t column) const;
+                std::uint32_t getEntity(std::size_t row) const;
+
+                // Marks the column of the chunk holding row as written at version
+                void markChanged(std::size_t row, std::size_t column, std::uint32_t version);
+
+                // Reserves a row for the entity. Its components are left uninitialized
+                // and all columns of its chunk are marked as written at version.
+                std::size_t allocate(std::uint32_t entity, std::uint32_t version);
+
+                // Fills the hole left at row (whose components must already be destroyed
+                // or moved out) with the last row, marking the hole's chunk as written
+                // at version. Returns the entity that was moved, if any.
+                std::uint32_t remove(std::size_t row, std::uint32_t version);
+
+                Archetype *getAddTarget(ComponentTypeId typeId) const;
+                void setAddTarget(ComponentTypeId typeId, Archetype *archetype);
+
+                Archetype *getRemoveTarget(ComponentTypeId typeId) const;
+                void setRemoveTarget(ComponentTypeId typeId, Archetype *archetype);
+
+            private:
+                std::uint32_t *getEntitySlots(Chunk &chunk) const;
+
+                std::vector<const ComponentInfo *> components;
+                ChunkPool *chunkPool;
+                ComponentSignature signature;
+                std::array<std::size_t, MaxComponentTypes> columnsByType;
+                std::vector<std::size_t> columnOffsets;
+                std::size_t chunkCapacity;
+                std::size_t chunkAlignment;
+                std::size_t chunkByteSize;
+
+                std::vector<std::unique_ptr<Chunk>> chunks;
+                std::size_t size;
+
+                std::array<Archetype *, MaxComponentTypes> addTargets;
+                std::array<Archetype *, MaxComponentTypes> removeTargets;
+        };
+    }
+}
+
+#endif // ARCHETYPE_H
@@ -0,0 +1,344 @@
+#include "ArchetypeStorage.h"
+
+#include <algorithm>
+#include <cassert>
+#include <stdexcept>
+
+namespace Amber
+{
+    namespace Core
+    {
+        ArchetypeStorage::ArchetypeStorage()
+            : chunkPool(Archetype::ChunkByteSize),
+              changeVersion(1),
+              emptyArchetype(findArchetype(std::vector<const ComponentInfo *>()))
+        {
+        }
+
+        ArchetypeStorage::~ArchetypeStorage()
+        {
+        }
+
+        EntityId ArchetypeStorage::create()
+        {
+            std::uint32_t index;
+            if (!freeIndices.empty())
+            {
+                index = freeIndices.back();
+                freeIndices.pop_back();
+            }
+            else
+            {
+                index = static_cast<std::uint32_t>(records.size());
+                records.push_back(Record { nullptr, 0, 0, ComponentSignature() });
+            }
+
+            Record &record = records[index];
+            record.archetype = emptyArchetype;
+            record.row = emptyArchetype->allocate(index, changeVersion);
+
+            EntityId entity { index, record.generation };
+            changes.created.push_back(entity);
+
+            return entity;
+        }
+
+        bool ArchetypeStorage::destroy(EntityId entity)
+        {
+            if (!contains(entity))
+            {
+                return false;
+            }
+
+            Record &record = records[entity.index];
+
+            const std::vector<const ComponentInfo *> &components = record.archetype->getComponents();
+            for (std::size_t column = 0; column < components.size(); column++)
+            {
+                components[column]->destroyFunction(record.archetype->getComponent(record.row, column));
+                changes.removed[components[column]->typeId].push_back(entity);
+            }
+
+            std::uint32_t movedEntity = record.archetype->remove(record.row, changeVersion);
+            if (movedEntity != Archetype::InvalidEntity)
+            {
+                records[movedEntity].row = record.row;
+            }
+
+            record.archetype = nullptr;
+            record.generation++;
+            record.changed.reset();
+            freeIndices.push_back(entity.index);
+            changes.destroyed.push_back(entity);
+
+            return true;
+        }
+
+        bool ArchetypeStorage::contains(EntityId entity) const
+        {
+            return entity.index < records.size()
+                    && records[entity.index].archetype != nullptr
+                    && records[entity.index].generation == entity.generation;
+        }
+
+        EntityId ArchetypeStorage::getEntityId(std::uint32_t index) const
+        {
+            return EntityId { index, records.at(index).generation };
+        }
+
+        void ArchetypeStorage::addComponent(EntityId entity, const ComponentInfo &info, void *component)
+        {
+            std::pair<void *, bool> slot = insertComponent(entity, info);
+            if (slot.second)
+            {
+                info.moveAssignFunction(slot.first, component);
+            }
+            else
+            {
+                info.moveConstructFunction(slot.first, component);
+            }
+        }
+
+        bool ArchetypeStorage::removeComponent(EntityId entity, ComponentTypeId typeId)
+        {
+            return eraseComponent(entity, typeId);
+        }
+
+        void ArchetypeStorage::markChanged(EntityId entity, ComponentTypeId typeId)
+        {
+            Record &record = getRecord(entity);
+
+            std::size_t column = record.archetype->findColumn(typeId);
+            if (column != Archetype::npos)
+            {
+                record.archetype->markChanged(record.row, column, changeVersion);
+            }
+
+            if (record.archetype->getSignature().test(typeId) && !record.changed.test(typeId))
+            {
+                record.changed.set(typeId);
+                changes.changed[typeId].push_back(entity);
+            }
+        }
+
+        std::uint32_t ArchetypeStorage::getChangeVersion() const
+        {
+            return changeVersion;
+        }
+
+        void ArchetypeStorage::advanceChangeVersion()
+        {
+            changeVersion++;
+        }
+
+        const std::vector<std::unique_ptr<Archetype>> &ArchetypeStorage::getArchetypes() const
+        {
+            return archetypes;
+        }
+
+        ArchetypeStorage::MemoryStats ArchetypeStorage::getMemoryStats(ComponentTypeId typeId) const
+        {
+            MemoryStats stats = { 0, 0, 0 };
+
+            for (const std::unique_ptr<Archetype> &archetype : archetypes)
+            {
+                std::size_t column = archetype->findColumn(typeId);
+                if (column != Archetype::npos)
+                {
+                    std::size_t size = archetype->getComponents()[column]->size;
+
+                    stats.componentCount += archetype->getSize();
+                    stats.usedBytes += archetype->getSize() * size;
+                    stats.reservedBytes += archetype->getChunkCount() * archetype->getChunkCapacity() * size;
+                }
+            }
+
+            return stats;
+        }
+
+        const ChunkPool &ArchetypeStorage::getChunkPool() const
+        {
+            return chunkPool;
+        }
+
+        const ArchetypeStorage::ChangeLog &ArchetypeStorage::getChanges() const
+        {
+            return changes;
+        }
+
+        void ArchetypeStorage::clearChanges()
+        {
+            changes.created.clear();
+            changes.destroyed.clear();
+
+            for (ComponentTypeId typeId = 0; typeId < MaxComponentTypes; typeId++)
+            {
+                for (EntityId entity : changes.changed[typeId])
+                {
+                    records[entity.index].changed.reset(typeId);
+                }
+
+                changes.added[typeId].clear();
+                changes.removed[typeId].clear();
+                changes.changed[typeId].clear();
+            }
+        }
+
+        ComponentSignature ArchetypeStorage::getSignature(EntityId entity) const
+        {
+            return contains(entity) ? records[entity.index].archetype->getSignature() : ComponentSignature();
+        }
+
+        ArchetypeStorage::Record &ArchetypeStorage::getRecord(EntityId entity)
+        {
+            if (!contains(entity))
+            {
+                throw std::invalid_argument("Entity does not exist");
+            }
+
+            return records[entity.index];
+        }
+
+        const ArchetypeStorage::Record &ArchetypeStorage::getRecord(EntityId entity) const
+        {
+            if (!contains(entity))
+            {
+                throw std::invalid_argument("Entity does not exist");
+            }
+
+            return records[entity.index];
+        }
+
+        void *ArchetypeStorage::findComponent(EntityId entity, ComponentTypeId typeId)
+        {
+            const Record &record = getRecord(entity);
+            std::size_t column = record.archetype->findColumn(typeId);
+            if (column == Archetype::npos)
+            {
+                return nullptr;
+            }
+
+            // Handing out a mutable pointer counts as a write
+            record.archetype->markChanged(record.row, column, changeVersion);
+            return record.archetype->getComponent(record.row, column);
+        }
+
+        const void *ArchetypeStorage::findComponent(EntityId entity, ComponentTypeId typeId) const
+        {
+            const Record &record = getRecord(entity);
+            std::size_t column = record.archetype->findColumn(typeId);
+            return column != Archetype::npos ? record.archetype->getComponent(record.row, column) : nullptr;
+        }
+
+        std::pair<void *, bool> ArchetypeStorage::insertComponent(EntityId entity, const ComponentInfo &component)
+        {
+            Archetype *source = getRecord(entity).archetype;
+
+            std::size_t column = source->findColumn(component.typeId);
+            if (column != Archetype::npos)
+            {
+                markChanged(entity, component.typeId);
+                return std::make_pair(source->getComponent(records[entity.index].row, column), true);
+            }
+
+            Archetype *target = source->getAddTarget(component.typeId);
+            if (target == nullptr)
+            {
+                std::vector<const ComponentInfo *> components = source->getComponents();
+                auto position = std::find_if(components.begin(), components.end(), [&component] (const ComponentInfo *info) {
+                    return info->typeId > component.typeId;
+                });
+                components.insert(position, &component);
+
+                target = findArchetype(std::move(components));
+                source->setAddTarget(component.typeId, target);
+                target->setRemoveTarget(component.typeId, source);
+            }
+
+            move(entity.index, target);
+            changes.added[component.typeId].push_back(entity);
+
+            return std::make_pair(target->getComponent(records[entity.index].row, target->findColumn(component.typeId)), false);
+        }
+
+        bool ArchetypeStorage::eraseComponent(EntityId entity, ComponentTypeId typeId)
+        {
+            Archetype *source = getRecord(entity).archetype;
+
+            std::size_t column = source->findColumn(typeId);
+            if (column == Archetype::npos)
+            {
+                return false;
+            }
+
+            Archetype *target = source->getRemoveTarget(typeId);
+            if (target == nullptr)
+            {
+                std::vector<const ComponentInfo *> components = source->getComponents();
+                components.erase(components.begin() + column);
+
+                target = findArchetype(std::move(components));
+                source->setRemoveTarget(typeId, target);
+                target->setAddTarget(typeId, source);
+            }
+
+            move(entity.index, target);
+            changes.removed[typeId].push_back(entity);
+
+            return true;
+        }
+
+        Archetype *ArchetypeStorage::findArchetype(std::vector<const ComponentInfo *> components)
+        {
+            ComponentSignature signature;
+            for (const ComponentInfo *component : components)
+            {
+                signature.set(component->typeId);
+            }
+
+            auto it = archetypesBySignature.find(signature);
+            if (it != archetypesBySignature.end())
+            {
+                return it->second;
+            }
+
+            archetypes.emplace_back(new Archetype(std::move(components), chunkPool));
+            archetypesBySignature.emplace(signature, archetypes.back().get());
+
+            return archetypes.back().get();
+        }
+
+        void ArchetypeStorage::move(std::uint32_t index, Archetype *target)
+        {
+            Record &record = records[index];
+            Archetype *source = record.archetype;
+
+            assert(source != target);
+
+            std::size_t row = target->allocate(index, changeVersion);
+
+            const std::vector<const ComponentInfo *> &components = source->getComponents();
+            for (std::size_t column = 0; column < components.size(); column++)
+            {
+                void *component = source->getComponent(record.row, column);
+
+                std::size_t targetColumn = target->findColumn(components[column]->typeId);
+                if (targetColumn != Archetype::npos)
+                {
+                    components[column]->moveConstructFunction(target->getComponent(row, targetColumn), component);
+                }
+
+                components[column]->destroyFunction(component);
+            }
+
+            std::uint32_t movedEntity = source->remove(record.row, changeVersion);
+            if (movedEntity != Archetype::InvalidEntity)
+            {
+                records[movedEntity].row = record.row;
+            }
+
+            record.archetype = target;
+            record.row = row;
+        }
+    }
+}
@@ -0,0 +1,174 @@
+#ifndef ARCHETYPESTORAGE_H
+#define ARCHETYPESTORAGE_H
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "Amber/Core/Archetype.h"
+#include "Amber/Core/ChunkPool.h"
+#include "Amber/Core/ComponentInfo.h"
+#include "Amber/Core/ComponentType.h"
+#include "Amber/Core/EntityId.h"
+#include "Amber/Core/IComponent.h"
+
+namespace Amber
+{
+    namespace Core
+    {
+        class ArchetypeStorage
+        {
+            public:
+                // Structural changes since the last call to clearChanges(). Changed
+                // components are only listed once per entity.
+                struct ChangeLog
+                {
+                    std::vector<EntityId> created;
+                    std::vector<EntityId> destroyed;
+                    std::array<std::vector<EntityId>, MaxComponentTypes> added;
+                    std::array<std::vector<EntityId>, MaxComponentTypes> removed;
+                    std::array<std::vector<EntityId>, MaxComponentTypes> changed;
+                };
+
+                struct MemoryStats
+                {
+                    std::size_t componentCount;
+                    std::size_t usedBytes;
+                    std::size_t reservedBytes;
+                };
+
+                ArchetypeStorage();
+                ArchetypeStorage(const ArchetypeStorage &other) = delete;
+                ~ArchetypeStorage();
+
+                ArchetypeStorage &operator =(const ArchetypeStorage &other) = delete;
+
+                EntityId create();
+                bool destroy(EntityId entity);
+                bool contains(EntityId entity) const;
+
+                // Id of the entity currently living in the given slot
+                EntityId getEntityId(std::uint32_t index) const;
+
+                ComponentSignature getSignature(EntityId entity) const;
+
+                template <typename T>
+                T *getComponent(EntityId entity)
+                {
+                    return static_cast<T *>(findComponent(entity, componentTypeId<T>()));
+                }
+
+                template <typename T>
+                const T *getComponent(EntityId entity) const
+                {
+                    return static_cast<const T *>(findComponent(entity, componentTypeId<T>()));
+                }
+
+                template <typename T>
+                T *addComponent(EntityId entity, T component)
+                {
+                    std::pair<void *, bool> slot = insertComponent(entity, ComponentInfo::get<T>());
+                    if (slot.second)
+                    {
+                        T *existing = static_cast<T *>(slot.first);
+                        *existing = std::move(component);
+                        return existing;
+                    }
+
+                    return new (slot.first) T(std::move(component));
+                }
+
+                // Builds the component aside before the entity changes archetype,
+                // the move would leave arguments referring to the entity's other
+                // components dangling. Components are movable anyway, rows move
+                // between chunks.
+                template <typename T, typename... Args>
+                T *emplaceComponent(EntityId entity, Args &&... args)
+                {
+                    return addComponent<T>(entity, T(std::forward<Args>(args)...));
+                }
+
+                template <typename T>
+                bool removeComponent(EntityId entity)
+                {
+                    return eraseComponent(entity, componentTypeId<T>());
+                }
+
+                // Type erased versions of the above, component is moved from
+                void addComponent(EntityId entity, const ComponentInfo &info, void *component);
+                bool removeComponent(EntityId entity, ComponentTypeId typeId);
+
+                template <typename T>
+                void markChanged(EntityId entity)
+                {
+                    markChanged(entity, componentTypeId<T>());
+                }
+
+                void markChanged(EntityId entity, ComponentTypeId typeId);
+
+                // Chunk columns remember the version at which they were last
+                // written through a mutable access. The version only moves at
+                // sync points, see World::advanceChangeVersion().
+                std::uint32_t getChangeVersion() const;
+                void advanceChangeVersion();
+
+                const std::vector<std::unique_ptr<Archetype>> &getArchetypes() const;
+
+                // Memory held by components of one type, reserved bytes include
+                // unused rows of the chunks they live in
+                template <typename T>
+                MemoryStats getMemoryStats() const
+                {
+                    return getMemoryStats(componentTypeId<T>());
+                }
+
+                MemoryStats getMemoryStats(ComponentTypeId typeId) const;
+                const ChunkPool &getChunkPool() const;
+
+                const ChangeLog &getChanges() const;
+                void clearChanges();
+
+            private:
+                // archetype is null while the slot is on the free list
+                struct Record
+                {
+                    Archetype *archetype;
+                    std::size_t row;
+                    std::uint32_t generation;
+                    ComponentSignature changed;
+                };
+
+                Record &getRecord(EntityId entity);
+                const Record &getRecord(EntityId entity) const;
+
+                void *findComponent(EntityId entity, ComponentTypeId typeId);
+                const void *findComponent(EntityId entity, ComponentTypeId typeId) const;
+
+                // Moves the entity into the archetype that also has the component and
+                // returns the (uninitialized) slot for it. If the entity already has
+                // the component, its slot is returned as changed and flagged as
+                // holding a live component, to be assigned rather than constructed.
+                std::pair<void *, bool> insertComponent(EntityId entity, const ComponentInfo &component);
+                bool eraseComponent(EntityId entity, ComponentTypeId typeId);
+
+                Archetype *findArchetype(std::vector<const ComponentInfo *> components);
+                void move(std::uint32_t index, Archetype *target);
+
+                ChunkPool chunkPool;
+                std::uint32_t changeVersion;
+
+                std::vector<Record> records;
+                std::vector<std::uint32_t> freeIndices;
+                std::vector<std::unique_ptr<Archetype>> archetypes;
+                std::unordered_map<ComponentSignature, Archetype *> archetypesBySignature;
+                Archetype *emptyArchetype;
+
+                ChangeLog changes;
+        };
+    }
+}
+
+#endif // ARCHETYPESTORAGE_H
@@ -0,0 +1,76 @@
+#include "ChunkPool.h"
+
+#include <cstdint>
+
+namespace Amber
+{
+    namespace Core
+    {
+        const std::size_t ChunkPool::Alignment;
+
+        ChunkPool::ChunkPool(std::size_t chunkByteSize, std::size_t chunksPerSlab)
+            : chunkByteSize((chunkByteSize + Alignment - 1) / Alignment * Alignment),
+              chunksPerSlab(chunksPerSlab),
+              freeList(nullptr),
+              allocatedCount(0)
+        {
+        }
+
+        ChunkPool::~ChunkPool()
+        {
+        }
+
+        void *ChunkPool::allocate()
+        {
+            if (freeList == nullptr)
+            {
+                grow();
+            }
+
+            FreeChunk *chunk = freeList;
+            freeList = chunk->next;
+            allocatedCount++;
+
+            return chunk;
+        }
+
+        void ChunkPool::deallocate(void *chunk)
+        {
+            FreeChunk *freeChunk = static_cast<FreeChunk *>(chunk);
+            freeChunk->next = freeList;
+            freeList = freeChunk;
+            allocatedCount--;
+        }
+
+        std::size_t ChunkPool::getChunkByteSize() const
+        {
+            return chunkByteSize;
+        }
+
+        std::size_t ChunkPool::getAllocatedCount() const
+        {
+            return allocatedCount;
+        }
+
+        std::size_t ChunkPool::getReservedBytes() const
+        {
+            return slabs.size() * (chunksPerSlab * chunkByteSize + Alignment);
+        }
+
+        void ChunkPool::grow()
+        {
+            slabs.emplace_back(new unsigned char[chunksPerSlab * chunkByteSize + Alignment]);
+
+            std::uintptr_t address = reinterpret_cast<std::uintptr_t>(slabs.back().get());
+            unsigned char *data = slabs.back().get() + ((address + Alignment - 1) / Alignment * Alignment - address);
+
+            // Pushed in reverse so that chunks are handed out in address order
+            for (std::size_t i = chunksPerSlab; i > 0; i--)
+            {
+                FreeChunk *chunk = reinterpret_cast<FreeChunk *>(data + (i - 1) * chunkByteSize);
+                chunk->next = freeList;
+                freeList = chunk;
+            }
+        }
+    }
+}
@@ -0,0 +1,54 @@
+#ifndef CHUNKPOOL_H
+#define CHUNKPOOL_H
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace Amber
+{
+    namespace Core
+    {
+        // Hands out fixed size, cache line aligned blocks of memory for archetype
+        // chunks. Blocks are carved from larger slabs and recycled through a free
+        // list, so allocating and freeing a chunk is O(1) and never returns
+        // memory to the system allocator while the pool lives.
+        class ChunkPool
+        {
+            public:
+                static const std::size_t Alignment = 64;
+
+                explicit ChunkPool(std::size_t chunkByteSize, std::size_t chunksPerSlab = 16);
+                ChunkPool(const ChunkPool &other) = delete;
+                ~ChunkPool();
+
+                ChunkPool &operator =(const ChunkPool &other) = delete;
+
+                void *allocate();
+                void deallocate(void *chunk);
+
+                std::size_t getChunkByteSize() const;
+
+                // Chunks currently handed out and bytes taken from the system
+                std::size_t getAllocatedCount() const;
+                std::size_t getReservedBytes() const;
+
+            private:
+                struct FreeChunk
+                {
+                    FreeChunk *next;
+                };
+
+                void grow();
+
+                std::size_t chunkByteSize;
+                std::size_t chunksPerSlab;
+
+                std::vector<std::unique_ptr<unsigned char[]>> slabs;
+                FreeChunk *freeList;
+                std::size_t allocatedCount;
+        };
+    }
+}
+
+#endif // CHUNKPOOL_H
@@ -0,0 +1,30 @@
+#include "ComponentInfo.h"
+
+#include <array>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+
+namespace Amber
+{
+    namespace Core
+    {
+        ComponentTypeId ComponentInfo::claimTypeId(ComponentTypeId typeId, const std::type_info &type)
+        {
+            static std::mutex mutex;
+            static std::array<const std::type_info *, MaxComponentTypes> types = {};
+
+            std::lock_guard<std::mutex> lock(mutex);
+
+            if (types[typeId] != nullptr && *types[typeId] != type)
+            {
+                throw std::logic_error("Component type id " + std::to_string(typeId) + " is declared by both "
+                                       + types[typeId]->name() + " and " + type.name());
+            }
+
+            types[typeId] = &type;
+
+            return typeId;
+        }
+    }
+}
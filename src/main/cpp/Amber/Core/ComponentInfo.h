@@ -0,0 +1,71 @@
+#ifndef COMPONENTINFO_H
+#define COMPONENTINFO_H
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+
+#include "Amber/Core/ComponentType.h"
+#include "Amber/Core/IComponent.h"
+
+namespace Amber
+{
+    namespace Core
+    {
+        // Describes how to relocate, replace and destroy a component type that the
+        // archetype storage otherwise only knows by size and alignment.
+        struct ComponentInfo
+        {
+            public:
+                template <typename T>
+                static const ComponentInfo &get()
+                {
+                    static_assert(std::is_base_of<IComponent, T>::value, "Object does not implement IComponent");
+
+                    static const ComponentInfo info = {
+                        claimTypeId(componentTypeId<T>(), typeid(T)),
+                        sizeof(T),
+                        alignof(T),
+                        &ComponentInfo::moveConstruct<T>,
+                        &ComponentInfo::moveAssign<T>,
+                        &ComponentInfo::destroy<T>
+                    };
+                    return info;
+                }
+
+                ComponentTypeId typeId;
+                std::size_t size;
+                std::size_t alignment;
+
+                void (*moveConstructFunction)(void *destination, void *source);
+                void (*moveAssignFunction)(void *destination, void *source);
+                void (*destroyFunction)(void *component);
+
+            private:
+                // Throws if another type already declared the same id
+                static ComponentTypeId claimTypeId(ComponentTypeId typeId, const std::type_info &type);
+
+                template <typename T>
+                static void moveConstruct(void *destination, void *source)
+                {
+                    new (destination) T(std::move(*static_cast<T *>(source)));
+                }
+
+                template <typename T>
+                static void moveAssign(void *destination, void *source)
+                {
+                    *static_cast<T *>(destination) = std::move(*static_cast<T *>(source));
+                }
+
+                template <typename T>
+                static void destroy(void *component)
+                {
+                    static_cast<T *>(component)->~T();
+                }
+        };
+    }
+}
+
+#endif // COMPONENTINFO_H
@@ -0,0 +1 @@
+#include "ComponentType.h"
@@ -0,0 +1,66 @@
+#ifndef COMPONENTTYPE_H
+#define COMPONENTTYPE_H
+
+#include <bitset>
+#include <cstddef>
+#include <type_traits>
+
+#include "Amber/Core/IComponent.h"
+
+namespace Amber
+{
+    namespace Core
+    {
+        typedef std::size_t ComponentTypeId;
+
+        static const std::size_t MaxComponentTypes = 64;
+
+        // Ids below this one are reserved for the engine's own components
+        static const ComponentTypeId FirstUserComponentType = 16;
+
+        // One bit per component type an entity or system deals with
+        typedef std::bitset<MaxComponentTypes> ComponentSignature;
+
+        // Every component type gets a fixed id with AMBER_COMPONENT_TYPE, so that
+        // ids do not depend on the order in which types are first used.
+        template <typename T>
+        struct ComponentType
+        {
+            static_assert(sizeof(T) == 0, "Component type has no id, declare one with AMBER_COMPONENT_TYPE");
+        };
+
+        template <typename T>
+        constexpr ComponentTypeId componentTypeId()
+        {
+            return ComponentType<typename std::remove_const<T>::type>::value;
+        }
+
+        template <typename... Ts>
+        ComponentSignature componentSignature()
+        {
+            ComponentSignature signature;
+
+            bool expand[] = { false, (signature.set(componentTypeId<Ts>()), false)... };
+            (void) expand;
+
+            return signature;
+        }
+    }
+}
+
+#define AMBER_COMPONENT_TYPE(Type, Id) \
+    namespace Amber \
+    { \
+        namespace Core \
+        { \
+            template <> \
+            struct ComponentType<Type> \
+            { \
+                static_assert(std::is_base_of<IComponent, Type>::value, "Object does not implement IComponent"); \
+                static_assert(Id < MaxComponentTypes, "Component type id out of range"); \
+                static const ComponentTypeId value = Id; \
+            }; \
+        } \
+    }
+
+#endif // COMPONENTTYPE_H
@@ -6,19 +6,40 @@ namespace Amber
 {
     namespace Core
     {
-        Entity::Entity(Entity &&other) noexcept
-            : components(std::move(other.components))
+        Entity::Entity()
+            : Entity(nullptr, EntityId { 0, 0 })
         {
         }
 
-        Entity &Entity::operator =(Entity &&other) noexcept
+        Entity::Entity(ArchetypeStorage *storage, EntityId id)
+            : storage(storage),
+              id(id)
         {
-            if (this != &other)
-            {
-                components = std::move(other.components);
-            }
+        }
+
+        bool Entity::isValid() const
+        {
+            return storage != nullptr && storage->contains(id);
+        }
+
+        EntityId Entity::getId() const
+        {
+            return id;
+        }
 
-            return *this;
+        ComponentSignature Entity::getSignature() const
+        {
+            return storage != nullptr ? storage->getSignature(id) : ComponentSignature();
+        }
+
+        bool operator ==(const Entity &lhs, const Entity &rhs)
+        {
+            return lhs.storage == rhs.storage && lhs.id == rhs.id;
+        }
+
+        bool operator !=(const Entity &lhs, const Entity &rhs)
+        {
+            return !(lhs == rhs);
         }
     }
 }
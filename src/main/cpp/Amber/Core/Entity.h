@@ -2,18 +2,23 @@
 #define ENTITY_H
 
 #include <algorithm>
+#include <cstdint>
 #include <memory>
 #include <tuple>
-#include <unordered_map>
 #include <utility>
 
+#include "Amber/Core/ArchetypeStorage.h"
+#include "Amber/Core/ComponentType.h"
+#include "Amber/Core/EntityId.h"
 #include "Amber/Core/IComponent.h"
-#include "Amber/Utilities/ClassTypeId.h"
 
 namespace Amber
 {
     namespace Core
     {
+        // A lightweight handle to an entity whose components live in the
+        // archetype storage of a World. Handles stay safe to hold after the
+        // entity is destroyed, they just stop being valid.
         class Entity
         {
             public:
@@ -44,13 +49,14 @@ namespace Amber
                         std::tuple<Ts *...> components;
                 };
 
-                Entity() = default;
-                Entity(const Entity &other) = delete;
-                Entity(Entity &&other) noexcept;
+                Entity();
                 ~Entity() = default;
 
-                Entity &operator =(const Entity &other) = delete;
-                Entity &operator =(Entity &&other) noexcept;
+                bool isValid() const;
+                EntityId getId() const;
+
+                // The component types the entity currently has, empty if it is not valid
+                ComponentSignature getSignature() const;
 
                 template <typename... Ts>
                 Entity::Proxy<Ts...> getProxy()
@@ -61,36 +67,72 @@ namespace Amber
                 template <typename T>
                 bool hasComponent() const
                 {
-                    return getComponent<T>() != nullptr;
+                    return getSignature().test(componentTypeId<T>());
+                }
+
+                template <typename... Ts>
+                bool hasComponents() const
+                {
+                    ComponentSignature required = componentSignature<Ts...>();
+                    return (getSignature() & required) == required;
                 }
 
                 template <typename T>
                 const T *getComponent() const
                 {
-                    using Amber::Utilities::ClassTypeId;
-                    auto it = components.find(ClassTypeId<IComponent>::typeId<T>());
-                    return it == components.end() ? nullptr : static_cast<T *>(it->second.get());
+                    return isValid() ? static_cast<const ArchetypeStorage *>(storage)->getComponent<T>(id) : nullptr;
                 }
 
                 template <typename T>
                 T *getComponent()
                 {
-                    using Amber::Utilities::ClassTypeId;
-                    auto it = components.find(ClassTypeId<IComponent>::typeId<T>());
-                    return it == components.end() ? nullptr : static_cast<T *>(it->second.get());
+                    return isValid() ? storage->getComponent<T>(id) : nullptr;
+                }
+
+                template <typename T, typename... Args>
+                T *emplaceComponent(Args &&... args)
+                {
+                    return isValid() ? storage->emplaceComponent<T>(id, std::forward<Args>(args)...) : nullptr;
                 }
 
                 template <typename T>
                 void addComponent(std::unique_ptr<T> component)
                 {
                     static_assert(std::is_base_of<IComponent, T>::value, "Object does not implement IComponent");
-                    using Amber::Utilities::ClassTypeId;
 
-                    components.emplace(ClassTypeId<IComponent>::typeId<T>(), std::move(component));
+                    if (isValid())
+                    {
+                        storage->addComponent<T>(id, std::move(*component));
+                    }
                 }
 
+                // Reports the component as changed to systems at the start of the next tick
+                template <typename T>
+                void markChanged()
+                {
+                    if (isValid())
+                    {
+                        storage->markChanged<T>(id);
+                    }
+                }
+
+                template <typename T>
+                bool removeComponent()
+                {
+                    return isValid() && storage->removeComponent<T>(id);
+                }
+
+                friend bool operator ==(const Entity &lhs, const Entity &rhs);
+                friend bool operator !=(const Entity &lhs, const Entity &rhs);
+
             private:
-                std::unordered_map<Amber::Utilities::TypeId, std::unique_ptr<IComponent>> components;
+                friend class EntityCommandQueue;
+                friend class World;
+
+                Entity(ArchetypeStorage *storage, EntityId id);
+
+                ArchetypeStorage *storage;
+                EntityId id;
         };
     }
 }
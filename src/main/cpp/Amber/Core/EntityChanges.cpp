@@ -0,0 +1,63 @@
+#include "EntityChanges.h"
+
+namespace Amber
+{
+    namespace Core
+    {
+        bool EntityChanges::isEmpty() const
+        {
+            if (!created.empty() || !destroyed.empty())
+            {
+                return false;
+            }
+
+            for (ComponentTypeId typeId = 0; typeId < MaxComponentTypes; typeId++)
+            {
+                if (!added[typeId].empty() || !removed[typeId].empty() || !changed[typeId].empty())
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        const std::vector<Entity> &EntityChanges::getCreated() const
+        {
+            return created;
+        }
+
+        const std::vector<Entity> &EntityChanges::getDestroyed() const
+        {
+            return destroyed;
+        }
+
+        const std::vector<Entity> &EntityChanges::getAdded(ComponentTypeId typeId) const
+        {
+            return added.at(typeId);
+        }
+
+        const std::vector<Entity> &EntityChanges::getRemoved(ComponentTypeId typeId) const
+        {
+            return removed.at(typeId);
+        }
+
+        const std::vector<Entity> &EntityChanges::getChanged(ComponentTypeId typeId) const
+        {
+            return changed.at(typeId);
+        }
+
+        void EntityChanges::clear()
+        {
+            created.clear();
+            destroyed.clear();
+
+            for (ComponentTypeId typeId = 0; typeId < MaxComponentTypes; typeId++)
+            {
+                added[typeId].clear();
+                removed[typeId].clear();
+                changed[typeId].clear();
+            }
+        }
+    }
+}
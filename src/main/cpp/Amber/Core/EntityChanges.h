@@ -0,0 +1,65 @@
+#ifndef ENTITYCHANGES_H
+#define ENTITYCHANGES_H
+
+#include <array>
+#include <vector>
+
+#include "Amber/Core/ComponentType.h"
+#include "Amber/Core/Entity.h"
+
+namespace Amber
+{
+    namespace Core
+    {
+        // The entities created and destroyed and the components added, removed
+        // and changed during a tick, grouped by component type. An entity can
+        // appear in several lists, so systems should look at its current state
+        // rather than at the order of events.
+        class EntityChanges
+        {
+            public:
+                EntityChanges() = default;
+                ~EntityChanges() = default;
+
+                bool isEmpty() const;
+
+                const std::vector<Entity> &getCreated() const;
+                const std::vector<Entity> &getDestroyed() const;
+
+                const std::vector<Entity> &getAdded(ComponentTypeId typeId) const;
+                const std::vector<Entity> &getRemoved(ComponentTypeId typeId) const;
+                const std::vector<Entity> &getChanged(ComponentTypeId typeId) const;
+
+                template <typename T>
+                const std::vector<Entity> &getAdded() const
+                {
+                    return getAdded(componentTypeId<T>());
+                }
+
+                template <typename T>
+                const std::vector<Entity> &getRemoved() const
+                {
+                    return getRemoved(componentTypeId<T>());
+                }
+
+                template <typename T>
+                const std::vector<Entity> &getChanged() const
+                {
+                    return getChanged(componentTypeId<T>());
+                }
+
+            private:
+                friend class World;
+
+                void clear();
+
+                std::vector<Entity> created;
+                std::vector<Entity> destroyed;
+                std::array<std::vector<Entity>, MaxComponentTypes> added;
+                std::array<std::vector<Entity>, MaxComponentTypes> removed;
+                std::array<std::vector<Entity>, MaxComponentTypes> changed;
+        };
+    }
+}
+
+#endif // ENTITYCHANGES_H
@@ -0,0 +1,171 @@
+#include "EntityCommandBuffer.h"
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+
+namespace Amber
+{
+    namespace Core
+    {
+        namespace
+        {
+            // Commands recorded outside of any scope sort after those of all systems
+            const std::uint32_t Unscoped = std::numeric_limits<std::uint32_t>::max();
+
+            const std::uint32_t LastChunk = std::numeric_limits<std::uint32_t>::max();
+
+            thread_local EntityCommandBuffer::SortKey currentKey = { Unscoped, {}, 0 };
+
+            std::size_t alignUp(std::size_t offset, std::size_t alignment)
+            {
+                return (offset + alignment - 1) / alignment * alignment;
+            }
+        }
+
+        const std::size_t EntityCommandBuffer::SortKey::MaxDepth;
+        const std::uint32_t EntityCommandBuffer::NoPendingEntity;
+        const std::size_t EntityCommandBuffer::BlockSize;
+
+        bool EntityCommandBuffer::SortKey::operator ==(const SortKey &other) const
+        {
+            return system == other.system && std::equal(std::begin(path), std::end(path), std::begin(other.path));
+        }
+
+        bool EntityCommandBuffer::SortKey::operator <(const SortKey &other) const
+        {
+            if (system != other.system)
+            {
+                return system < other.system;
+            }
+
+            return std::lexicographical_compare(std::begin(path), std::end(path), std::begin(other.path), std::end(other.path));
+        }
+
+        EntityCommandBuffer::Scope::Scope(std::uint32_t system)
+            : previous(currentKey)
+        {
+            currentKey = SortKey { system, {}, 0 };
+        }
+
+        // The path holds the batch count of the system scope, then the chunk and
+        // batch count of every nested chunk scope
+        EntityCommandBuffer::Scope::Scope(const SortKey &batch, std::uint32_t chunk)
+            : previous(currentKey)
+        {
+            currentKey = batch;
+            currentKey.path[2 * batch.depth + 1] = chunk;
+            currentKey.depth = batch.depth + 1;
+        }
+
+        EntityCommandBuffer::Scope::~Scope()
+        {
+            currentKey = previous;
+        }
+
+        EntityCommandBuffer::SortKey EntityCommandBuffer::Scope::fork()
+        {
+            if (currentKey.depth == SortKey::MaxDepth)
+            {
+                throw std::length_error("Parallel batches are nested too deeply");
+            }
+
+            currentKey.path[2 * currentKey.depth]++;
+            currentKey.path[2 * currentKey.depth + 1] = LastChunk;
+
+            return currentKey;
+        }
+
+        const EntityCommandBuffer::SortKey &EntityCommandBuffer::Scope::getCurrentKey()
+        {
+            return currentKey;
+        }
+
+        EntityCommandBuffer::PendingEntity::PendingEntity(std::uint32_t index)
+            : index(index)
+        {
+        }
+
+        EntityCommandBuffer::EntityCommandBuffer(std::atomic<std::uint32_t> &nextPendingEntity)
+            : nextPendingEntity(&nextPendingEntity),
+              blockIndex(0),
+              blockOffset(0)
+        {
+        }
+
+        EntityCommandBuffer::~EntityCommandBuffer()
+        {
+            clear();
+        }
+
+        EntityCommandBuffer::PendingEntity EntityCommandBuffer::create()
+        {
+            std::uint32_t index = nextPendingEntity->fetch_add(1, std::memory_order_relaxed);
+            record(CommandType::Create, Entity(), index, 0, std::pair<const ComponentInfo *, void *>());
+
+            return PendingEntity(index);
+        }
+
+        void EntityCommandBuffer::destroy(const Entity &entity)
+        {
+            record(CommandType::Destroy, entity, NoPendingEntity, 0, std::pair<const ComponentInfo *, void *>());
+        }
+
+        bool EntityCommandBuffer::isEmpty() const
+        {
+            return commands.empty();
+        }
+
+        void EntityCommandBuffer::record(CommandType type, const Entity &entity, std::uint32_t pendingEntity, ComponentTypeId typeId,
+                                         std::pair<const ComponentInfo *, void *> component)
+        {
+            commands.push_back(Command { currentKey, type, entity, pendingEntity, typeId, component.first, component.second });
+        }
+
+        void *EntityCommandBuffer::allocate(std::size_t size, std::size_t alignment)
+        {
+            if (size + alignment > BlockSize)
+            {
+                largeBlocks.emplace_back(new unsigned char[size + alignment]);
+                std::uintptr_t address = reinterpret_cast<std::uintptr_t>(largeBlocks.back().get());
+                return largeBlocks.back().get() + (alignUp(address, alignment) - address);
+            }
+
+            while (true)
+            {
+                if (blockIndex == blocks.size())
+                {
+                    blocks.emplace_back(new unsigned char[BlockSize]);
+                }
+
+                std::uintptr_t address = reinterpret_cast<std::uintptr_t>(blocks[blockIndex].get());
+                std::size_t offset = alignUp(address + blockOffset, alignment) - address;
+                if (offset + size <= BlockSize)
+                {
+                    blockOffset = offset + size;
+                    return blocks[blockIndex].get() + offset;
+                }
+
+                blockIndex++;
+                blockOffset = 0;
+            }
+        }
+
+        void EntityCommandBuffer::clear()
+        {
+            for (Command &command : commands)
+            {
+                if (command.data != nullptr)
+                {
+                    command.component->destroyFunction(command.data);
+                }
+            }
+
+            commands.clear();
+            largeBlocks.clear();
+            blockIndex = 0;
+            blockOffset = 0;
+        }
+    }
+}
@@ -0,0 +1,168 @@
+#ifndef ENTITYCOMMANDBUFFER_H
+#define ENTITYCOMMANDBUFFER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+#include "Amber/Core/ComponentInfo.h"
+#include "Amber/Core/ComponentType.h"
+#include "Amber/Core/Entity.h"
+
+namespace Amber
+{
+    namespace Core
+    {
+        // Records structural changes to a World from one thread, to be applied at
+        // the next sync point. Get the calling thread's buffer from
+        // World::getCommandBuffer(); recording never takes a lock.
+        //
+        // Commands of all buffers are applied in the order of their sort keys,
+        // which follow the system and query chunk they were recorded in, so the
+        // result does not depend on which thread ran what. Jobs recording
+        // commands must therefore open a chunk scope, like
+        // Query::parallelForEach does.
+        class EntityCommandBuffer
+        {
+            public:
+                // The system and, for every parallel batch the command was
+                // recorded in, the batch and chunk. Commands recorded in a scope
+                // between two of its batches sort after the chunks of the first.
+                struct SortKey
+                {
+                    // Parallel batches nested deeper than this cannot be forked
+                    static const std::size_t MaxDepth = 3;
+
+                    std::uint32_t system;
+                    std::uint32_t path[2 * MaxDepth + 1];
+                    std::uint32_t depth;
+
+                    bool operator ==(const SortKey &other) const;
+                    bool operator <(const SortKey &other) const;
+                };
+
+                // Sets the sort key of commands recorded on this thread for its lifetime
+                class Scope
+                {
+                    public:
+                        explicit Scope(std::uint32_t system);
+                        Scope(const SortKey &batch, std::uint32_t chunk);
+                        Scope(const Scope &other) = delete;
+                        ~Scope();
+
+                        Scope &operator =(const Scope &other) = delete;
+
+                        // Starts a batch of chunk scopes to be run in parallel. Commands
+                        // recorded afterwards in the current scope sort after the batch,
+                        // batches forked inside its chunks sort within their chunk.
+                        static SortKey fork();
+
+                        // The key commands and events recorded on this thread get
+                        static const SortKey &getCurrentKey();
+
+                    private:
+                        SortKey previous;
+                };
+
+                // An entity that will be created when the buffer is applied
+                class PendingEntity
+                {
+                    private:
+                        friend class EntityCommandBuffer;
+
+                        explicit PendingEntity(std::uint32_t index);
+
+                        std::uint32_t index;
+                };
+
+                explicit EntityCommandBuffer(std::atomic<std::uint32_t> &nextPendingEntity);
+                EntityCommandBuffer(const EntityCommandBuffer &other) = delete;
+                ~EntityCommandBuffer();
+
+                EntityCommandBuffer &operator =(const EntityCommandBuffer &other) = delete;
+
+                PendingEntity create();
+                void destroy(const Entity &entity);
+
+                template <typename T>
+                void addComponent(const Entity &entity, T component)
+                {
+                    record(CommandType::AddComponent, entity, NoPendingEntity, componentTypeId<T>(), store(std::move(component)));
+                }
+
+                template <typename T>
+                void addComponent(PendingEntity entity, T component)
+                {
+                    record(CommandType::AddComponent, Entity(), entity.index, componentTypeId<T>(), store(std::move(component)));
+                }
+
+                template <typename T>
+                void removeComponent(const Entity &entity)
+                {
+                    record(CommandType::RemoveComponent, entity, NoPendingEntity, componentTypeId<T>(), std::pair<const ComponentInfo *, void *>());
+                }
+
+                template <typename T>
+                void removeComponent(PendingEntity entity)
+                {
+                    record(CommandType::RemoveComponent, Entity(), entity.index, componentTypeId<T>(), std::pair<const ComponentInfo *, void *>());
+                }
+
+                bool isEmpty() const;
+
+            private:
+                friend class EntityCommandQueue;
+
+                enum class CommandType
+                {
+                    Create,
+                    Destroy,
+                    AddComponent,
+                    RemoveComponent
+                };
+
+                struct Command
+                {
+                    SortKey key;
+                    CommandType type;
+                    Entity entity;
+                    std::uint32_t pendingEntity;
+                    ComponentTypeId typeId;
+                    const ComponentInfo *component;
+                    void *data;
+                };
+
+                static const std::uint32_t NoPendingEntity = static_cast<std::uint32_t>(-1);
+                static const std::size_t BlockSize = 16 * 1024;
+
+                template <typename T>
+                std::pair<const ComponentInfo *, void *> store(T component)
+                {
+                    const ComponentInfo &info = ComponentInfo::get<T>();
+                    return std::make_pair(&info, new (allocate(sizeof(T), alignof(T))) T(std::move(component)));
+                }
+
+                void record(CommandType type, const Entity &entity, std::uint32_t pendingEntity, ComponentTypeId typeId,
+                            std::pair<const ComponentInfo *, void *> component);
+
+                void *allocate(std::size_t size, std::size_t alignment);
+
+                // Destroys components that were not applied, keeps the memory for reuse
+                void clear();
+
+                std::atomic<std::uint32_t> *nextPendingEntity;
+                std::vector<Command> commands;
+
+                std::vector<std::unique_ptr<unsigned char[]>> blocks;
+                std::vector<std::unique_ptr<unsigned char[]>> largeBlocks;
+                std::size_t blockIndex;
+                std::size_t blockOffset;
+        };
+    }
+}
+
+#endif // ENTITYCOMMANDBUFFER_H
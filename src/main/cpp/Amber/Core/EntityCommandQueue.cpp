@@ -0,0 +1,143 @@
+#include "EntityCommandQueue.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <tuple>
+
+#include "Amber/Core/World.h"
+
+namespace Amber
+{
+    namespace Core
+    {
+        EntityCommandQueue::EntityCommandQueue()
+            : nextPendingEntity(0)
+        {
+        }
+
+        EntityCommandQueue::~EntityCommandQueue()
+        {
+        }
+
+        EntityCommandBuffer &EntityCommandQueue::getBuffer()
+        {
+            EntityCommandBuffer *buffer = cachedBuffer.get();
+            return buffer != nullptr ? *buffer : createBuffer();
+        }
+
+        void EntityCommandQueue::playback(World &world)
+        {
+            sortedCommands.clear();
+            for (std::size_t i = 0; i < buffers.size(); i++)
+            {
+                for (EntityCommandBuffer::Command &command : buffers[i]->commands)
+                {
+                    sortedCommands.push_back(SortedCommand { &command, i });
+                }
+            }
+
+            if (sortedCommands.empty())
+            {
+                return;
+            }
+
+            // Commands with equal keys keep their recording order
+            std::stable_sort(sortedCommands.begin(), sortedCommands.end(), [] (const SortedCommand &lhs, const SortedCommand &rhs) {
+                return lhs.command->key < rhs.command->key;
+            });
+
+            // Nothing orders the commands of two threads sharing a key, applying
+            // them would make the result depend on scheduling. Ids are only
+            // meaningful in the storage they came from. Either way the commands
+            // of the frame are dropped as a whole rather than applied in part.
+            ArchetypeStorage &storage = *world.storage;
+            for (std::size_t i = 0; i < sortedCommands.size(); i++)
+            {
+                const SortedCommand &sorted = sortedCommands[i];
+                if (i > 0 && sorted.buffer != sortedCommands[i - 1].buffer && sorted.command->key == sortedCommands[i - 1].command->key)
+                {
+                    clear();
+                    throw std::logic_error("Entity commands of one scope were recorded on several threads");
+                }
+
+                if (sorted.command->pendingEntity == EntityCommandBuffer::NoPendingEntity && sorted.command->entity.storage != &storage)
+                {
+                    clear();
+                    throw std::invalid_argument("Entity command for an entity of another world");
+                }
+            }
+
+            pendingEntities.assign(nextPendingEntity.load(), EntityId { 0, 0 });
+
+            for (const SortedCommand &sorted : sortedCommands)
+            {
+                EntityCommandBuffer::Command *command = sorted.command;
+                EntityId entity = command->entity.getId();
+                if (command->pendingEntity != EntityCommandBuffer::NoPendingEntity)
+                {
+                    if (command->type == EntityCommandBuffer::CommandType::Create)
+                    {
+                        pendingEntities[command->pendingEntity] = world.create().getId();
+                        continue;
+                    }
+
+                    entity = pendingEntities[command->pendingEntity];
+                }
+
+                // Commands on entities destroyed in the meantime are dropped
+                if (!storage.contains(entity))
+                {
+                    continue;
+                }
+
+                switch (command->type)
+                {
+                    case EntityCommandBuffer::CommandType::Destroy:
+                        world.destroyEntity(entity);
+                        break;
+
+                    case EntityCommandBuffer::CommandType::AddComponent:
+                        storage.addComponent(entity, *command->component, command->data);
+                        command->component->destroyFunction(command->data);
+                        command->data = nullptr;
+                        break;
+
+                    case EntityCommandBuffer::CommandType::RemoveComponent:
+                        storage.removeComponent(entity, command->typeId);
+                        break;
+
+                    default:
+                        throw std::logic_error("Invalid entity command");
+                }
+            }
+
+            clear();
+        }
+
+        void EntityCommandQueue::clear()
+        {
+            for (const std::unique_ptr<EntityCommandBuffer> &buffer : buffers)
+            {
+                buffer->clear();
+            }
+
+            nextPendingEntity = 0;
+        }
+
+        EntityCommandBuffer &EntityCommandQueue::createBuffer()
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+
+            EntityCommandBuffer *&buffer = buffersByThread[std::this_thread::get_id()];
+            if (buffer == nullptr)
+            {
+                buffers.emplace_back(new EntityCommandBuffer(nextPendingEntity));
+                buffer = buffers.back().get();
+            }
+
+            cachedBuffer.set(buffer);
+
+            return *buffer;
+        }
+    }
+}
@@ -0,0 +1,66 @@
+#ifndef ENTITYCOMMANDQUEUE_H
+#define ENTITYCOMMANDQUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "Amber/Core/EntityCommandBuffer.h"
+#include "Amber/Core/EntityId.h"
+#include "Amber/Utilities/ThreadCache.h"
+
+namespace Amber
+{
+    namespace Core
+    {
+        class World;
+
+        // The command buffers of all threads recording changes to one World
+        class EntityCommandQueue
+        {
+            public:
+                EntityCommandQueue();
+                EntityCommandQueue(const EntityCommandQueue &other) = delete;
+                ~EntityCommandQueue();
+
+                EntityCommandQueue &operator =(const EntityCommandQueue &other) = delete;
+
+                // The calling thread's buffer, created on first use
+                EntityCommandBuffer &getBuffer();
+
+                // Applies the commands of all buffers in sort key order and empties
+                // them. Must not run concurrently with recording. Throws, dropping
+                // every command, if commands of one key were recorded on several
+                // threads (std::logic_error), as nothing would order them, or if
+                // one names an entity of another world (std::invalid_argument).
+                void playback(World &world);
+
+            private:
+                struct SortedCommand
+                {
+                    EntityCommandBuffer::Command *command;
+                    std::size_t buffer;
+                };
+
+                EntityCommandBuffer &createBuffer();
+                void clear();
+
+                Utilities::ThreadCache<EntityCommandBuffer> cachedBuffer;
+                std::atomic<std::uint32_t> nextPendingEntity;
+
+                std::mutex mutex;
+                std::unordered_map<std::thread::id, EntityCommandBuffer *> buffersByThread;
+                std::vector<std::unique_ptr<EntityCommandBuffer>> buffers;
+
+                std::vector<SortedCommand> sortedCommands;
+                std::vector<EntityId> pendingEntities;
+        };
+    }
+}
+
+#endif // ENTITYCOMMANDQUEUE_H
@@ -0,0 +1,22 @@
+#include "EntityId.h"
+
+namespace Amber
+{
+    namespace Core
+    {
+        bool operator ==(const EntityId &lhs, const EntityId &rhs)
+        {
+            return lhs.index == rhs.index && lhs.generation == rhs.generation;
+        }
+
+        bool operator !=(const EntityId &lhs, const EntityId &rhs)
+        {
+            return !(lhs == rhs);
+        }
+
+        bool operator <(const EntityId &lhs, const EntityId &rhs)
+        {
+            return lhs.index < rhs.index || (lhs.index == rhs.index && lhs.generation < rhs.generation);
+        }
+    }
+}
@@ -0,0 +1,25 @@
+#ifndef ENTITYID_H
+#define ENTITYID_H
+
+#include <cstdint>
+
+namespace Amber
+{
+    namespace Core
+    {
+        // Identifies an entity by its slot in the world and the generation of
+        // that slot. A slot is reused after its entity is destroyed, but with a
+        // new generation, so stale ids never resolve to the new entity.
+        struct EntityId
+        {
+            std::uint32_t index;
+            std::uint32_t generation;
+        };
+
+        bool operator ==(const EntityId &lhs, const EntityId &rhs);
+        bool operator !=(const EntityId &lhs, const EntityId &rhs);
+        bool operator <(const EntityId &lhs, const EntityId &rhs);
+    }
+}
+
+#endif // ENTITYID_H
@@ -0,0 +1,62 @@
+#include "EntitySet.h"
+
+namespace Amber
+{
+    namespace Core
+    {
+        bool EntitySet::insert(const Entity &entity)
+        {
+            if (!positions.emplace(key(entity), entities.size()).second)
+            {
+                return false;
+            }
+
+            entities.push_back(entity);
+
+            return true;
+        }
+
+        bool EntitySet::erase(const Entity &entity)
+        {
+            auto it = positions.find(key(entity));
+            if (it == positions.end())
+            {
+                return false;
+            }
+
+            std::size_t position = it->second;
+            positions.erase(it);
+
+            if (position != entities.size() - 1)
+            {
+                entities[position] = entities.back();
+                positions[key(entities[position])] = position;
+            }
+
+            entities.pop_back();
+
+            return true;
+        }
+
+        bool EntitySet::contains(const Entity &entity) const
+        {
+            return positions.count(key(entity)) != 0;
+        }
+
+        std::size_t EntitySet::getSize() const
+        {
+            return entities.size();
+        }
+
+        const std::vector<Entity> &EntitySet::getEntities() const
+        {
+            return entities;
+        }
+
+        std::uint64_t EntitySet::key(const Entity &entity)
+        {
+            EntityId id = entity.getId();
+            return (static_cast<std::uint64_t>(id.generation) << 32) | id.index;
+        }
+    }
+}
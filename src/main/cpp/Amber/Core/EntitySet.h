@@ -0,0 +1,39 @@
+#ifndef ENTITYSET_H
+#define ENTITYSET_H
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "Amber/Core/Entity.h"
+
+namespace Amber
+{
+    namespace Core
+    {
+        // An unordered set of entities of one world with constant time insertion
+        // and removal, kept contiguous for iteration.
+        class EntitySet
+        {
+            public:
+                EntitySet() = default;
+                ~EntitySet() = default;
+
+                bool insert(const Entity &entity);
+                bool erase(const Entity &entity);
+                bool contains(const Entity &entity) const;
+
+                std::size_t getSize() const;
+                const std::vector<Entity> &getEntities() const;
+
+            private:
+                static std::uint64_t key(const Entity &entity);
+
+                std::vector<Entity> entities;
+                std::unordered_map<std::uint64_t, std::size_t> positions;
+        };
+    }
+}
+
+#endif // ENTITYSET_H
@@ -0,0 +1,121 @@
+#include "EventBus.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace Amber
+{
+    namespace Core
+    {
+        std::atomic<std::size_t> EventBus::nextEventTypeId(0);
+
+        EventBus::EventBus()
+        {
+        }
+
+        EventBus::~EventBus()
+        {
+        }
+
+        void EventBus::dispatch()
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+
+                for (const std::unique_ptr<ThreadBuffer> &buffer : buffers)
+                {
+                    for (const std::unique_ptr<IChannel> &channel : buffer->channels)
+                    {
+                        if (channel)
+                        {
+                            channel->swap();
+                        }
+                    }
+                }
+            }
+
+            deliveries.clear();
+            for (std::size_t i = 0; i < subscriptions.size(); i++)
+            {
+                std::size_t typeId = subscriptions[i].typeId;
+                for (std::size_t j = 0; j < buffers.size(); j++)
+                {
+                    const ThreadBuffer &buffer = *buffers[j];
+                    if (typeId >= buffer.channels.size() || !buffer.channels[typeId])
+                    {
+                        continue;
+                    }
+
+                    const IChannel &channel = *buffer.channels[typeId];
+                    const std::vector<Run> &runs = channel.getRuns();
+                    for (std::size_t k = 0; k < runs.size(); k++)
+                    {
+                        std::size_t end = k + 1 < runs.size() ? runs[k + 1].first : channel.getCount();
+                        deliveries.push_back(Delivery { i, j, &channel, &runs[k], end - runs[k].first });
+                    }
+                }
+            }
+
+            // Runs of one thread and key stay in publishing order
+            std::stable_sort(deliveries.begin(), deliveries.end(), [] (const Delivery &lhs, const Delivery &rhs) {
+                return lhs.subscription != rhs.subscription ? lhs.subscription < rhs.subscription : lhs.run->key < rhs.run->key;
+            });
+
+            for (std::size_t i = 1; i < deliveries.size(); i++)
+            {
+                const Delivery &previous = deliveries[i - 1];
+                if (deliveries[i].subscription == previous.subscription && deliveries[i].buffer != previous.buffer
+                        && deliveries[i].run->key == previous.run->key)
+                {
+                    throw std::logic_error("Events of one scope were published on several threads");
+                }
+            }
+
+            // Handlers may publish and so add buffers and channels. Those only hold
+            // pending events and runs, the delivering ones are left alone.
+            for (const Delivery &delivery : deliveries)
+            {
+                for (const std::function<void(const void *, std::size_t)> &handler : subscriptions[delivery.subscription].handlers)
+                {
+                    handler(delivery.channel->getEvents(delivery.run->first), delivery.count);
+                }
+            }
+        }
+
+        EventBus::ThreadBuffer &EventBus::getBuffer()
+        {
+            ThreadBuffer *buffer = cachedBuffer.get();
+            return buffer != nullptr ? *buffer : createBuffer();
+        }
+
+        EventBus::ThreadBuffer &EventBus::createBuffer()
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+
+            ThreadBuffer *&buffer = buffersByThread[std::this_thread::get_id()];
+            if (buffer == nullptr)
+            {
+                buffers.emplace_back(new ThreadBuffer());
+                buffer = buffers.back().get();
+            }
+
+            cachedBuffer.set(buffer);
+
+            return *buffer;
+        }
+
+        EventBus::Subscription &EventBus::findSubscription(std::size_t typeId)
+        {
+            for (Subscription &subscription : subscriptions)
+            {
+                if (subscription.typeId == typeId)
+                {
+                    return subscription;
+                }
+            }
+
+            subscriptions.push_back(Subscription { typeId, std::vector<std::function<void(const void *, std::size_t)>>() });
+            return subscriptions.back();
+        }
+    }
+}
@@ -0,0 +1,220 @@
+#ifndef EVENTBUS_H
+#define EVENTBUS_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "Amber/Core/EntityCommandBuffer.h"
+#include "Amber/Utilities/ThreadCache.h"
+
+namespace Amber
+{
+    namespace Core
+    {
+        // Typed events passed between systems. Every thread publishes into its
+        // own array per event type without taking a lock, dispatch() hands the
+        // arrays to the subscribers of each type at the next sync point.
+        //
+        // Events are tagged with the publishing thread's command sort key, see
+        // EntityCommandBuffer::Scope, and delivered in key order, so the order
+        // does not depend on which thread ran what. Types are dispatched in the
+        // order they were first subscribed.
+        class EventBus
+        {
+            public:
+                template <typename T>
+                using Handler = std::function<void(const T *events, std::size_t count)>;
+
+                EventBus();
+                EventBus(const EventBus &other) = delete;
+                ~EventBus();
+
+                EventBus &operator =(const EventBus &other) = delete;
+
+                template <typename T>
+                void publish(T event)
+                {
+                    Channel<T> &channel = getChannel<T>();
+                    channel.beginRun(channel.pending.size());
+                    channel.pending.push_back(std::move(event));
+                }
+
+                template <typename T, typename... Args>
+                void emplace(Args &&... args)
+                {
+                    Channel<T> &channel = getChannel<T>();
+                    channel.beginRun(channel.pending.size());
+                    channel.pending.emplace_back(std::forward<Args>(args)...);
+                }
+
+                // Handlers are called on the thread running dispatch(), once per
+                // run of events published under one sort key, in key order.
+                // Subscribe while no dispatch is running.
+                template <typename T>
+                void subscribe(Handler<T> handler)
+                {
+                    findSubscription(getEventTypeId<T>()).handlers.push_back([handler] (const void *events, std::size_t count)
+                    {
+                        handler(static_cast<const T *>(events), count);
+                    });
+                }
+
+                // Delivers every event published before the call. Events published
+                // by the handlers wait for the next dispatch. Must not run
+                // concurrently with publishing from other threads. Throws
+                // std::logic_error, delivering nothing, if events of one type and
+                // key were published on several threads, as nothing would order
+                // them.
+                void dispatch();
+
+            private:
+                // Events from first on were published under key
+                struct Run
+                {
+                    EntityCommandBuffer::SortKey key;
+                    std::size_t first;
+                };
+
+                class IChannel
+                {
+                    public:
+                        IChannel() = default;
+                        virtual ~IChannel() = default;
+
+                        void beginRun(std::size_t first)
+                        {
+                            const EntityCommandBuffer::SortKey &key = EntityCommandBuffer::Scope::getCurrentKey();
+                            if (pendingRuns.empty() || !(pendingRuns.back().key == key))
+                            {
+                                pendingRuns.push_back(Run { key, first });
+                            }
+                        }
+
+                        // Makes the pending events the ones to deliver, and drops
+                        // those delivered before
+                        void swap()
+                        {
+                            deliveringRuns.clear();
+                            pendingRuns.swap(deliveringRuns);
+                            swapEvents();
+                        }
+
+                        const std::vector<Run> &getRuns() const
+                        {
+                            return deliveringRuns;
+                        }
+
+                        virtual const void *getEvents(std::size_t first) const = 0;
+                        virtual std::size_t getCount() const = 0;
+
+                    private:
+                        virtual void swapEvents() = 0;
+
+                        std::vector<Run> pendingRuns;
+                        std::vector<Run> deliveringRuns;
+                };
+
+                template <typename T>
+                class Channel : public IChannel
+                {
+                    public:
+                        virtual const void *getEvents(std::size_t first) const override final
+                        {
+                            return delivering.data() + first;
+                        }
+
+                        virtual std::size_t getCount() const override final
+                        {
+                            return delivering.size();
+                        }
+
+                        std::vector<T> pending;
+
+                    private:
+                        virtual void swapEvents() override final
+                        {
+                            delivering.clear();
+                            pending.swap(delivering);
+                        }
+
+                        std::vector<T> delivering;
+                };
+
+                // The channels of one thread, indexed by event type id
+                struct ThreadBuffer
+                {
+                    std::vector<std::unique_ptr<IChannel>> channels;
+                };
+
+                struct Subscription
+                {
+                    std::size_t typeId;
+                    std::vector<std::function<void(const void *, std::size_t)>> handlers;
+                };
+
+                // A run to deliver, with the position of its subscription and of
+                // the buffer it was published into
+                struct Delivery
+                {
+                    std::size_t subscription;
+                    std::size_t buffer;
+                    const IChannel *channel;
+                    const Run *run;
+                    std::size_t count;
+                };
+
+                template <typename T>
+                static std::size_t getEventTypeId()
+                {
+                    static const std::size_t id = nextEventTypeId++;
+                    return id;
+                }
+
+                template <typename T>
+                Channel<T> &getChannel()
+                {
+                    std::size_t typeId = getEventTypeId<T>();
+
+                    ThreadBuffer &buffer = getBuffer();
+                    if (typeId >= buffer.channels.size())
+                    {
+                        buffer.channels.resize(typeId + 1);
+                    }
+
+                    if (!buffer.channels[typeId])
+                    {
+                        buffer.channels[typeId].reset(new Channel<T>());
+                    }
+
+                    return static_cast<Channel<T> &>(*buffer.channels[typeId]);
+                }
+
+                // The calling thread's buffer, created on first use
+                ThreadBuffer &getBuffer();
+                ThreadBuffer &createBuffer();
+
+                Subscription &findSubscription(std::size_t typeId);
+
+                static std::atomic<std::size_t> nextEventTypeId;
+
+                Utilities::ThreadCache<ThreadBuffer> cachedBuffer;
+
+                std::mutex mutex;
+                std::unordered_map<std::thread::id, ThreadBuffer *> buffersByThread;
+                std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+
+                std::vector<Subscription> subscriptions;
+                std::vector<Delivery> deliveries;
+        };
+    }
+}
+
+#endif // EVENTBUS_H
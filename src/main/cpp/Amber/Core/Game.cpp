@@ -1,9 +1,54 @@
 #include "Game.h"
 
+#include <algorithm>
+#include <stdexcept>
+#include <thread>
+
+#include "Amber/Core/Transform.h"
+#include "Amber/Utilities/FrameArena.h"
+
 namespace Amber
 {
     namespace Core
     {
+        namespace
+        {
+            // Sleeping is only accurate to about a scheduler quantum, the last
+            // stretch before a deadline is spent yielding instead.
+            const std::chrono::microseconds SpinThreshold(1000);
+        }
+
+        Game::Game()
+            : Game(std::unique_ptr<Utilities::JobSystem>(new Utilities::JobSystem()), nullptr)
+        {
+        }
+
+        Game::Game(Utilities::JobSystem &jobSystem)
+            : Game(nullptr, &jobSystem)
+        {
+        }
+
+        Game::Game(std::unique_ptr<Utilities::JobSystem> ownedJobSystem, Utilities::JobSystem *sharedJobSystem)
+            : round(nullptr),
+              ownedJobSystem(std::move(ownedJobSystem)),
+              jobSystem(sharedJobSystem != nullptr ? sharedJobSystem : this->ownedJobSystem.get()),
+              schedulesDirty(false),
+              tickDuration(std::chrono::nanoseconds(1000000000) / 60),
+              maxFrameDuration(std::chrono::milliseconds(250)),
+              frameBudget(std::chrono::nanoseconds::zero()),
+              framePacing(FramePacing::Sleep),
+              tickCount(0),
+              interpolationAlpha(1.0f),
+              running(false)
+        {
+            simulation.scheduler.reset(new SystemScheduler(*jobSystem));
+            presentation.scheduler.reset(new SystemScheduler(*jobSystem));
+        }
+
+        Game::~Game()
+        {
+        }
+
         const std::vector<std::unique_ptr<ISystem>> &Game::getSystems() const
         {
             return systems;
@@ -12,6 +57,7 @@ namespace Amber
         void Game::addSystem(std::unique_ptr<ISystem> system)
         {
             this->systems.push_back(std::move(system));
+            this->schedulesDirty = true;
         }
 
         World &Game::getWorld()
@@ -24,16 +70,294 @@ namespace Amber
             return world;
         }
 
-        void Game::setWorld(World scene)
+        void Game::setWorld(World world)
+        {
+            // Systems let go of the old entities while their storage is still
+            // alive, then see the new ones as created
+            for (const Entity &entity : this->world.getEntities())
+            {
+                this->world.destroy(entity);
+            }
+            synchronizeEntities();
+
+            this->world = std::move(world);
+            this->world.collectEntities(changes);
+
+            for (const std::unique_ptr<ISystem> &system : systems)
+            {
+                system->processChanges(changes);
+            }
+        }
+
+        Utilities::JobSystem &Game::getJobSystem()
+        {
+            return *jobSystem;
+        }
+
+        Round *Game::getRound() const
+        {
+            return round;
+        }
+
+        void Game::setRound(Round *round)
+        {
+            this->round = round;
+        }
+
+        std::chrono::nanoseconds Game::getTickDuration() const
+        {
+            return tickDuration;
+        }
+
+        void Game::setTickDuration(std::chrono::nanoseconds tickDuration)
+        {
+            if (tickDuration <= std::chrono::nanoseconds::zero())
+            {
+                throw std::invalid_argument("Tick duration must be positive");
+            }
+
+            this->tickDuration = tickDuration;
+        }
+
+        std::chrono::nanoseconds Game::getMaxFrameDuration() const
+        {
+            return maxFrameDuration;
+        }
+
+        void Game::setMaxFrameDuration(std::chrono::nanoseconds maxFrameDuration)
+        {
+            this->maxFrameDuration = maxFrameDuration;
+        }
+
+        std::chrono::nanoseconds Game::getFrameBudget() const
+        {
+            return frameBudget;
+        }
+
+        void Game::setFrameBudget(std::chrono::nanoseconds frameBudget)
+        {
+            this->frameBudget = frameBudget;
+        }
+
+        Game::FramePacing Game::getFramePacing() const
         {
-            this->world = std::move(scene);
+            return framePacing;
+        }
 
-            for (Entity &entity : this->world.entities)
+        void Game::setFramePacing(Game::FramePacing framePacing)
+        {
+            this->framePacing = framePacing;
+        }
+
+        std::uint64_t Game::getTickCount() const
+        {
+            return tickCount;
+        }
+
+        float Game::getInterpolationAlpha() const
+        {
+            return interpolationAlpha;
+        }
+
+        void Game::run()
+        {
+            typedef std::chrono::steady_clock Clock;
+
+            running = true;
+
+            std::chrono::nanoseconds accumulator = std::chrono::nanoseconds::zero();
+            Clock::time_point previousFrameStart = Clock::now();
+
+            while (running)
             {
-                for (const std::unique_ptr<ISystem> &system : systems)
+                Clock::time_point frameStart = Clock::now();
+                std::chrono::nanoseconds frameDuration = std::min<std::chrono::nanoseconds>(frameStart - previousFrameStart, maxFrameDuration);
+                previousFrameStart = frameStart;
+
+                accumulator += frameDuration;
+                while (accumulator >= tickDuration && running)
                 {
-                    system->registerEntity(entity);
+                    tick();
+                    accumulator -= tickDuration;
                 }
+
+                interpolationAlpha = static_cast<float>(accumulator.count()) / static_cast<float>(tickDuration.count());
+                present();
+                resetFrameArenas();
+
+                pace(frameStart);
+            }
+        }
+
+        void Game::stop()
+        {
+            running = false;
+        }
+
+        bool Game::isRunning() const
+        {
+            return running;
+        }
+
+        void Game::runSingleIteration()
+        {
+            tick();
+
+            interpolationAlpha = 1.0f;
+            present();
+            resetFrameArenas();
+        }
+
+        std::vector<std::chrono::nanoseconds> Game::replay(Round &round)
+        {
+            typedef std::chrono::steady_clock Clock;
+
+            Round *previousRound = this->round;
+            std::chrono::nanoseconds previousTickDuration = tickDuration;
+
+            // Systems see the tick duration the round was recorded with
+            setRound(&round);
+            setTickDuration(round.getTickDuration());
+            round.startReplay();
+
+            std::vector<std::chrono::nanoseconds> tickTimes;
+            tickTimes.reserve(round.getRecordedTickCount());
+
+            while (!round.isReplayFinished())
+            {
+                Clock::time_point start = Clock::now();
+                tick();
+                resetFrameArenas();
+                tickTimes.push_back(Clock::now() - start);
+            }
+
+            round.stop();
+            setRound(previousRound);
+            setTickDuration(previousTickDuration);
+
+            return tickTimes;
+        }
+
+        const std::vector<std::chrono::nanoseconds> &Game::getSystemTimings() const
+        {
+            return systemTimings;
+        }
+
+        void Game::synchronizeEntities()
+        {
+            world.collectChanges(changes);
+            if (changes.isEmpty())
+            {
+                return;
+            }
+
+            for (const std::unique_ptr<ISystem> &system : systems)
+            {
+                system->processChanges(changes);
+            }
+        }
+
+        void Game::updateSchedules()
+        {
+            std::vector<ISystem *> simulationSystems;
+            std::vector<ISystem *> presentationSystems;
+            simulation.systems.clear();
+            presentation.systems.clear();
+
+            for (std::size_t i = 0; i < systems.size(); i++)
+            {
+                if (systems[i]->isOnSeparateThread())
+                {
+                    continue;
+                }
+
+                if (systems[i]->getPhase() == ISystem::Phase::Presentation)
+                {
+                    presentationSystems.push_back(systems[i].get());
+                    presentation.systems.push_back(i);
+                }
+                else
+                {
+                    simulationSystems.push_back(systems[i].get());
+                    simulation.systems.push_back(i);
+                }
+            }
+
+            simulation.scheduler->setSystems(std::move(simulationSystems));
+            presentation.scheduler->setSystems(std::move(presentationSystems));
+            systemTimings.assign(systems.size(), std::chrono::nanoseconds::zero());
+            schedulesDirty = false;
+        }
+
+        void Game::runSchedule(Game::Schedule &schedule)
+        {
+            if (schedulesDirty)
+            {
+                updateSchedules();
+            }
+
+            schedule.scheduler->run();
+
+            const std::vector<std::chrono::nanoseconds> &timings = schedule.scheduler->getTimings();
+            for (std::size_t i = 0; i < schedule.systems.size(); i++)
+            {
+                systemTimings[schedule.systems[i]] = timings[i];
+            }
+        }
+
+        void Game::tick()
+        {
+            synchronizeEntities();
+
+            if (round != nullptr)
+            {
+                round->beginTick();
+            }
+
+            TransformHierarchy &transforms = world.getTransformHierarchy();
+            transforms.savePreviousTransforms();
+
+            runSchedule(simulation);
+            world.getEventBus().dispatch();
+            world.playbackCommands();
+            world.advanceChangeVersion();
+
+            // World transforms read during the tick are those of the previous one
+            transforms.update();
+            tickCount++;
+        }
+
+        void Game::present()
+        {
+            runSchedule(presentation);
+            world.getEventBus().dispatch();
+            world.playbackCommands();
+            world.advanceChangeVersion();
+        }
+
+        void Game::resetFrameArenas()
+        {
+            jobSystem->resetFrameArenas();
+            Utilities::FrameArena::getCurrent().reset();
+        }
+
+        void Game::pace(std::chrono::steady_clock::time_point frameStart) const
+        {
+            if (frameBudget <= std::chrono::nanoseconds::zero())
+            {
+                return;
+            }
+
+            std::chrono::steady_clock::time_point deadline = frameStart + frameBudget;
+
+            if (framePacing == FramePacing::Sleep)
+            {
+                std::this_thread::sleep_until(deadline - SpinThreshold);
+            }
+
+            while (std::chrono::steady_clock::now() < deadline)
+            {
+                std::this_thread::yield();
             }
         }
     }
@@ -1,12 +1,18 @@
 #ifndef GAME_H
 #define GAME_H
 
+#include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <memory>
 #include <vector>
 
 #include "Amber/Core/ISystem.h"
+#include "Amber/Core/Round.h"
+#include "Amber/Core/SystemScheduler.h"
 #include "Amber/Core/World.h"
 #include "Amber/Utilities/Defines.h"
+#include "Amber/Utilities/JobSystem.h"
 
 namespace Amber
 {
@@ -15,8 +21,18 @@ namespace Amber
         class AMBER_EXPORTS Game
         {
             public:
-                Game() = default;
-                ~Game() = default;
+                // How run() waits out the rest of the frame budget
+                enum class FramePacing
+                {
+                    Sleep,
+                    Spin
+                };
+
+                Game();
+
+                // Runs systems on a job system shared with other games
+                explicit Game(Utilities::JobSystem &jobSystem);
+                ~Game();
 
                 const std::vector<std::unique_ptr<ISystem>> &getSystems() const;
                 void addSystem(std::unique_ptr<ISystem> system);
@@ -25,9 +41,94 @@ namespace Amber
                 const World &getWorld() const;
                 void setWorld(World world);
 
+                Utilities::JobSystem &getJobSystem();
+
+                // The round whose players' input drives the simulation, if any.
+                // It is told about the start of every tick.
+                Round *getRound() const;
+                void setRound(Round *round);
+
+                std::chrono::nanoseconds getTickDuration() const;
+                void setTickDuration(std::chrono::nanoseconds tickDuration);
+
+                // Longest frame time fed into the simulation, so that a slow frame
+                // cannot make the following frames fall further behind.
+                std::chrono::nanoseconds getMaxFrameDuration() const;
+                void setMaxFrameDuration(std::chrono::nanoseconds maxFrameDuration);
+
+                // Minimum duration of a frame, zero meaning unlimited
+                std::chrono::nanoseconds getFrameBudget() const;
+                void setFrameBudget(std::chrono::nanoseconds frameBudget);
+
+                FramePacing getFramePacing() const;
+                void setFramePacing(FramePacing framePacing);
+
+                std::uint64_t getTickCount() const;
+
+                // Fraction of a tick elapsed since the last one, for presentation
+                // systems to interpolate between the previous and current state.
+                float getInterpolationAlpha() const;
+
+                // Runs fixed simulation ticks and presents frames until stop() is called.
+                void run();
+                void stop();
+                bool isRunning() const;
+
+                // Runs one simulation tick followed by one presentation.
+                void runSingleIteration();
+
+                // Re-runs a recorded round without presenting, as fast as possible,
+                // and returns the duration of every tick. Determinism requires the
+                // world to be in the state it was in when recording started.
+                std::vector<std::chrono::nanoseconds> replay(Round &round);
+
+                // Time spent in each system during its last iteration, indexed like
+                // getSystems(). Systems on a separate thread report zero.
+                const std::vector<std::chrono::nanoseconds> &getSystemTimings() const;
+
             private:
+                friend class Server;
+
+                struct Schedule
+                {
+                    std::unique_ptr<SystemScheduler> scheduler;
+                    std::vector<std::size_t> systems;
+                };
+
+                Game(std::unique_ptr<Utilities::JobSystem> ownedJobSystem, Utilities::JobSystem *sharedJobSystem);
+
+                void synchronizeEntities();
+                void updateSchedules();
+                void runSchedule(Schedule &schedule);
+
+                void tick();
+                void present();
+
+                // Frame data of the game's thread is released once the frame was
+                // presented, that of each worker before it takes its next job
+                void resetFrameArenas();
+                void pace(std::chrono::steady_clock::time_point frameStart) const;
+
                 std::vector<std::unique_ptr<ISystem>> systems;
                 World world;
+                Round *round;
+                EntityChanges changes;
+
+                std::unique_ptr<Utilities::JobSystem> ownedJobSystem;
+                Utilities::JobSystem *jobSystem;
+                Schedule simulation;
+                Schedule presentation;
+                std::vector<std::chrono::nanoseconds> systemTimings;
+                bool schedulesDirty;
+
+                std::chrono::nanoseconds tickDuration;
+                std::chrono::nanoseconds maxFrameDuration;
+                std::chrono::nanoseconds frameBudget;
+                FramePacing framePacing;
+
+                std::uint64_t tickCount;
+                float interpolationAlpha;
+                std::atomic<bool> running;
         };
     }
 }
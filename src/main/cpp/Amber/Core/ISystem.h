@@ -2,6 +2,8 @@
 #define ISYSTEM_H
 
 #include "Amber/Core/Entity.h"
+#include "Amber/Core/EntityChanges.h"
+#include "Amber/Core/SystemAccess.h"
 
 namespace Amber
 {
@@ -10,26 +12,65 @@ namespace Amber
         class ISystem
         {
             public:
+                // Simulation systems run once per fixed tick, presentation systems
+                // once per rendered frame.
+                enum class Phase
+                {
+                    Simulation,
+                    Presentation
+                };
+
                 ISystem() = default;
                 virtual ~ISystem() = default;
 
                 virtual bool isOnSeparateThread() const = 0;
 
+                virtual Phase getPhase() const
+                {
+                    return Phase::Simulation;
+                }
+
                 virtual void runSingleIteration() = 0;
                 virtual void run() = 0;
 
-                virtual void registerEntity(Entity &entity) = 0;
+                // Called on the main thread at the start of every tick that follows
+                // structural changes to the world, before any system runs.
+                virtual void processChanges(const EntityChanges &changes) = 0;
+
+                const SystemAccess &getAccess() const
+                {
+                    return access;
+                }
 
             protected:
+                template <typename T>
+                void readsComponent()
+                {
+                    access.addRead<T>();
+                }
+
+                template <typename T>
+                void writesComponent()
+                {
+                    access.addWrite<T>();
+                }
+
+                void requiresMainThread()
+                {
+                    access.setMainThreadOnly(true);
+                }
+
                 template <typename... Ts, typename F>
                 static void registerProxy(Entity &entity, F f)
                 {
-                    Entity::Proxy<Ts...> proxy = entity.getProxy<Ts...>();
-                    if (proxy.isValid())
+                    if (entity.hasComponents<Ts...>())
                     {
-                        f(proxy);
+                        f(entity.getProxy<Ts...>());
                     }
                 }
+
+            private:
+                SystemAccess access;
         };
     }
 }
@@ -4,5 +4,25 @@ namespace Amber
 {
     namespace Core
     {
+        Player::Player(std::uint32_t id)
+            : id(id)
+        {
+        }
+
+        std::uint32_t Player::getId() const
+        {
+            return id;
+        }
+
+        const std::vector<std::uint8_t> &Player::getInputData() const
+        {
+            return input;
+        }
+
+        void Player::setInputData(const void *data, std::size_t size)
+        {
+            const std::uint8_t *bytes = static_cast<const std::uint8_t *>(data);
+            input.assign(bytes, bytes + size);
+        }
     }
 }
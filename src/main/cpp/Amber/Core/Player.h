@@ -1,15 +1,55 @@
 #ifndef PLAYER_H
 #define PLAYER_H
 
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
 namespace Amber
 {
     namespace Core
     {
+        // A participant of a round. Its input for the current tick is an opaque,
+        // trivially copyable value defined by the game, so that rounds can
+        // record and replay it byte for byte.
         class Player
         {
             public:
-                Player() = default;
+                explicit Player(std::uint32_t id);
                 ~Player() = default;
+
+                std::uint32_t getId() const;
+
+                template <typename T>
+                void setInput(const T &input)
+                {
+                    static_assert(std::is_trivially_copyable<T>::value, "Player input must be trivially copyable");
+                    setInputData(&input, sizeof(T));
+                }
+
+                // A value initialized T while no input of that size was set
+                template <typename T>
+                T getInput() const
+                {
+                    static_assert(std::is_trivially_copyable<T>::value, "Player input must be trivially copyable");
+
+                    T result = T();
+                    if (input.size() == sizeof(T))
+                    {
+                        std::memcpy(&result, input.data(), sizeof(T));
+                    }
+
+                    return result;
+                }
+
+                const std::vector<std::uint8_t> &getInputData() const;
+                void setInputData(const void *data, std::size_t size);
+
+            private:
+                std::uint32_t id;
+                std::vector<std::uint8_t> input;
         };
     }
 }
@@ -0,0 +1 @@
+#include "Query.h"
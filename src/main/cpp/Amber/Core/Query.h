@@ -0,0 +1,194 @@
+#ifndef QUERY_H
+#define QUERY_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Amber/Core/Archetype.h"
+#include "Amber/Core/ArchetypeStorage.h"
+#include "Amber/Core/ComponentType.h"
+#include "Amber/Core/EntityCommandBuffer.h"
+#include "Amber/Utilities/FrameArena.h"
+#include "Amber/Utilities/IndexSequence.h"
+#include "Amber/Utilities/JobSystem.h"
+
+namespace Amber
+{
+    namespace Core
+    {
+        // A view over every entity that has all of the components Ts. Components
+        // requested as const are only read, the others mark the chunks they are
+        // iterated in as changed. The set of matching archetypes is captured on
+        // construction, so a query should not outlive a structural change of the
+        // world nor the frame; building one every frame is cheap, its memory
+        // comes from the calling thread's frame arena.
+        template <typename... Ts>
+        class Query
+        {
+            public:
+                explicit Query(ArchetypeStorage &storage)
+                    : storage(&storage),
+                      changedColumns(),
+                      changedVersion(0)
+                {
+                    ComponentSignature required = componentSignature<Ts...>();
+
+                    for (const std::unique_ptr<Archetype> &archetype : storage.getArchetypes())
+                    {
+                        if ((archetype->getSignature() & required) == required)
+                        {
+                            matches.push_back(Match { archetype.get(), {{ archetype->findColumn(componentTypeId<Ts>())... }} });
+                        }
+                    }
+                }
+
+                // Restricts iteration to chunks in which any of the components Us
+                // (all of Ts if none are given) was written at version or later.
+                // Systems remember World::getChangeVersion() when they run and
+                // pass it here the next time.
+                template <typename... Us>
+                Query &changedSince(std::uint32_t version)
+                {
+                    ComponentSignature filter = sizeof...(Us) > 0 ? componentSignature<Us...>() : componentSignature<Ts...>();
+                    ComponentTypeId typeIds[] = { componentTypeId<Ts>()... };
+
+                    for (std::size_t i = 0; i < sizeof...(Ts); i++)
+                    {
+                        changedColumns[i] = filter.test(typeIds[i]);
+                    }
+
+                    changedVersion = version;
+                    return *this;
+                }
+
+                std::size_t getSize() const
+                {
+                    std::size_t size = 0;
+                    for (const Match &match : matches)
+                    {
+                        size += match.archetype->getSize();
+                    }
+
+                    return size;
+                }
+
+                // Calls f(count, Ts *...) once per chunk with pointers to the
+                // beginning of each component column.
+                template <typename F>
+                void forEachChunk(F f)
+                {
+                    for (const Match &match : matches)
+                    {
+                        for (std::size_t i = 0; i < match.archetype->getChunkCount(); i++)
+                        {
+                            if (isChanged(match, i))
+                            {
+                                invokeChunk(f, match, i, Indices());
+                            }
+                        }
+                    }
+                }
+
+                // Calls f(Ts &...) for each matching entity.
+                template <typename F>
+                void forEach(F f)
+                {
+                    forEachChunk([&f] (std::size_t count, Ts *... components)
+                    {
+                        for (std::size_t i = 0; i < count; i++)
+                        {
+                            f(components[i]...);
+                        }
+                    });
+                }
+
+                // Like forEach, but chunks are distributed over the job system's threads.
+                // f is called concurrently and must only touch the passed components.
+                template <typename F>
+                void parallelForEach(Utilities::JobSystem &jobSystem, F f)
+                {
+                    Utilities::FrameVector<std::pair<const Match *, std::size_t>> chunks;
+                    for (const Match &match : matches)
+                    {
+                        for (std::size_t i = 0; i < match.archetype->getChunkCount(); i++)
+                        {
+                            if (isChanged(match, i))
+                            {
+                                chunks.emplace_back(&match, i);
+                            }
+                        }
+                    }
+
+                    auto forEachInChunk = [&f] (std::size_t count, Ts *... components)
+                    {
+                        for (std::size_t i = 0; i < count; i++)
+                        {
+                            f(components[i]...);
+                        }
+                    };
+
+                    // Commands recorded from f are ordered by chunk, not by thread
+                    EntityCommandBuffer::SortKey batch = EntityCommandBuffer::Scope::fork();
+
+                    jobSystem.parallelFor(chunks.size(), [this, &forEachInChunk, &chunks, &batch] (std::size_t index)
+                    {
+                        EntityCommandBuffer::Scope scope(batch, static_cast<std::uint32_t>(index));
+                        invokeChunk(forEachInChunk, *chunks[index].first, chunks[index].second, Indices());
+                    });
+                }
+
+            private:
+                typedef Utilities::MakeIndexSequence<sizeof...(Ts)> Indices;
+
+                struct Match
+                {
+                    Archetype *archetype;
+                    std::array<std::size_t, sizeof...(Ts)> columns;
+                };
+
+                bool isChanged(const Match &match, std::size_t chunkIndex) const
+                {
+                    if (changedVersion == 0)
+                    {
+                        return true;
+                    }
+
+                    const Archetype::Chunk &chunk = match.archetype->getChunk(chunkIndex);
+                    for (std::size_t i = 0; i < sizeof...(Ts); i++)
+                    {
+                        if (changedColumns[i] && chunk.getChangeVersion(match.columns[i]) >= changedVersion)
+                        {
+                            return true;
+                        }
+                    }
+
+                    return false;
+                }
+
+                template <typename F, std::size_t... Is>
+                void invokeChunk(F &f, const Match &match, std::size_t chunkIndex, Utilities::IndexSequence<Is...>)
+                {
+                    Archetype::Chunk &chunk = match.archetype->getChunk(chunkIndex);
+
+                    std::uint32_t version = storage->getChangeVersion();
+                    bool expand[] = { false, (std::is_const<Ts>::value || (chunk.setChangeVersion(match.columns[Is], version), false))... };
+                    (void) expand;
+
+                    f(chunk.getSize(), static_cast<Ts *>(match.archetype->getColumn(chunk, match.columns[Is]))...);
+                }
+
+                ArchetypeStorage *storage;
+                Utilities::FrameVector<Match> matches;
+
+                // Chunks are skipped unless one of these columns is at least changedVersion
+                std::array<bool, sizeof...(Ts)> changedColumns;
+                std::uint32_t changedVersion;
+        };
+    }
+}
+
+#endif // QUERY_H
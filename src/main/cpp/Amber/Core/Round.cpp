@@ -1,8 +1,274 @@
 #include "Round.h"
 
+#include <algorithm>
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+
 namespace Amber
 {
     namespace Core
     {
+        namespace
+        {
+            const char Magic[8] = { 'A', 'M', 'B', 'E', 'R', 'R', 'E', 'C' };
+            const std::uint32_t Version = 1;
+            const std::uint32_t ByteOrderMark = 0x01020304;
+
+            struct Header
+            {
+                char magic[8];
+                std::uint32_t version;
+                std::uint32_t byteOrderMark;
+                std::uint64_t seed;
+                std::int64_t tickDuration;
+                std::uint64_t tickCount;
+                std::uint32_t playerCount;
+                std::uint32_t changeCount;
+                std::uint64_t dataSize;
+            };
+
+            // SplitMix64, cheap and well distributed for consecutive inputs
+            std::uint64_t mix(std::uint64_t value)
+            {
+                value += 0x9e3779b97f4a7c15ull;
+                value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ull;
+                value = (value ^ (value >> 27)) * 0x94d049bb133111ebull;
+                return value ^ (value >> 31);
+            }
+
+            void read(std::istream &stream, void *data, std::size_t size)
+            {
+                if (size > 0 && !stream.read(static_cast<char *>(data), size))
+                {
+                    throw std::runtime_error("Recording is truncated");
+                }
+            }
+        }
+
+        Round::Round(std::uint64_t seed)
+            : seed(seed),
+              mode(Mode::Live),
+              tickDuration(std::chrono::nanoseconds::zero()),
+              tick(0),
+              recordedTickCount(0),
+              nextChange(0)
+        {
+        }
+
+        Round::~Round()
+        {
+        }
+
+        Player &Round::addPlayer()
+        {
+            players.emplace_back(new Player(static_cast<std::uint32_t>(players.size())));
+            return *players.back();
+        }
+
+        Player &Round::getPlayer(std::uint32_t id)
+        {
+            return *players.at(id);
+        }
+
+        const std::vector<std::unique_ptr<Player>> &Round::getPlayers() const
+        {
+            return players;
+        }
+
+        std::uint64_t Round::getSeed() const
+        {
+            return seed;
+        }
+
+        std::uint64_t Round::getTickSeed(std::uint64_t tick) const
+        {
+            return mix(seed ^ mix(tick));
+        }
+
+        Round::Mode Round::getMode() const
+        {
+            return mode;
+        }
+
+        void Round::startRecording(std::chrono::nanoseconds tickDuration)
+        {
+            this->tickDuration = tickDuration;
+
+            mode = Mode::Recording;
+            tick = 0;
+            recordedTickCount = 0;
+
+            changes.clear();
+            inputData.clear();
+            recordedInputs.assign(players.size(), std::vector<std::uint8_t>());
+        }
+
+        void Round::startReplay()
+        {
+            mode = Mode::Replaying;
+            tick = 0;
+            nextChange = 0;
+
+            for (const std::unique_ptr<Player> &player : players)
+            {
+                player->setInputData(nullptr, 0);
+            }
+        }
+
+        void Round::stop()
+        {
+            mode = Mode::Live;
+        }
+
+        std::chrono::nanoseconds Round::getTickDuration() const
+        {
+            return tickDuration;
+        }
+
+        std::uint64_t Round::getRecordedTickCount() const
+        {
+            return recordedTickCount;
+        }
+
+        std::uint64_t Round::getTick() const
+        {
+            return tick;
+        }
+
+        bool Round::isReplayFinished() const
+        {
+            return mode == Mode::Replaying && tick >= recordedTickCount;
+        }
+
+        void Round::beginTick()
+        {
+            switch (mode)
+            {
+                case Mode::Recording:
+                    record();
+                    tick++;
+                    recordedTickCount = tick;
+                    break;
+
+                case Mode::Replaying:
+                    replay();
+                    tick++;
+                    break;
+
+                default:
+                    break;
+            }
+        }
+
+        void Round::save(std::ostream &stream) const
+        {
+            Header header;
+            std::memcpy(header.magic, Magic, sizeof(Magic));
+            header.version = Version;
+            header.byteOrderMark = ByteOrderMark;
+            header.seed = seed;
+            header.tickDuration = tickDuration.count();
+            header.tickCount = recordedTickCount;
+            header.playerCount = static_cast<std::uint32_t>(players.size());
+            header.changeCount = static_cast<std::uint32_t>(changes.size());
+            header.dataSize = inputData.size();
+
+            stream.write(reinterpret_cast<const char *>(&header), sizeof(header));
+            stream.write(reinterpret_cast<const char *>(changes.data()), changes.size() * sizeof(InputChange));
+            stream.write(reinterpret_cast<const char *>(inputData.data()), inputData.size());
+
+            if (!stream)
+            {
+                throw std::runtime_error("Could not write recording");
+            }
+        }
+
+        void Round::load(std::istream &stream)
+        {
+            Header header;
+            read(stream, &header, sizeof(header));
+
+            if (std::memcmp(header.magic, Magic, sizeof(Magic)) != 0)
+            {
+                throw std::runtime_error("Not an Amber recording");
+            }
+
+            if (header.byteOrderMark != ByteOrderMark)
+            {
+                throw std::runtime_error("Recording was written with a different byte order");
+            }
+
+            if (header.version != Version)
+            {
+                throw std::runtime_error("Unsupported recording version " + std::to_string(header.version));
+            }
+
+            std::vector<InputChange> loadedChanges(header.changeCount);
+            read(stream, loadedChanges.data(), loadedChanges.size() * sizeof(InputChange));
+
+            std::vector<std::uint8_t> loadedData(header.dataSize);
+            read(stream, loadedData.data(), loadedData.size());
+
+            // Replay walks the changes in tick order
+            std::uint32_t previousTick = 0;
+            for (const InputChange &change : loadedChanges)
+            {
+                if (change.player >= header.playerCount || change.tick >= header.tickCount || change.tick < previousTick
+                        || change.offset > loadedData.size() || change.size > loadedData.size() - change.offset)
+                {
+                    throw std::runtime_error("Recording is corrupt");
+                }
+
+                previousTick = change.tick;
+            }
+
+            seed = header.seed;
+            tickDuration = std::chrono::nanoseconds(header.tickDuration);
+            recordedTickCount = header.tickCount;
+            changes = std::move(loadedChanges);
+            inputData = std::move(loadedData);
+
+            players.clear();
+            for (std::uint32_t i = 0; i < header.playerCount; i++)
+            {
+                addPlayer();
+            }
+
+            mode = Mode::Live;
+            tick = 0;
+            nextChange = 0;
+        }
+
+        void Round::record()
+        {
+            recordedInputs.resize(players.size());
+
+            for (std::size_t i = 0; i < players.size(); i++)
+            {
+                const std::vector<std::uint8_t> &input = players[i]->getInputData();
+                if (input == recordedInputs[i])
+                {
+                    continue;
+                }
+
+                changes.push_back(InputChange { static_cast<std::uint32_t>(tick), static_cast<std::uint32_t>(i),
+                                                static_cast<std::uint32_t>(input.size()), static_cast<std::uint32_t>(inputData.size()) });
+                inputData.insert(inputData.end(), input.begin(), input.end());
+                recordedInputs[i] = input;
+            }
+        }
+
+        void Round::replay()
+        {
+            while (nextChange < changes.size() && changes[nextChange].tick == tick)
+            {
+                const InputChange &change = changes[nextChange];
+                players[change.player]->setInputData(inputData.data() + change.offset, change.size);
+                nextChange++;
+            }
+        }
     }
 }
@@ -1,16 +1,95 @@
 #ifndef ROUND_H
 #define ROUND_H
 
+#include <chrono>
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <vector>
+
+#include "Amber/Core/Player.h"
 
 namespace Amber
 {
     namespace Core
     {
+        // One session of the game: its players, the seed all randomness is
+        // derived from and, while recording, the input of every tick. Only
+        // input changes are stored, so a recording is a compact stream that
+        // replays the session exactly when started from the same world.
         class Round
         {
             public:
-                Round() = default;
-                ~Round() = default;
+                enum class Mode
+                {
+                    Live,
+                    Recording,
+                    Replaying
+                };
+
+                explicit Round(std::uint64_t seed = 0);
+                Round(const Round &other) = delete;
+                ~Round();
+
+                Round &operator =(const Round &other) = delete;
+
+                Player &addPlayer();
+                Player &getPlayer(std::uint32_t id);
+                const std::vector<std::unique_ptr<Player>> &getPlayers() const;
+
+                std::uint64_t getSeed() const;
+
+                // Seed for randomness used during the given tick, the same when
+                // the round is replayed
+                std::uint64_t getTickSeed(std::uint64_t tick) const;
+
+                Mode getMode() const;
+
+                // Discards a previous recording
+                void startRecording(std::chrono::nanoseconds tickDuration);
+                void startReplay();
+                void stop();
+
+                // Tick duration and number of ticks of the recording
+                std::chrono::nanoseconds getTickDuration() const;
+                std::uint64_t getRecordedTickCount() const;
+
+                // Ticks since recording or replay started
+                std::uint64_t getTick() const;
+                bool isReplayFinished() const;
+
+                // Called by the game before the systems of a tick run. Records the
+                // players' input, or replaces it with the recorded one.
+                void beginTick();
+
+                void save(std::ostream &stream) const;
+                void load(std::istream &stream);
+
+            private:
+                struct InputChange
+                {
+                    std::uint32_t tick;
+                    std::uint32_t player;
+                    std::uint32_t size;
+                    std::uint32_t offset;
+                };
+
+                void record();
+                void replay();
+
+                std::uint64_t seed;
+                std::vector<std::unique_ptr<Player>> players;
+
+                Mode mode;
+                std::chrono::nanoseconds tickDuration;
+                std::uint64_t tick;
+                std::uint64_t recordedTickCount;
+
+                // Input bytes of all changes, and the last recorded input per player
+                std::vector<InputChange> changes;
+                std::vector<std::uint8_t> inputData;
+                std::vector<std::vector<std::uint8_t>> recordedInputs;
+                std::size_t nextChange;
         };
     }
 }
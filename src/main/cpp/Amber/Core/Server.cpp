@@ -0,0 +1,195 @@
+#include "Server.h"
+
+#include <algorithm>
+#include <thread>
+
+#include "Amber/Utilities/FrameArena.h"
+
+namespace Amber
+{
+    namespace Core
+    {
+        namespace
+        {
+            // How long run() sleeps while no game is hosted
+            const std::chrono::milliseconds IdleSleep(1);
+        }
+
+        Server::Server()
+            : jobSystem(new Utilities::JobSystem()),
+              running(false)
+        {
+        }
+
+        Server::Server(std::size_t workerCount, bool pinWorkers)
+            : jobSystem(new Utilities::JobSystem(workerCount, pinWorkers)),
+              running(false)
+        {
+        }
+
+        Server::~Server()
+        {
+        }
+
+        Utilities::JobSystem &Server::getJobSystem()
+        {
+            return *jobSystem;
+        }
+
+        Game &Server::addGame(std::chrono::nanoseconds budget)
+        {
+            std::unique_ptr<HostedGame> hosted(new HostedGame());
+            hosted->game.reset(new Game(*jobSystem));
+            hosted->budget = budget;
+            hosted->nextTick = Clock::now();
+            hosted->stats = Stats {
+                0,
+                std::chrono::nanoseconds::zero(),
+                std::chrono::nanoseconds::zero(),
+                std::chrono::nanoseconds::zero(),
+                0,
+                0
+            };
+
+            games.push_back(std::move(hosted));
+            return *games.back()->game;
+        }
+
+        bool Server::removeGame(const Game &game)
+        {
+            auto it = std::find_if(games.begin(), games.end(), [&game] (const std::unique_ptr<HostedGame> &hosted) {
+                return hosted->game.get() == &game;
+            });
+
+            if (it == games.end())
+            {
+                return false;
+            }
+
+            games.erase(it);
+            return true;
+        }
+
+        std::size_t Server::getGameCount() const
+        {
+            return games.size();
+        }
+
+        Game &Server::getGame(std::size_t index)
+        {
+            return *games.at(index)->game;
+        }
+
+        std::chrono::nanoseconds Server::getBudget(std::size_t index) const
+        {
+            const HostedGame &hosted = *games.at(index);
+            return hosted.budget > std::chrono::nanoseconds::zero() ? hosted.budget : hosted.game->getTickDuration();
+        }
+
+        void Server::setBudget(std::size_t index, std::chrono::nanoseconds budget)
+        {
+            games.at(index)->budget = budget;
+        }
+
+        const Server::Stats &Server::getStats(std::size_t index) const
+        {
+            return games.at(index)->stats;
+        }
+
+        void Server::run()
+        {
+            running = true;
+
+            while (running)
+            {
+                Clock::time_point nextTick = runSingleIteration();
+                if (games.empty())
+                {
+                    std::this_thread::sleep_for(IdleSleep);
+                }
+                else
+                {
+                    std::this_thread::sleep_until(nextTick);
+                }
+            }
+        }
+
+        void Server::stop()
+        {
+            running = false;
+        }
+
+        bool Server::isRunning() const
+        {
+            return running;
+        }
+
+        Server::Clock::time_point Server::runSingleIteration()
+        {
+            Clock::time_point now = Clock::now();
+
+            dueGames.clear();
+            for (const std::unique_ptr<HostedGame> &hosted : games)
+            {
+                if (hosted->nextTick <= now)
+                {
+                    dueGames.push_back(hosted.get());
+                }
+            }
+
+            // Each game's systems are jobs of the same system, so one slow game
+            // does not hold up the others
+            jobSystem->parallelFor(dueGames.size(), [this] (std::size_t index) {
+                tick(*dueGames[index]);
+            }, 1);
+
+            jobSystem->resetFrameArenas();
+            Utilities::FrameArena::getCurrent().reset();
+
+            Clock::time_point nextTick = Clock::time_point::max();
+            for (const std::unique_ptr<HostedGame> &hosted : games)
+            {
+                nextTick = std::min(nextTick, hosted->nextTick);
+            }
+
+            return nextTick;
+        }
+
+        void Server::tick(HostedGame &hosted)
+        {
+            Game &game = *hosted.game;
+
+            // The jobs of the tick belong to the game, while waiting for them
+            // this thread runs no other game's, which would count as this tick
+            Clock::time_point start = Clock::now();
+            {
+                Utilities::JobSystem::OwnerScope owner(&game);
+                game.tick();
+            }
+            Clock::time_point end = Clock::now();
+
+            std::chrono::nanoseconds tickTime = end - start;
+            std::chrono::nanoseconds budget = hosted.budget > std::chrono::nanoseconds::zero() ? hosted.budget : game.getTickDuration();
+
+            Stats &stats = hosted.stats;
+            stats.tickCount++;
+            stats.lastTickTime = tickTime;
+            stats.totalTickTime += tickTime;
+            stats.maxTickTime = std::max(stats.maxTickTime, tickTime);
+            if (tickTime > budget)
+            {
+                stats.overBudgetCount++;
+            }
+
+            // Like Game::run(), a game that fell too far behind drops ticks
+            // instead of trying to catch up with all of them
+            hosted.nextTick += game.getTickDuration();
+            if (end - hosted.nextTick > game.getMaxFrameDuration())
+            {
+                std::uint64_t skipped = static_cast<std::uint64_t>((end - hosted.nextTick) / game.getTickDuration());
+                hosted.nextTick += skipped * game.getTickDuration();
+                stats.skippedTickCount += skipped;
+            }
+        }
+    }
+}
@@ -0,0 +1,94 @@
+#ifndef SERVER_H
+#define SERVER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "Amber/Core/Game.h"
+#include "Amber/Utilities/Defines.h"
+#include "Amber/Utilities/JobSystem.h"
+
+namespace Amber
+{
+    namespace Core
+    {
+        // Hosts many headless games, one per match, in a single process. All of
+        // them share one job system and tick at their own fixed rate; nothing is
+        // presented, so no rendering system or GPU context is ever created.
+        class AMBER_EXPORTS Server
+        {
+            public:
+                typedef std::chrono::steady_clock Clock;
+
+                struct Stats
+                {
+                    std::uint64_t tickCount;
+                    std::chrono::nanoseconds lastTickTime;
+                    std::chrono::nanoseconds totalTickTime;
+                    std::chrono::nanoseconds maxTickTime;
+
+                    // Ticks that took longer than the game's budget, and ticks
+                    // dropped because the game fell too far behind. The budget
+                    // is only measured against, a running tick is never cut short.
+                    std::uint64_t overBudgetCount;
+                    std::uint64_t skippedTickCount;
+                };
+
+                Server();
+                explicit Server(std::size_t workerCount, bool pinWorkers = false);
+                Server(const Server &other) = delete;
+                ~Server();
+
+                Server &operator =(const Server &other) = delete;
+
+                Utilities::JobSystem &getJobSystem();
+
+                // Adds a game whose ticks should take at most budget, zero meaning
+                // its tick duration. Tick times are wall times on the ticking
+                // thread, which only runs the game's own jobs meanwhile. Games are
+                // added and removed while not running.
+                Game &addGame(std::chrono::nanoseconds budget = std::chrono::nanoseconds::zero());
+                bool removeGame(const Game &game);
+
+                std::size_t getGameCount() const;
+                Game &getGame(std::size_t index);
+
+                std::chrono::nanoseconds getBudget(std::size_t index) const;
+                void setBudget(std::size_t index, std::chrono::nanoseconds budget);
+
+                // Only consistent between iterations or while not running
+                const Stats &getStats(std::size_t index) const;
+
+                // Ticks due games until stop() is called, sleeping in between
+                void run();
+                void stop();
+                bool isRunning() const;
+
+                // Ticks every game that is due in parallel and returns when the
+                // next one is due
+                Clock::time_point runSingleIteration();
+
+            private:
+                struct HostedGame
+                {
+                    std::unique_ptr<Game> game;
+                    std::chrono::nanoseconds budget;
+                    Clock::time_point nextTick;
+                    Stats stats;
+                };
+
+                void tick(HostedGame &hosted);
+
+                std::unique_ptr<Utilities::JobSystem> jobSystem;
+                std::vector<std::unique_ptr<HostedGame>> games;
+                std::vector<HostedGame *> dueGames;
+                std::atomic<bool> running;
+        };
+    }
+}
+
+#endif // SERVER_H
@@ -0,0 +1,48 @@
+#include "SystemAccess.h"
+
+namespace Amber
+{
+    namespace Core
+    {
+        SystemAccess::SystemAccess()
+            : declared(false),
+              mainThreadOnly(false)
+        {
+        }
+
+        bool SystemAccess::isDeclared() const
+        {
+            return declared;
+        }
+
+        bool SystemAccess::isMainThreadOnly() const
+        {
+            return mainThreadOnly;
+        }
+
+        void SystemAccess::setMainThreadOnly(bool mainThreadOnly)
+        {
+            this->mainThreadOnly = mainThreadOnly;
+        }
+
+        bool SystemAccess::conflictsWith(const SystemAccess &other) const
+        {
+            if (!declared || !other.declared)
+            {
+                return true;
+            }
+
+            return (writes & (other.writes | other.reads)).any() || (reads & other.writes).any();
+        }
+
+        const ComponentSignature &SystemAccess::getReads() const
+        {
+            return reads;
+        }
+
+        const ComponentSignature &SystemAccess::getWrites() const
+        {
+            return writes;
+        }
+    }
+}
@@ -0,0 +1,51 @@
+#ifndef SYSTEMACCESS_H
+#define SYSTEMACCESS_H
+
+#include "Amber/Core/ComponentType.h"
+
+namespace Amber
+{
+    namespace Core
+    {
+        // The component types a system reads and writes during an iteration,
+        // used to decide which systems may run at the same time.
+        class SystemAccess
+        {
+            public:
+                SystemAccess();
+
+                template <typename T>
+                void addRead()
+                {
+                    reads.set(componentTypeId<T>());
+                    declared = true;
+                }
+
+                template <typename T>
+                void addWrite()
+                {
+                    writes.set(componentTypeId<T>());
+                    declared = true;
+                }
+
+                bool isDeclared() const;
+
+                bool isMainThreadOnly() const;
+                void setMainThreadOnly(bool mainThreadOnly);
+
+                // Undeclared access is treated as touching every component.
+                bool conflictsWith(const SystemAccess &other) const;
+
+                const ComponentSignature &getReads() const;
+                const ComponentSignature &getWrites() const;
+
+            private:
+                ComponentSignature reads;
+                ComponentSignature writes;
+                bool declared;
+                bool mainThreadOnly;
+        };
+    }
+}
+
+#endif // SYSTEMACCESS_H
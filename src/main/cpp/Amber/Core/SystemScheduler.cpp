@@ -0,0 +1,150 @@
+#include "SystemScheduler.h"
+
+#include <cstdint>
+
+#include "Amber/Core/EntityCommandBuffer.h"
+
+namespace Amber
+{
+    namespace Core
+    {
+        namespace
+        {
+            // Upper bound on noticing jobs that were queued while waiting
+            const std::chrono::microseconds IdleWait(100);
+        }
+
+        SystemScheduler::SystemScheduler(Utilities::JobSystem &jobSystem)
+            : jobSystem(&jobSystem),
+              completed(0)
+        {
+        }
+
+        void SystemScheduler::setSystems(std::vector<ISystem *> systems)
+        {
+            nodes.clear();
+            for (ISystem *system : systems)
+            {
+                nodes.push_back(Node { system, std::vector<std::size_t>(), 0 });
+            }
+
+            // Registration order decides which of two conflicting systems goes first
+            for (std::size_t i = 0; i < nodes.size(); i++)
+            {
+                for (std::size_t j = i + 1; j < nodes.size(); j++)
+                {
+                    if (nodes[i].system->getAccess().conflictsWith(nodes[j].system->getAccess()))
+                    {
+                        nodes[i].successors.push_back(j);
+                        nodes[j].dependencyCount++;
+                    }
+                }
+            }
+
+            timings.assign(nodes.size(), std::chrono::nanoseconds::zero());
+        }
+
+        void SystemScheduler::run()
+        {
+            Utilities::FrameVector<std::size_t> ready;
+
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+
+                completed = 0;
+                remainingDependencies.clear();
+                for (std::size_t i = 0; i < nodes.size(); i++)
+                {
+                    remainingDependencies.push_back(nodes[i].dependencyCount);
+                    if (nodes[i].dependencyCount == 0)
+                    {
+                        ready.push_back(i);
+                    }
+                }
+            }
+
+            dispatch(ready);
+
+            std::unique_lock<std::mutex> lock(mutex);
+            while (completed < nodes.size())
+            {
+                if (!mainThreadQueue.empty())
+                {
+                    std::size_t index = mainThreadQueue.front();
+                    mainThreadQueue.pop_front();
+
+                    lock.unlock();
+                    execute(index);
+                    lock.lock();
+                    continue;
+                }
+
+                // run() may itself be a job, as on a server ticking many worlds,
+                // so waiting must not hold up the jobs it waits for. Only jobs of
+                // the current owner run here, a server's games do not run each
+                // other's systems while waiting.
+                lock.unlock();
+                bool ranJob = jobSystem->runPendingJob();
+                lock.lock();
+
+                if (!ranJob)
+                {
+                    progress.wait_for(lock, IdleWait, [this] () { return !mainThreadQueue.empty() || completed == nodes.size(); });
+                }
+            }
+        }
+
+        const std::vector<std::chrono::nanoseconds> &SystemScheduler::getTimings() const
+        {
+            return timings;
+        }
+
+        void SystemScheduler::dispatch(const Utilities::FrameVector<std::size_t> &ready)
+        {
+            for (std::size_t index : ready)
+            {
+                if (nodes[index].system->getAccess().isMainThreadOnly())
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    mainThreadQueue.push_back(index);
+                    progress.notify_all();
+                }
+                else
+                {
+                    jobSystem->submit([this, index] () { execute(index); });
+                }
+            }
+        }
+
+        void SystemScheduler::execute(std::size_t index)
+        {
+            {
+                EntityCommandBuffer::Scope scope(static_cast<std::uint32_t>(index));
+
+                std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+                nodes[index].system->runSingleIteration();
+                timings[index] = std::chrono::steady_clock::now() - start;
+            }
+
+            Utilities::FrameVector<std::size_t> ready;
+
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+
+                for (std::size_t successor : nodes[index].successors)
+                {
+                    if (--remainingDependencies[successor] == 0)
+                    {
+                        ready.push_back(successor);
+                    }
+                }
+
+                // Notified under the lock, run() may return as soon as it is released
+                completed++;
+                progress.notify_all();
+            }
+
+            dispatch(ready);
+        }
+    }
+}
@@ -0,0 +1,64 @@
+#ifndef SYSTEMSCHEDULER_H
+#define SYSTEMSCHEDULER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+#include "Amber/Core/ISystem.h"
+#include "Amber/Utilities/FrameArena.h"
+#include "Amber/Utilities/JobSystem.h"
+
+namespace Amber
+{
+    namespace Core
+    {
+        // Runs one iteration of a set of systems, starting each system as soon
+        // as every earlier system it conflicts with has finished. Systems that
+        // require the main thread are run on the thread calling run().
+        class SystemScheduler
+        {
+            public:
+                explicit SystemScheduler(Utilities::JobSystem &jobSystem);
+                SystemScheduler(const SystemScheduler &other) = delete;
+                ~SystemScheduler() = default;
+
+                SystemScheduler &operator =(const SystemScheduler &other) = delete;
+
+                void setSystems(std::vector<ISystem *> systems);
+
+                void run();
+
+                // Wall time spent in each system during the last run, in the
+                // order the systems were given.
+                const std::vector<std::chrono::nanoseconds> &getTimings() const;
+
+            private:
+                struct Node
+                {
+                    ISystem *system;
+                    std::vector<std::size_t> successors;
+                    std::size_t dependencyCount;
+                };
+
+                void dispatch(const Utilities::FrameVector<std::size_t> &ready);
+                void execute(std::size_t index);
+
+                Utilities::JobSystem *jobSystem;
+
+                std::vector<Node> nodes;
+                std::vector<std::chrono::nanoseconds> timings;
+
+                std::vector<std::size_t> remainingDependencies;
+                std::deque<std::size_t> mainThreadQueue;
+                std::size_t completed;
+                std::mutex mutex;
+                std::condition_variable progress;
+        };
+    }
+}
+
+#endif // SYSTEMSCHEDULER_H
@@ -1,92 +1,162 @@
 #include "Transform.h"
 
+#include <stdexcept>
+
+#include <Eigen/Geometry>
+
 namespace Amber
 {
     namespace Core
     {
-        Transform::Transform(Eigen::Matrix4f transform)
-            : Transform(std::move(transform), nullptr)
+        Transform::Transform(Eigen::Matrix4f transform, TransformHierarchy &hierarchy)
+            : hierarchy(&hierarchy),
+              node(hierarchy.create(transform))
+        {
+        }
+
+        Transform::Transform(Eigen::Matrix4f transform, const Transform &parent)
+            : hierarchy(parent.hierarchy),
+              node(parent.hierarchy->create(transform, parent.node))
         {
         }
 
-        Transform::Transform(Eigen::Matrix4f transform, Transform *parent)
-            : localTransform(std::move(transform)),
-              parent(parent),
-              dirty(true)
+        Transform::Transform(const Transform &other)
+            : hierarchy(other.hierarchy),
+              node(other.node)
         {
-            if (parent != nullptr)
+            if (hierarchy != nullptr)
             {
-                parent->addChild(this);
+                hierarchy->acquire(node);
             }
         }
 
+        Transform::Transform(Transform &&other) noexcept
+            : hierarchy(other.hierarchy),
+              node(other.node)
+        {
+            other.hierarchy = nullptr;
+        }
+
         Transform::~Transform()
         {
-            for (Transform *child : children)
+            reset();
+        }
+
+        Transform &Transform::operator =(const Transform &other)
+        {
+            if (other.hierarchy != nullptr)
+            {
+                other.hierarchy->acquire(other.node);
+            }
+
+            reset();
+            hierarchy = other.hierarchy;
+            node = other.node;
+
+            return *this;
+        }
+
+        Transform &Transform::operator =(Transform &&other) noexcept
+        {
+            if (this != &other)
             {
-                child->localTransform = child->getTransform();
-                child->parent = nullptr;
+                reset();
+                hierarchy = other.hierarchy;
+                node = other.node;
+
+                other.hierarchy = nullptr;
             }
+
+            return *this;
         }
 
-        const Eigen::Matrix4f &Transform::getTransform() const
+        Eigen::Matrix4f Transform::getTransform() const
         {
-            if (dirty)
+            return hierarchy->getWorldTransform(node);
+        }
+
+        Eigen::Matrix4f Transform::getPreviousTransform() const
+        {
+            return hierarchy->getPreviousTransform(node);
+        }
+
+        Eigen::Matrix4f Transform::getInterpolatedTransform(float alpha) const
+        {
+            return interpolate(getPreviousTransform(), getTransform(), alpha);
+        }
+
+        Eigen::Matrix4f Transform::interpolate(const Eigen::Matrix4f &from, const Eigen::Matrix4f &to, float alpha)
+        {
+            if (alpha >= 1.0f || from == to)
             {
-                if (parent)
-                {
-                    calculatedTransform = parent->getTransform() * localTransform;
-                }
-                else
-                {
-                    calculatedTransform = localTransform;
-                }
-
-                this->dirty = false;
+                return to;
             }
 
-            return calculatedTransform;
+            Eigen::Affine3f fromAffine(from);
+            Eigen::Affine3f toAffine(to);
+
+            Eigen::Matrix3f fromRotation, fromScaling, toRotation, toScaling;
+            fromAffine.computeRotationScaling(&fromRotation, &fromScaling);
+            toAffine.computeRotationScaling(&toRotation, &toScaling);
+
+            Eigen::Quaternionf rotation = Eigen::Quaternionf(fromRotation).slerp(alpha, Eigen::Quaternionf(toRotation));
+
+            Eigen::Affine3f result = Eigen::Affine3f::Identity();
+            result.translation() = fromAffine.translation() + alpha * (toAffine.translation() - fromAffine.translation());
+            result.linear() = rotation.toRotationMatrix() * (fromScaling + alpha * (toScaling - fromScaling));
+
+            return result.matrix();
         }
 
-        const Eigen::Matrix4f &Transform::getLocalTransform() const
+        Eigen::Matrix4f Transform::getLocalTransform() const
         {
-            return localTransform;
+            return hierarchy->getLocalTransform(node);
         }
 
         void Transform::setLocalTransform(Eigen::Matrix4f localTransform)
         {
-            this->localTransform = std::move(localTransform);
-            markDirty();
+            hierarchy->setLocalTransform(node, localTransform);
+        }
+
+        bool Transform::hasParent() const
+        {
+            return hierarchy->getParent(node) != TransformHierarchy::None;
         }
 
-        const Transform *Transform::getParent() const
+        void Transform::setParent(const Transform &parent)
         {
-            return parent;
+            if (parent.hierarchy != hierarchy)
+            {
+                throw std::invalid_argument("Transforms belong to different hierarchies");
+            }
+
+            hierarchy->setParent(node, parent.node);
         }
 
         void Transform::flatten()
         {
-            this->localTransform = getTransform();
-            this->parent->removeChild(this);
-            this->parent = nullptr;
+            Eigen::Matrix4f worldTransform = hierarchy->computeWorldTransform(node);
+
+            hierarchy->setParent(node, TransformHierarchy::None);
+            hierarchy->setLocalTransform(node, worldTransform);
         }
 
-        void Transform::addChild(Transform *child)
+        TransformHierarchy &Transform::getHierarchy() const
         {
-            this->children.push_back(child);
+            return *hierarchy;
         }
 
-        void Transform::removeChild(Transform *child)
+        TransformHierarchy::Node Transform::getNode() const
         {
-            this->children.erase(std::remove(this->children.begin(), this->children.end(), child));
+            return node;
         }
 
-        void Transform::markDirty()
+        void Transform::reset()
         {
-            this->dirty = true;
-            for (Transform *child : children)
+            if (hierarchy != nullptr)
             {
-                child->markDirty();
+                hierarchy->release(node);
+                hierarchy = nullptr;
             }
         }
     }
@@ -1,45 +1,66 @@
 #ifndef TRANSFORM_H
 #define TRANSFORM_H
 
+#include "Amber/Core/ComponentType.h"
 #include "Amber/Core/IComponent.h"
 
-#include <vector>
-
 #include <Eigen/Core>
 
+#include "Amber/Core/TransformHierarchy.h"
+
 namespace Amber
 {
     namespace Core
     {
+        // A reference to a node of a world's transform hierarchy. Copies refer to
+        // the same node, which lives until the last reference to it and to its
+        // descendants is gone.
         class Transform : public IComponent
         {
             public:
-                explicit Transform(Eigen::Matrix4f transform);
-                Transform(Eigen::Matrix4f transform, Transform *parent);
+                Transform(Eigen::Matrix4f transform, TransformHierarchy &hierarchy);
+                Transform(Eigen::Matrix4f transform, const Transform &parent);
+                Transform(const Transform &other);
+                Transform(Transform &&other) noexcept;
                 virtual ~Transform();
 
-                const Eigen::Matrix4f &getTransform() const;
+                Transform &operator =(const Transform &other);
+                Transform &operator =(Transform &&other) noexcept;
+
+                // World transform as of the last hierarchy update
+                Eigen::Matrix4f getTransform() const;
+
+                // World transform as of the start of the current simulation tick
+                Eigen::Matrix4f getPreviousTransform() const;
+
+                // Blends the previous and the current world transform, alpha = 1
+                // being the current one.
+                Eigen::Matrix4f getInterpolatedTransform(float alpha) const;
 
-                const Eigen::Matrix4f &getLocalTransform() const;
+                // Lerps translation and scale and slerps rotation of two affine transforms
+                static Eigen::Matrix4f interpolate(const Eigen::Matrix4f &from, const Eigen::Matrix4f &to, float alpha);
+
+                Eigen::Matrix4f getLocalTransform() const;
                 void setLocalTransform(Eigen::Matrix4f localTransform);
 
-                const Transform *getParent() const;
+                bool hasParent() const;
+                void setParent(const Transform &parent);
 
+                // Detaches from the parent, keeping the current world transform
                 void flatten();
 
-            private:
-                void addChild(Transform *child);
-                void removeChild(Transform *child);
-                void markDirty();
+                TransformHierarchy &getHierarchy() const;
+                TransformHierarchy::Node getNode() const;
 
-                Eigen::Matrix4f localTransform;
-                Transform *parent;
-                std::vector<Transform *> children;
+            private:
+                void reset();
 
-                mutable Eigen::Matrix4f calculatedTransform;
-                mutable bool dirty;
+                TransformHierarchy *hierarchy;
+                TransformHierarchy::Node node;
         };
     }
 }
 
+AMBER_COMPONENT_TYPE(Amber::Core::Transform, 0)
+
 #endif // TRANSFORM_H
@@ -0,0 +1,370 @@
+#include "TransformHierarchy.h"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+namespace Amber
+{
+    namespace Core
+    {
+        const TransformHierarchy::Node TransformHierarchy::None = { std::numeric_limits<std::uint32_t>::max(), 0 };
+
+        constexpr std::uint32_t TransformHierarchy::NoPosition;
+
+        TransformHierarchy::TransformHierarchy()
+            : updateCount(0),
+              hasReleasedNodes(false),
+              isUnordered(false)
+        {
+        }
+
+        TransformHierarchy::Node TransformHierarchy::create(const Eigen::Matrix4f &localTransform, TransformHierarchy::Node parent)
+        {
+            std::uint32_t parentPosition = parent == None ? NoPosition : getPosition(parent);
+
+            Math::AffineTransform local = Math::AffineTransform::fromMatrix(localTransform);
+            Math::AffineTransform worldTransform = local;
+            if (parentPosition != NoPosition)
+            {
+                Math::multiply(composeWorldTransform(parentPosition), local, worldTransform);
+            }
+
+            std::uint32_t slot;
+            if (!freeSlots.empty())
+            {
+                slot = freeSlots.back();
+                freeSlots.pop_back();
+            }
+            else
+            {
+                slot = static_cast<std::uint32_t>(slots.size());
+                slots.push_back(Slot { NoPosition, 0 });
+                lastChanges.push_back(0);
+            }
+
+            std::uint32_t position = static_cast<std::uint32_t>(parents.size());
+            slots[slot].position = position;
+
+            // Appending keeps the order depth-first only below the last subtree
+            if (parentPosition != NoPosition && subtreeEnds[parentPosition] == position)
+            {
+                for (std::uint32_t ancestor = parentPosition; ancestor != NoPosition; ancestor = parents[ancestor])
+                {
+                    subtreeEnds[ancestor] = position + 1;
+                }
+            }
+            else if (parentPosition != NoPosition)
+            {
+                isUnordered = true;
+            }
+
+            parents.push_back(parentPosition);
+            localTransforms.push_back(local);
+            worldTransforms.push_back(worldTransform);
+            previousTransforms.push_back(worldTransform);
+            dirty.push_back(1);
+            subtreeEnds.push_back(position + 1);
+            referenceCounts.push_back(1);
+            slotIndices.push_back(slot);
+
+            if (parentPosition != NoPosition)
+            {
+                referenceCounts[parentPosition]++;
+            }
+
+            return Node { slot, slots[slot].generation };
+        }
+
+        void TransformHierarchy::acquire(TransformHierarchy::Node node)
+        {
+            referenceCounts[getPosition(node)]++;
+        }
+
+        void TransformHierarchy::release(TransformHierarchy::Node node)
+        {
+            // Releasing a node also releases its reference to the parent
+            std::uint32_t position = getPosition(node);
+            while (position != NoPosition && --referenceCounts[position] == 0)
+            {
+                Slot &slot = slots[slotIndices[position]];
+                slot.position = NoPosition;
+                slot.generation++;
+                freeSlots.push_back(slotIndices[position]);
+
+                hasReleasedNodes = true;
+                position = parents[position];
+            }
+        }
+
+        bool TransformHierarchy::contains(TransformHierarchy::Node node) const
+        {
+            return node.index < slots.size()
+                    && slots[node.index].position != NoPosition
+                    && slots[node.index].generation == node.generation;
+        }
+
+        std::size_t TransformHierarchy::getSize() const
+        {
+            return slots.size() - freeSlots.size();
+        }
+
+        TransformHierarchy::Node TransformHierarchy::getParent(TransformHierarchy::Node node) const
+        {
+            std::uint32_t parentPosition = parents[getPosition(node)];
+            if (parentPosition == NoPosition)
+            {
+                return None;
+            }
+
+            std::uint32_t slot = slotIndices[parentPosition];
+            return Node { slot, slots[slot].generation };
+        }
+
+        void TransformHierarchy::setParent(TransformHierarchy::Node node, TransformHierarchy::Node parent)
+        {
+            std::uint32_t position = getPosition(node);
+            std::uint32_t parentPosition = parent == None ? NoPosition : getPosition(parent);
+
+            for (std::uint32_t ancestor = parentPosition; ancestor != NoPosition; ancestor = parents[ancestor])
+            {
+                if (ancestor == position)
+                {
+                    throw std::invalid_argument("Transform cannot be parented to itself or its descendant");
+                }
+            }
+
+            if (parentPosition != NoPosition)
+            {
+                referenceCounts[parentPosition]++;
+            }
+
+            if (parents[position] != NoPosition)
+            {
+                std::uint32_t slot = slotIndices[parents[position]];
+                release(Node { slot, slots[slot].generation });
+            }
+
+            parents[position] = parentPosition;
+            dirty[position] = 1;
+            isUnordered = true;
+        }
+
+        Eigen::Matrix4f TransformHierarchy::getLocalTransform(TransformHierarchy::Node node) const
+        {
+            return localTransforms[getPosition(node)].toMatrix();
+        }
+
+        void TransformHierarchy::setLocalTransform(TransformHierarchy::Node node, const Eigen::Matrix4f &localTransform)
+        {
+            std::uint32_t position = getPosition(node);
+            localTransforms[position] = Math::AffineTransform::fromMatrix(localTransform);
+            dirty[position] = 1;
+        }
+
+        Eigen::Matrix4f TransformHierarchy::getWorldTransform(TransformHierarchy::Node node) const
+        {
+            return worldTransforms[getPosition(node)].toMatrix();
+        }
+
+        Eigen::Matrix4f TransformHierarchy::computeWorldTransform(TransformHierarchy::Node node) const
+        {
+            return composeWorldTransform(getPosition(node)).toMatrix();
+        }
+
+        Eigen::Matrix4f TransformHierarchy::getPreviousTransform(TransformHierarchy::Node node) const
+        {
+            return previousTransforms[getPosition(node)].toMatrix();
+        }
+
+        void TransformHierarchy::savePreviousTransforms()
+        {
+            std::copy(worldTransforms.begin(), worldTransforms.end(), previousTransforms.begin());
+        }
+
+        void TransformHierarchy::update()
+        {
+            if (hasReleasedNodes || isUnordered)
+            {
+                rebuild();
+            }
+
+            updateCount++;
+
+            // Descendants of a changed node follow it, up to its subtree end
+            std::vector<std::uint8_t>::iterator it = std::find(dirty.begin(), dirty.end(), 1);
+            while (it != dirty.end())
+            {
+                std::size_t first = it - dirty.begin();
+                std::size_t last = subtreeEnds[first];
+
+                Math::propagateTransforms(parents.data(), localTransforms.data(), worldTransforms.data(), first, last);
+                std::fill(it, dirty.begin() + last, 0);
+
+                for (std::size_t position = first; position < last; position++)
+                {
+                    lastChanges[slotIndices[position]] = updateCount;
+                }
+
+                it = std::find(dirty.begin() + last, dirty.end(), 1);
+            }
+        }
+
+        std::uint32_t TransformHierarchy::getUpdateCount() const
+        {
+            return updateCount;
+        }
+
+        std::uint32_t TransformHierarchy::getLastChange(TransformHierarchy::Node node) const
+        {
+            if (!contains(node))
+            {
+                throw std::invalid_argument("Transform node does not exist");
+            }
+
+            return lastChanges[node.index];
+        }
+
+        std::uint32_t TransformHierarchy::getPosition(TransformHierarchy::Node node) const
+        {
+            if (!contains(node))
+            {
+                throw std::invalid_argument("Transform node does not exist");
+            }
+
+            return slots[node.index].position;
+        }
+
+        void TransformHierarchy::rebuild()
+        {
+            std::vector<std::uint32_t> order;
+            order.reserve(getSize());
+            for (std::uint32_t i = 0; i < parents.size(); i++)
+            {
+                if (referenceCounts[i] > 0)
+                {
+                    order.push_back(i);
+                }
+            }
+
+            // Filtering keeps the order valid, reparenting requires a new traversal
+            if (isUnordered)
+            {
+                std::vector<std::uint32_t> firstChildren(parents.size(), NoPosition);
+                std::vector<std::uint32_t> nextSiblings(parents.size(), NoPosition);
+                std::vector<std::uint32_t> roots;
+
+                for (auto it = order.rbegin(); it != order.rend(); ++it)
+                {
+                    if (parents[*it] == NoPosition)
+                    {
+                        roots.push_back(*it);
+                    }
+                    else
+                    {
+                        nextSiblings[*it] = firstChildren[parents[*it]];
+                        firstChildren[parents[*it]] = *it;
+                    }
+                }
+
+                order.clear();
+
+                std::vector<std::uint32_t> stack;
+                for (auto it = roots.rbegin(); it != roots.rend(); ++it)
+                {
+                    stack.push_back(*it);
+                    while (!stack.empty())
+                    {
+                        std::uint32_t node = stack.back();
+                        stack.pop_back();
+                        order.push_back(node);
+
+                        // Siblings are pushed last to first to be visited in order
+                        std::size_t siblingsStart = stack.size();
+                        for (std::uint32_t child = firstChildren[node]; child != NoPosition; child = nextSiblings[child])
+                        {
+                            stack.push_back(child);
+                        }
+                        std::reverse(stack.begin() + siblingsStart, stack.end());
+                    }
+                }
+            }
+
+            std::vector<std::uint32_t> newPositions(parents.size(), NoPosition);
+            for (std::uint32_t i = 0; i < order.size(); i++)
+            {
+                newPositions[order[i]] = i;
+            }
+
+            std::vector<std::uint32_t> newParents;
+            TransformArray newLocalTransforms, newWorldTransforms, newPreviousTransforms;
+            std::vector<std::uint8_t> newDirty;
+            std::vector<std::uint32_t> newReferenceCounts, newSlotIndices, newSubtreeEnds;
+
+            newParents.reserve(order.size());
+            newLocalTransforms.reserve(order.size());
+            newWorldTransforms.reserve(order.size());
+            newPreviousTransforms.reserve(order.size());
+            newDirty.reserve(order.size());
+            newReferenceCounts.reserve(order.size());
+            newSlotIndices.reserve(order.size());
+            newSubtreeEnds.reserve(order.size());
+
+            for (std::uint32_t i : order)
+            {
+                newParents.push_back(parents[i] != NoPosition ? newPositions[parents[i]] : NoPosition);
+                newLocalTransforms.push_back(localTransforms[i]);
+                newWorldTransforms.push_back(worldTransforms[i]);
+                newPreviousTransforms.push_back(previousTransforms[i]);
+                newDirty.push_back(dirty[i]);
+                newReferenceCounts.push_back(referenceCounts[i]);
+                newSlotIndices.push_back(slotIndices[i]);
+                newSubtreeEnds.push_back(newPositions[i] + 1);
+
+                slots[slotIndices[i]].position = newPositions[i];
+            }
+
+            parents.swap(newParents);
+            localTransforms.swap(newLocalTransforms);
+            worldTransforms.swap(newWorldTransforms);
+            previousTransforms.swap(newPreviousTransforms);
+            dirty.swap(newDirty);
+            referenceCounts.swap(newReferenceCounts);
+            slotIndices.swap(newSlotIndices);
+            subtreeEnds.swap(newSubtreeEnds);
+
+            // Children extend their ancestors' subtrees, visited last to first
+            for (std::size_t i = parents.size(); i-- > 0;)
+            {
+                if (parents[i] != NoPosition)
+                {
+                    subtreeEnds[parents[i]] = std::max(subtreeEnds[parents[i]], subtreeEnds[i]);
+                }
+            }
+
+            hasReleasedNodes = false;
+            isUnordered = false;
+        }
+
+        Math::AffineTransform TransformHierarchy::composeWorldTransform(std::uint32_t position) const
+        {
+            Math::AffineTransform worldTransform = localTransforms[position];
+            for (std::uint32_t ancestor = parents[position]; ancestor != NoPosition; ancestor = parents[ancestor])
+            {
+                Math::multiply(localTransforms[ancestor], worldTransform, worldTransform);
+            }
+
+            return worldTransform;
+        }
+
+        bool operator ==(const TransformHierarchy::Node &lhs, const TransformHierarchy::Node &rhs)
+        {
+            return lhs.index == rhs.index && lhs.generation == rhs.generation;
+        }
+
+        bool operator !=(const TransformHierarchy::Node &lhs, const TransformHierarchy::Node &rhs)
+        {
+            return !(lhs == rhs);
+        }
+    }
+}
@@ -0,0 +1,122 @@
+#ifndef TRANSFORMHIERARCHY_H
+#define TRANSFORMHIERARCHY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "Amber/Math/AffineTransform.h"
+
+namespace Amber
+{
+    namespace Core
+    {
+        // Local and world transforms of every transform node of a world, stored
+        // as 3x4 affine matrices in flat arrays in depth-first order, so that
+        // every subtree is a contiguous range. update() skips over clean ranges
+        // and recomputes the subtrees of changed nodes without further checks.
+        //
+        // Nodes are reference counted and every node holds a reference to its
+        // parent, so a parent lives as long as any of its descendants. Nodes may
+        // be read and their local transforms set concurrently, but creating,
+        // releasing, reparenting and updating must happen at sync points.
+        class TransformHierarchy
+        {
+            public:
+                struct Node
+                {
+                    std::uint32_t index;
+                    std::uint32_t generation;
+                };
+
+                static const Node None;
+
+                TransformHierarchy();
+                TransformHierarchy(const TransformHierarchy &other) = delete;
+                ~TransformHierarchy() = default;
+
+                TransformHierarchy &operator =(const TransformHierarchy &other) = delete;
+
+                // Returns a node holding one reference
+                Node create(const Eigen::Matrix4f &localTransform, Node parent = None);
+
+                void acquire(Node node);
+                void release(Node node);
+
+                bool contains(Node node) const;
+                std::size_t getSize() const;
+
+                Node getParent(Node node) const;
+
+                // Keeps the local transform, so the world transform will change
+                void setParent(Node node, Node parent);
+
+                Eigen::Matrix4f getLocalTransform(Node node) const;
+                void setLocalTransform(Node node, const Eigen::Matrix4f &localTransform);
+
+                // As of the last update(), or of creation for newer nodes
+                Eigen::Matrix4f getWorldTransform(Node node) const;
+
+                // Composes the local transforms up to the root, regardless of updates
+                Eigen::Matrix4f computeWorldTransform(Node node) const;
+
+                // As of the last savePreviousTransforms()
+                Eigen::Matrix4f getPreviousTransform(Node node) const;
+                void savePreviousTransforms();
+
+                void update();
+
+                // Number of update() calls so far, and the call that last changed
+                // the node's world transform. Newly created nodes change in the
+                // next update().
+                std::uint32_t getUpdateCount() const;
+                std::uint32_t getLastChange(Node node) const;
+
+            private:
+                typedef std::vector<Math::AffineTransform> TransformArray;
+
+                static constexpr std::uint32_t NoPosition = Math::NoParent;
+
+                struct Slot
+                {
+                    std::uint32_t position;
+                    std::uint32_t generation;
+                };
+
+                std::uint32_t getPosition(Node node) const;
+
+                // Drops released nodes and, when needed, restores depth-first order
+                // after reparenting or creating nodes out of order
+                void rebuild();
+
+                Math::AffineTransform composeWorldTransform(std::uint32_t position) const;
+
+                // Indexed by position in hierarchy order
+                std::vector<std::uint32_t> parents;
+                TransformArray localTransforms;
+                TransformArray worldTransforms;
+                TransformArray previousTransforms;
+                std::vector<std::uint8_t> dirty;
+                std::vector<std::uint32_t> subtreeEnds;
+                std::vector<std::uint32_t> referenceCounts;
+                std::vector<std::uint32_t> slotIndices;
+
+                std::vector<Slot> slots;
+                std::vector<std::uint32_t> freeSlots;
+
+                // Indexed by slot, so they survive rebuilds
+                std::vector<std::uint32_t> lastChanges;
+                std::uint32_t updateCount;
+
+                bool hasReleasedNodes;
+                bool isUnordered;
+        };
+
+        bool operator ==(const TransformHierarchy::Node &lhs, const TransformHierarchy::Node &rhs);
+        bool operator !=(const TransformHierarchy::Node &lhs, const TransformHierarchy::Node &rhs);
+    }
+}
+
+#endif // TRANSFORMHIERARCHY_H
@@ -7,14 +7,26 @@ namespace Amber
 {
     namespace Core
     {
-        World::World(std::vector<Entity> entities)
-            : entities(std::move(entities))
+        World::World()
+            : transforms(new TransformHierarchy()),
+              storage(new ArchetypeStorage()),
+              entityCount(0),
+              commands(new EntityCommandQueue()),
+              events(new EventBus())
         {
         }
 
-
         World::World(World &&other) noexcept
-            : entities(std::move(other.entities))
+            : transforms(std::move(other.transforms)),
+              storage(std::move(other.storage)),
+              entityCount(other.entityCount),
+              commands(std::move(other.commands)),
+              events(std::move(other.events))
+        {
+            other.entityCount = 0;
+        }
+
+        World::~World()
         {
         }
 
@@ -22,20 +34,141 @@ namespace Amber
         {
             if (this != &other)
             {
-                entities = std::move(other.entities);
+                // Components of the old world, including those still waiting in its
+                // command queue, release their transforms before the hierarchy goes
+                commands = std::move(other.commands);
+                storage = std::move(other.storage);
+                transforms = std::move(other.transforms);
+                entityCount = other.entityCount;
+                events = std::move(other.events);
+
+                other.entityCount = 0;
             }
 
             return *this;
         }
 
-        std::vector<Entity> &World::getEntities()
+        Entity World::create()
         {
-            return entities;
+            Entity entity(storage.get(), storage->create());
+            entityCount++;
+
+            return entity;
+        }
+
+        bool World::destroy(Entity entity)
+        {
+            return entity.storage == storage.get() && destroyEntity(entity.id);
+        }
+
+        EntityCommandBuffer &World::getCommandBuffer()
+        {
+            return commands->getBuffer();
+        }
+
+        void World::playbackCommands()
+        {
+            commands->playback(*this);
+        }
+
+        std::uint32_t World::getChangeVersion() const
+        {
+            return storage->getChangeVersion();
+        }
+
+        void World::advanceChangeVersion()
+        {
+            storage->advanceChangeVersion();
+        }
+
+        EventBus &World::getEventBus()
+        {
+            return *events;
+        }
+
+        TransformHierarchy &World::getTransformHierarchy()
+        {
+            return *transforms;
+        }
+
+        std::size_t World::getEntityCount() const
+        {
+            return entityCount;
         }
 
-        const std::vector<Entity> &World::getEntities() const
+        std::vector<Entity> World::getEntities()
         {
+            std::vector<Entity> entities;
+            entities.reserve(entityCount);
+
+            for (const std::unique_ptr<Archetype> &archetype : storage->getArchetypes())
+            {
+                for (std::size_t row = 0; row < archetype->getSize(); row++)
+                {
+                    entities.push_back(Entity(storage.get(), storage->getEntityId(archetype->getEntity(row))));
+                }
+            }
+
             return entities;
         }
+
+        bool World::destroyEntity(EntityId entity)
+        {
+            if (!storage->destroy(entity))
+            {
+                return false;
+            }
+
+            entityCount--;
+
+            return true;
+        }
+
+        void World::collectChanges(EntityChanges &changes)
+        {
+            changes.clear();
+
+            const ArchetypeStorage::ChangeLog &log = storage->getChanges();
+            auto convert = [this] (const std::vector<EntityId> &ids, std::vector<Entity> &entities) {
+                entities.reserve(ids.size());
+                for (EntityId id : ids)
+                {
+                    entities.push_back(Entity(storage.get(), id));
+                }
+            };
+
+            convert(log.created, changes.created);
+            convert(log.destroyed, changes.destroyed);
+            for (ComponentTypeId typeId = 0; typeId < MaxComponentTypes; typeId++)
+            {
+                convert(log.added[typeId], changes.added[typeId]);
+                convert(log.removed[typeId], changes.removed[typeId]);
+                convert(log.changed[typeId], changes.changed[typeId]);
+            }
+
+            storage->clearChanges();
+        }
+
+        void World::collectEntities(EntityChanges &changes)
+        {
+            changes.clear();
+            storage->clearChanges();
+
+            for (const std::unique_ptr<Archetype> &archetype : storage->getArchetypes())
+            {
+                const std::vector<const ComponentInfo *> &components = archetype->getComponents();
+
+                for (std::size_t row = 0; row < archetype->getSize(); row++)
+                {
+                    Entity entity(storage.get(), storage->getEntityId(archetype->getEntity(row)));
+
+                    changes.created.push_back(entity);
+                    for (const ComponentInfo *component : components)
+                    {
+                        changes.added[component->typeId].push_back(entity);
+                    }
+                }
+            }
+        }
     }
 }
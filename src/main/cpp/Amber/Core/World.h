@@ -1,10 +1,18 @@
 #ifndef WORLD_H
 #define WORLD_H
 
+#include <cstdint>
 #include <memory>
 #include <vector>
 
+#include "Amber/Core/ArchetypeStorage.h"
 #include "Amber/Core/Entity.h"
+#include "Amber/Core/EntityChanges.h"
+#include "Amber/Core/EntityCommandBuffer.h"
+#include "Amber/Core/EntityCommandQueue.h"
+#include "Amber/Core/EventBus.h"
+#include "Amber/Core/Query.h"
+#include "Amber/Core/TransformHierarchy.h"
 
 namespace Amber
 {
@@ -13,22 +21,68 @@ namespace Amber
         class World
         {
             public:
-                World() = default;
-                World(std::vector<Entity> entities);
+                World();
                 World(const World &other) = delete;
                 World(World &&other) noexcept;
-                ~World() = default;
+                ~World();
 
                 World &operator =(const World &other) = delete;
                 World &operator =(World &&other) noexcept;
 
-                std::vector<Entity> &getEntities();
-                const std::vector<Entity> &getEntities() const;
+                Entity create();
+                bool destroy(Entity entity);
+
+                // For structural changes while systems run in parallel, applied by
+                // playbackCommands() at the end of each tick
+                EntityCommandBuffer &getCommandBuffer();
+                void playbackCommands();
+
+                // Events between systems, dispatched by the game right before the
+                // commands are played back
+                EventBus &getEventBus();
+
+                template <typename... Ts>
+                Query<Ts...> query()
+                {
+                    return Query<Ts...>(*storage);
+                }
+
+                // Version that writes to components are currently stamped with.
+                // Queries filtered with changedSince() on a version remembered
+                // earlier see every write made at or after it, including the
+                // caller's own.
+                std::uint32_t getChangeVersion() const;
+
+                // Called by the game at sync points, after each schedule and its
+                // command playback
+                void advanceChangeVersion();
+
+                // Local and world matrices of the world's Transform components
+                TransformHierarchy &getTransformHierarchy();
+
+                std::size_t getEntityCount() const;
+                std::vector<Entity> getEntities();
+
+                // Moves the changes made since the last call into changes
+                void collectChanges(EntityChanges &changes);
+
+                // Describes the whole world as a set of changes, as if every entity
+                // and component had just been created
+                void collectEntities(EntityChanges &changes);
 
             private:
-                friend class Game;
+                friend class EntityCommandQueue;
+
+                bool destroyEntity(EntityId entity);
 
-                std::vector<Entity> entities;
+                // Kept on the heap so that entity handles and transforms survive the
+                // world being moved. Transforms must outlive the components of the storage
+                // and of the pending commands.
+                std::unique_ptr<TransformHierarchy> transforms;
+                std::unique_ptr<ArchetypeStorage> storage;
+                std::size_t entityCount;
+                std::unique_ptr<EntityCommandQueue> commands;
+                std::unique_ptr<EventBus> events;
         };
     }
 }
@@ -0,0 +1,136 @@
+#ifndef AMBERMODELFORMAT_H
+#define AMBERMODELFORMAT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace Amber
+{
+    namespace IO
+    {
+        // Layout of binary world snapshots written by AmberModelWriter. The file
+        // starts with a Header whose tables point at arrays of the records below;
+        // mesh and texture payloads follow. Records are plain data in native byte
+        // order and read in place from the mapped file, offsets of tables and
+        // payloads are multiples of Alignment.
+        namespace AmberModelFormat
+        {
+            const char Magic[8] = { 'A', 'M', 'B', 'E', 'R', 'W', 'L', 'D' };
+            const std::uint32_t Version = 2;
+            const std::uint32_t ByteOrderMark = 0x01020304;
+            const std::uint32_t None = 0xffffffff;
+            const std::size_t Alignment = 16;
+            const std::size_t MaxAttributeNameLength = 31;
+
+            struct Table
+            {
+                std::uint64_t offset;
+                std::uint64_t count;
+            };
+
+            struct Payload
+            {
+                std::uint64_t offset;
+                std::uint64_t size;
+            };
+
+            struct Header
+            {
+                char magic[8];
+                std::uint32_t version;
+                std::uint32_t byteOrderMark;
+
+                Table nodes;
+                Table textures;
+                Table attributes;
+                Table meshes;
+                Table materials;
+                Table lights;
+                Table entities;
+            };
+
+            // Parents come before their children
+            struct Node
+            {
+                std::uint32_t parent;
+                std::uint32_t reserved[3];
+                float localTransform[3][4];
+            };
+
+            struct Texture
+            {
+                std::uint32_t type;
+                std::uint32_t dataFormat;
+                std::uint32_t width;
+                std::uint32_t height;
+                std::uint32_t depth;
+                std::uint32_t reserved;
+                Payload image;
+            };
+
+            struct Attribute
+            {
+                char name[MaxAttributeNameLength + 1];
+                std::uint32_t type;
+                std::uint32_t count;
+            };
+
+            struct Mesh
+            {
+                std::uint64_t vertexCount;
+                std::uint64_t primitiveCount;
+                std::uint32_t firstAttribute;
+                std::uint32_t attributeCount;
+                Payload vertices;
+                Payload indices;
+
+                // Model space bounds, stored as min and max corners and as
+                // center and radius. Empty bounds keep their empty values.
+                float boundingBox[2][3];
+                float boundingSphere[4];
+            };
+
+            // Texture indices may be None
+            struct Material
+            {
+                float emission;
+                float translucency;
+                float reflectivity;
+                float indexOfRefraction;
+                float diffuseColor[4];
+                std::uint32_t diffuseTexture;
+                std::uint32_t normalMap;
+                std::uint32_t specularMap;
+                std::uint32_t displacementMap;
+            };
+
+            struct Light
+            {
+                std::uint32_t type;
+                float attenuationCoefficients[3];
+                float color[4];
+            };
+
+            // Each index is None if the entity lacks that component
+            struct Entity
+            {
+                std::uint32_t node;
+                std::uint32_t mesh;
+                std::uint32_t material;
+                std::uint32_t light;
+            };
+
+            static_assert(std::is_trivially_copyable<Header>::value, "Records must be plain data");
+            static_assert(std::is_trivially_copyable<Node>::value, "Records must be plain data");
+            static_assert(std::is_trivially_copyable<Texture>::value, "Records must be plain data");
+            static_assert(std::is_trivially_copyable<Attribute>::value, "Records must be plain data");
+            static_assert(std::is_trivially_copyable<Mesh>::value, "Records must be plain data");
+            static_assert(std::is_trivially_copyable<Material>::value, "Records must be plain data");
+            static_assert(std::is_trivially_copyable<Light>::value, "Records must be plain data");
+            static_assert(std::is_trivially_copyable<Entity>::value, "Records must be plain data");
+        }
+    }
+}
+
+#endif // AMBERMODELFORMAT_H
@@ -1,12 +1,273 @@
 #include "AmberModelLoader.h"
 
+#include <cstring>
+#include <stdexcept>
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include "Amber/Core/Transform.h"
+#include "Amber/IO/AmberModelFormat.h"
+#include "Amber/Math/AffineTransform.h"
+#include "Amber/Rendering/Light.h"
+#include "Amber/Rendering/Material.h"
+#include "Amber/Rendering/Mesh.h"
+#include "Amber/Rendering/Backend/IBuffer.h"
+#include "Amber/Rendering/Backend/IContext.h"
+#include "Amber/Rendering/Backend/ITexture.h"
+
 namespace Amber
 {
     namespace IO
     {
-        std::vector<Core::Entity> AmberModelLoader::loadModel(const std::string &fileName)
+        namespace
+        {
+            using namespace AmberModelFormat;
+
+            class MappedSnapshot
+            {
+                public:
+                    MappedSnapshot(const char *data, std::size_t size)
+                        : data(data),
+                          size(size)
+                    {
+                        if (size < sizeof(Header))
+                        {
+                            throw std::runtime_error("Snapshot is truncated");
+                        }
+
+                        header = reinterpret_cast<const Header *>(data);
+                        if (std::memcmp(header->magic, Magic, sizeof(Magic)) != 0)
+                        {
+                            throw std::runtime_error("Not an Amber snapshot");
+                        }
+
+                        if (header->byteOrderMark != ByteOrderMark)
+                        {
+                            throw std::runtime_error("Snapshot was written with a different byte order");
+                        }
+
+                        if (header->version != Version)
+                        {
+                            throw std::runtime_error("Unsupported snapshot version " + std::to_string(header->version));
+                        }
+                    }
+
+                    const Header &getHeader() const
+                    {
+                        return *header;
+                    }
+
+                    template <typename T>
+                    const T *getTable(const Table &table) const
+                    {
+                        // Dividing rather than multiplying, a corrupt count must not wrap around
+                        check(table.offset, 0);
+                        if (table.count > (size - table.offset) / sizeof(T))
+                        {
+                            throw std::runtime_error("Snapshot is corrupt");
+                        }
+
+                        return reinterpret_cast<const T *>(data + table.offset);
+                    }
+
+                    const void *getPayload(const Payload &payload) const
+                    {
+                        check(payload.offset, payload.size);
+                        return data + payload.offset;
+                    }
+
+                private:
+                    void check(std::uint64_t offset, std::uint64_t length) const
+                    {
+                        if (offset % Alignment != 0 || offset > size || length > size - offset)
+                        {
+                            throw std::runtime_error("Snapshot is corrupt");
+                        }
+                    }
+
+                    const char *data;
+                    std::size_t size;
+                    const Header *header;
+            };
+
+            std::uint32_t checkIndex(std::uint32_t index, std::uint64_t count)
+            {
+                if (index != None && index >= count)
+                {
+                    throw std::runtime_error("Snapshot is corrupt");
+                }
+
+                return index;
+            }
+        }
+
+        std::vector<Core::Entity> AmberModelLoader::loadModel(const std::string &fileName, Core::World &world)
         {
-            return std::vector<Core::Entity>();
+            using namespace boost::interprocess;
+
+            file_mapping file(fileName.c_str(), read_only);
+            mapped_region region(file, read_only);
+            MappedSnapshot snapshot(static_cast<const char *>(region.get_address()), region.get_size());
+
+            const Header &header = snapshot.getHeader();
+            Rendering::IContext *context = Rendering::IContext::getActiveContext();
+
+            const AmberModelFormat::Texture *textureRecords = snapshot.getTable<AmberModelFormat::Texture>(header.textures);
+            std::vector<Rendering::Reference<Rendering::ITexture>> textures(header.textures.count);
+            for (std::size_t i = 0; context != nullptr && i < textures.size(); i++)
+            {
+                const AmberModelFormat::Texture &record = textureRecords[i];
+
+                Rendering::Reference<Rendering::ITexture> texture = context->createTexture(static_cast<Rendering::ITexture::Type>(record.type),
+                                                                                           static_cast<Rendering::ITexture::DataFormat>(record.dataFormat));
+                texture->setSize(record.width, record.height, record.depth);
+                if (record.image.size < texture->getImageDataSize())
+                {
+                    throw std::runtime_error("Snapshot is corrupt");
+                }
+
+                texture->setImageData(static_cast<const std::uint8_t *>(snapshot.getPayload(record.image)));
+                textures[i] = texture;
+            }
+
+            auto getTexture = [&textures] (std::uint32_t index) {
+                return checkIndex(index, textures.size()) != None ? textures[index] : Rendering::Reference<Rendering::ITexture>();
+            };
+
+            // Buffers and layouts are shared by the entities using the same mesh
+            struct SharedMesh
+            {
+                Rendering::Reference<Rendering::IBuffer> vertexBuffer;
+                Rendering::Reference<Rendering::IBuffer> indexBuffer;
+                Rendering::Layout layout;
+            };
+
+            auto upload = [context, &snapshot] (Rendering::IBuffer::Type type, const Payload &payload) {
+                Rendering::Reference<Rendering::IBuffer> buffer;
+                if (context != nullptr)
+                {
+                    buffer = context->createHardwareBuffer(type);
+                    if (payload.size > 0)
+                    {
+                        buffer->resize(payload.size);
+                        buffer->assign(0, payload.size, snapshot.getPayload(payload));
+                    }
+                }
+
+                return buffer;
+            };
+
+            const AmberModelFormat::Attribute *attributes = snapshot.getTable<AmberModelFormat::Attribute>(header.attributes);
+            const AmberModelFormat::Mesh *meshRecords = snapshot.getTable<AmberModelFormat::Mesh>(header.meshes);
+
+            std::vector<SharedMesh> meshes(header.meshes.count);
+            for (std::size_t i = 0; i < meshes.size(); i++)
+            {
+                const AmberModelFormat::Mesh &record = meshRecords[i];
+                if (std::uint64_t(record.firstAttribute) + record.attributeCount > header.attributes.count)
+                {
+                    throw std::runtime_error("Snapshot is corrupt");
+                }
+
+                for (std::uint32_t j = record.firstAttribute; j < record.firstAttribute + record.attributeCount; j++)
+                {
+                    const AmberModelFormat::Attribute &attribute = attributes[j];
+                    std::string name(attribute.name, strnlen(attribute.name, sizeof(attribute.name)));
+                    meshes[i].layout.insertAttribute(Rendering::Layout::Attribute(name, static_cast<Rendering::Layout::ComponentType>(attribute.type), attribute.count));
+                }
+
+                meshes[i].vertexBuffer = upload(Rendering::IBuffer::Type::Vertex, record.vertices);
+                meshes[i].indexBuffer = upload(Rendering::IBuffer::Type::Index, record.indices);
+            }
+
+            std::vector<Core::Transform> nodes;
+            nodes.reserve(header.nodes.count);
+
+            const AmberModelFormat::Node *nodeRecords = snapshot.getTable<AmberModelFormat::Node>(header.nodes);
+            for (std::size_t i = 0; i < header.nodes.count; i++)
+            {
+                const AmberModelFormat::Node &record = nodeRecords[i];
+
+                Math::AffineTransform localTransform;
+                std::memcpy(localTransform.rows, record.localTransform, sizeof(localTransform.rows));
+
+                if (checkIndex(record.parent, i) == None)
+                {
+                    nodes.emplace_back(localTransform.toMatrix(), world.getTransformHierarchy());
+                }
+                else
+                {
+                    nodes.emplace_back(localTransform.toMatrix(), nodes[record.parent]);
+                }
+            }
+
+            const AmberModelFormat::Material *materials = snapshot.getTable<AmberModelFormat::Material>(header.materials);
+            const AmberModelFormat::Light *lights = snapshot.getTable<AmberModelFormat::Light>(header.lights);
+            const AmberModelFormat::Entity *entityRecords = snapshot.getTable<AmberModelFormat::Entity>(header.entities);
+
+            std::vector<Core::Entity> entities;
+            entities.reserve(header.entities.count);
+
+            for (std::size_t i = 0; i < header.entities.count; i++)
+            {
+                const AmberModelFormat::Entity &record = entityRecords[i];
+                Core::Entity entity = world.create();
+
+                if (checkIndex(record.node, nodes.size()) != None)
+                {
+                    entity.emplaceComponent<Core::Transform>(nodes[record.node]);
+                }
+
+                if (checkIndex(record.mesh, meshes.size()) != None)
+                {
+                    const AmberModelFormat::Mesh &meshRecord = meshRecords[record.mesh];
+
+                    Rendering::Mesh *mesh = entity.emplaceComponent<Rendering::Mesh>();
+                    mesh->getVertexBuffer() = meshes[record.mesh].vertexBuffer;
+                    mesh->getIndexBuffer() = meshes[record.mesh].indexBuffer;
+                    mesh->setLayout(meshes[record.mesh].layout);
+                    mesh->setVertexCount(meshRecord.vertexCount);
+                    mesh->setPrimitiveCount(meshRecord.primitiveCount);
+                    mesh->setBoundingBox(Math::BoundingBox {
+                        Eigen::Map<const Eigen::Vector3f>(meshRecord.boundingBox[0]),
+                        Eigen::Map<const Eigen::Vector3f>(meshRecord.boundingBox[1])
+                    });
+                    mesh->setBoundingSphere(Math::BoundingSphere {
+                        Eigen::Map<const Eigen::Vector3f>(meshRecord.boundingSphere),
+                        meshRecord.boundingSphere[3]
+                    });
+                }
+
+                if (checkIndex(record.material, header.materials.count) != None)
+                {
+                    const AmberModelFormat::Material &materialRecord = materials[record.material];
+
+                    Rendering::Material *material = entity.emplaceComponent<Rendering::Material>();
+                    material->setEmission(materialRecord.emission);
+                    material->setTranslucency(materialRecord.translucency);
+                    material->setReflectivity(materialRecord.reflectivity);
+                    material->setIndexOfRefraction(materialRecord.indexOfRefraction);
+                    material->setDiffuseColor(Eigen::Map<const Eigen::Vector4f>(materialRecord.diffuseColor));
+                    material->setDiffuseTexture(getTexture(materialRecord.diffuseTexture));
+                    material->setNormalMap(getTexture(materialRecord.normalMap));
+                    material->setSpecularMap(getTexture(materialRecord.specularMap));
+                    material->setDisplacementMap(getTexture(materialRecord.displacementMap));
+                }
+
+                if (checkIndex(record.light, header.lights.count) != None)
+                {
+                    const AmberModelFormat::Light &lightRecord = lights[record.light];
+
+                    Rendering::Light *light = entity.emplaceComponent<Rendering::Light>(static_cast<Rendering::Light::Type>(lightRecord.type));
+                    light->setAttenuationCoefficients(Eigen::Map<const Eigen::Vector3f>(lightRecord.attenuationCoefficients));
+                    light->setColor(Eigen::Map<const Eigen::Vector4f>(lightRecord.color));
+                }
+
+                entities.push_back(entity);
+            }
+
+            return entities;
         }
     }
 }
@@ -11,12 +11,16 @@ namespace Amber
 {
     namespace IO
     {
+        // Loads snapshots written by AmberModelWriter. The file is memory mapped
+        // and its records used in place; mesh and texture contents are uploaded
+        // straight from the mapping when a rendering context is active, otherwise
+        // meshes are created without buffers and materials without textures.
         class AmberModelLoader : public IModelLoader
         {
             public:
                 AmberModelLoader() = default;
 
-                virtual std::vector<Core::Entity> loadModel(const std::string &fileName);
+                virtual std::vector<Core::Entity> loadModel(const std::string &fileName, Core::World &world);
         };
     }
 }
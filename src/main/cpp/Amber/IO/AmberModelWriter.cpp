@@ -0,0 +1,346 @@
+#include "AmberModelWriter.h"
+
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <stdexcept>
+#include <unordered_map>
+
+#include "Amber/Core/Transform.h"
+#include "Amber/Core/TransformHierarchy.h"
+#include "Amber/IO/AmberModelFormat.h"
+#include "Amber/Math/AffineTransform.h"
+#include "Amber/Rendering/Light.h"
+#include "Amber/Rendering/Material.h"
+#include "Amber/Rendering/Mesh.h"
+#include "Amber/Rendering/Backend/IBuffer.h"
+#include "Amber/Rendering/Backend/ITexture.h"
+
+namespace Amber
+{
+    namespace IO
+    {
+        namespace
+        {
+            using namespace AmberModelFormat;
+
+            std::uint64_t align(std::uint64_t offset)
+            {
+                return (offset + Alignment - 1) / Alignment * Alignment;
+            }
+
+            class SnapshotBuilder
+            {
+                public:
+                    explicit SnapshotBuilder(Core::TransformHierarchy *hierarchy)
+                        : hierarchy(hierarchy)
+                    {
+                    }
+
+                    void addEntity(Core::Entity entity)
+                    {
+                        AmberModelFormat::Entity record = { None, None, None, None };
+
+                        if (const Core::Transform *transform = entity.getComponent<Core::Transform>())
+                        {
+                            record.node = addNode(transform->getNode());
+                        }
+
+                        if (Rendering::Mesh *mesh = entity.getComponent<Rendering::Mesh>())
+                        {
+                            record.mesh = addMesh(*mesh);
+                        }
+
+                        if (const Rendering::Material *material = entity.getComponent<Rendering::Material>())
+                        {
+                            record.material = addMaterial(*material);
+                        }
+
+                        if (const Rendering::Light *light = entity.getComponent<Rendering::Light>())
+                        {
+                            record.light = addLight(*light);
+                        }
+
+                        entities.push_back(record);
+                    }
+
+                    void write(std::ostream &stream)
+                    {
+                        Header header;
+                        std::memcpy(header.magic, Magic, sizeof(Magic));
+                        header.version = Version;
+                        header.byteOrderMark = ByteOrderMark;
+
+                        std::uint64_t offset = align(sizeof(Header));
+                        auto place = [&offset] (Table &table, std::size_t count, std::size_t recordSize) {
+                            table.offset = offset;
+                            table.count = count;
+                            offset = align(offset + count * recordSize);
+                        };
+
+                        place(header.nodes, nodes.size(), sizeof(Node));
+                        place(header.textures, textures.size(), sizeof(Texture));
+                        place(header.attributes, attributes.size(), sizeof(Attribute));
+                        place(header.meshes, meshes.size(), sizeof(Mesh));
+                        place(header.materials, materials.size(), sizeof(Material));
+                        place(header.lights, lights.size(), sizeof(Light));
+                        place(header.entities, entities.size(), sizeof(AmberModelFormat::Entity));
+
+                        // Payload offsets were recorded relative to the payload section
+                        for (Texture &texture : textures)
+                        {
+                            texture.image.offset += offset;
+                        }
+
+                        for (Mesh &mesh : meshes)
+                        {
+                            mesh.vertices.offset += offset;
+                            mesh.indices.offset += offset;
+                        }
+
+                        std::uint64_t position = 0;
+                        auto pad = [&stream, &position] (std::uint64_t target) {
+                            static const char zeros[Alignment] = {};
+                            stream.write(zeros, static_cast<std::streamsize>(target - position));
+                            position = target;
+                        };
+                        auto writeTable = [&stream, &position, &pad] (const Table &table, const void *data, std::size_t recordSize) {
+                            pad(table.offset);
+                            stream.write(static_cast<const char *>(data), static_cast<std::streamsize>(table.count * recordSize));
+                            position += table.count * recordSize;
+                        };
+
+                        stream.write(reinterpret_cast<const char *>(&header), sizeof(Header));
+                        position = sizeof(Header);
+
+                        writeTable(header.nodes, nodes.data(), sizeof(Node));
+                        writeTable(header.textures, textures.data(), sizeof(Texture));
+                        writeTable(header.attributes, attributes.data(), sizeof(Attribute));
+                        writeTable(header.meshes, meshes.data(), sizeof(Mesh));
+                        writeTable(header.materials, materials.data(), sizeof(Material));
+                        writeTable(header.lights, lights.data(), sizeof(Light));
+                        writeTable(header.entities, entities.data(), sizeof(AmberModelFormat::Entity));
+
+                        pad(offset);
+                        stream.write(reinterpret_cast<const char *>(payloads.data()), static_cast<std::streamsize>(payloads.size()));
+                    }
+
+                private:
+                    static std::uint64_t getKey(Core::TransformHierarchy::Node node)
+                    {
+                        return (static_cast<std::uint64_t>(node.generation) << 32) | node.index;
+                    }
+
+                    std::uint32_t addNode(Core::TransformHierarchy::Node node)
+                    {
+                        auto it = nodeIndices.find(getKey(node));
+                        if (it != nodeIndices.end())
+                        {
+                            return it->second;
+                        }
+
+                        Core::TransformHierarchy::Node parent = hierarchy->getParent(node);
+
+                        Node record;
+                        record.parent = parent != Core::TransformHierarchy::None ? addNode(parent) : None;
+                        std::memset(record.reserved, 0, sizeof(record.reserved));
+
+                        Math::AffineTransform localTransform = Math::AffineTransform::fromMatrix(hierarchy->getLocalTransform(node));
+                        std::memcpy(record.localTransform, localTransform.rows, sizeof(record.localTransform));
+
+                        std::uint32_t index = static_cast<std::uint32_t>(nodes.size());
+                        nodes.push_back(record);
+                        nodeIndices.emplace(getKey(node), index);
+
+                        return index;
+                    }
+
+                    std::uint32_t addTexture(const Rendering::Reference<Rendering::ITexture> &texture)
+                    {
+                        if (!texture.isValid())
+                        {
+                            return None;
+                        }
+
+                        auto it = textureIndices.find(texture.get());
+                        if (it != textureIndices.end())
+                        {
+                            return it->second;
+                        }
+
+                        Texture record;
+                        record.type = static_cast<std::uint32_t>(texture->getType());
+                        record.dataFormat = static_cast<std::uint32_t>(texture->getDataFormat());
+                        record.width = static_cast<std::uint32_t>(texture->getWidth());
+                        record.height = static_cast<std::uint32_t>(texture->getHeight());
+                        record.depth = static_cast<std::uint32_t>(texture->getDepth());
+                        record.reserved = 0;
+                        record.image = addPayload(texture->getImageDataSize(), [&texture] (std::uint8_t *data) {
+                            texture.get()->getImageData(data);
+                        });
+
+                        std::uint32_t index = static_cast<std::uint32_t>(textures.size());
+                        textures.push_back(record);
+                        textureIndices.emplace(texture.get(), index);
+
+                        return index;
+                    }
+
+                    std::uint32_t addMesh(Rendering::Mesh &mesh)
+                    {
+                        // Meshes sharing their buffers are stored once
+                        auto key = std::make_pair(mesh.getVertexBuffer().isValid() ? mesh.getVertexBuffer().get() : nullptr,
+                                                  mesh.getIndexBuffer().isValid() ? mesh.getIndexBuffer().get() : nullptr);
+                        auto it = meshIndices.find(key);
+                        if (key.first != nullptr && it != meshIndices.end())
+                        {
+                            return it->second;
+                        }
+
+                        Mesh record;
+                        record.vertexCount = mesh.getVertexCount();
+                        record.primitiveCount = mesh.getPrimitiveCount();
+                        record.firstAttribute = static_cast<std::uint32_t>(attributes.size());
+                        record.attributeCount = static_cast<std::uint32_t>(mesh.getLayout().getAttributeCount());
+                        record.vertices = addBuffer(mesh.getVertexBuffer());
+                        record.indices = addBuffer(mesh.getIndexBuffer());
+
+                        const Math::BoundingBox &box = mesh.getBoundingBox();
+                        const Math::BoundingSphere &sphere = mesh.getBoundingSphere();
+                        Eigen::Map<Eigen::Vector3f>(record.boundingBox[0]) = box.min;
+                        Eigen::Map<Eigen::Vector3f>(record.boundingBox[1]) = box.max;
+                        Eigen::Map<Eigen::Vector3f>(record.boundingSphere) = sphere.center;
+                        record.boundingSphere[3] = sphere.radius;
+
+                        for (const Rendering::Layout::Attribute &attribute : mesh.getLayout().getAttributes())
+                        {
+                            if (attribute.getName().size() > MaxAttributeNameLength)
+                            {
+                                throw std::runtime_error("Attribute name too long for snapshot: " + attribute.getName());
+                            }
+
+                            Attribute attributeRecord;
+                            std::memset(attributeRecord.name, 0, sizeof(attributeRecord.name));
+                            std::memcpy(attributeRecord.name, attribute.getName().data(), attribute.getName().size());
+                            attributeRecord.type = static_cast<std::uint32_t>(attribute.getType());
+                            attributeRecord.count = static_cast<std::uint32_t>(attribute.getCount());
+
+                            attributes.push_back(attributeRecord);
+                        }
+
+                        std::uint32_t index = static_cast<std::uint32_t>(meshes.size());
+                        meshes.push_back(record);
+                        meshIndices.emplace(key, index);
+
+                        return index;
+                    }
+
+                    std::uint32_t addMaterial(const Rendering::Material &material)
+                    {
+                        Material record;
+                        record.emission = material.getEmission();
+                        record.translucency = material.getTranslucency();
+                        record.reflectivity = material.getReflectivity();
+                        record.indexOfRefraction = material.getIndexOfRefraction();
+                        Eigen::Map<Eigen::Vector4f>(record.diffuseColor) = material.getDiffuseColor();
+                        record.diffuseTexture = addTexture(material.getDiffuseTexture());
+                        record.normalMap = addTexture(material.getNormalMap());
+                        record.specularMap = addTexture(material.getSpecularMap());
+                        record.displacementMap = addTexture(material.getDisplacementMap());
+
+                        materials.push_back(record);
+
+                        return static_cast<std::uint32_t>(materials.size() - 1);
+                    }
+
+                    std::uint32_t addLight(const Rendering::Light &light)
+                    {
+                        Light record;
+                        record.type = static_cast<std::uint32_t>(light.getType());
+                        Eigen::Map<Eigen::Vector3f>(record.attenuationCoefficients) = light.getAttenuationCoefficients();
+                        Eigen::Map<Eigen::Vector4f>(record.color) = light.getColor();
+
+                        lights.push_back(record);
+
+                        return static_cast<std::uint32_t>(lights.size() - 1);
+                    }
+
+                    Payload addBuffer(Rendering::Reference<Rendering::IBuffer> &buffer)
+                    {
+                        if (!buffer.isValid() || buffer->getCapacity() == 0)
+                        {
+                            return Payload { 0, 0 };
+                        }
+
+                        return addPayload(buffer->getCapacity(), [&buffer] (std::uint8_t *data) {
+                            Utilities::ScopedDataPointer contents = buffer->data();
+                            std::memcpy(data, contents.get(), buffer->getCapacity());
+                        });
+                    }
+
+                    template <typename F>
+                    Payload addPayload(std::size_t size, F read)
+                    {
+                        Payload payload = { align(payloads.size()), size };
+
+                        payloads.resize(payload.offset + size);
+                        read(payloads.data() + payload.offset);
+
+                        return payload;
+                    }
+
+                    Core::TransformHierarchy *hierarchy;
+
+                    std::vector<Node> nodes;
+                    std::vector<Texture> textures;
+                    std::vector<Attribute> attributes;
+                    std::vector<Mesh> meshes;
+                    std::vector<Material> materials;
+                    std::vector<Light> lights;
+                    std::vector<AmberModelFormat::Entity> entities;
+                    std::vector<std::uint8_t> payloads;
+
+                    std::unordered_map<std::uint64_t, std::uint32_t> nodeIndices;
+                    std::map<const Rendering::ITexture *, std::uint32_t> textureIndices;
+                    std::map<std::pair<const Rendering::IBuffer *, const Rendering::IBuffer *>, std::uint32_t> meshIndices;
+            };
+        }
+
+        void AmberModelWriter::saveModel(const std::string &fileName, const std::vector<Core::Entity> &entities)
+        {
+            Core::TransformHierarchy *hierarchy = nullptr;
+            for (const Core::Entity &entity : entities)
+            {
+                if (const Core::Transform *transform = entity.getComponent<Core::Transform>())
+                {
+                    hierarchy = &transform->getHierarchy();
+                    break;
+                }
+            }
+
+            SnapshotBuilder builder(hierarchy);
+            for (const Core::Entity &entity : entities)
+            {
+                builder.addEntity(entity);
+            }
+
+            std::ofstream stream(fileName, std::ios::binary | std::ios::trunc);
+            if (!stream)
+            {
+                throw std::runtime_error("Unable to open file for writing: " + fileName);
+            }
+
+            builder.write(stream);
+
+            if (!stream)
+            {
+                throw std::runtime_error("Unable to write snapshot: " + fileName);
+            }
+        }
+
+        void AmberModelWriter::saveWorld(const std::string &fileName, Core::World &world)
+        {
+            saveModel(fileName, world.getEntities());
+        }
+    }
+}
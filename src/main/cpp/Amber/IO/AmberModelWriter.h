@@ -0,0 +1,30 @@
+#ifndef AMBERMODELWRITER_H
+#define AMBERMODELWRITER_H
+
+#include <string>
+#include <vector>
+
+#include "Amber/Core/Entity.h"
+#include "Amber/Core/World.h"
+
+namespace Amber
+{
+    namespace IO
+    {
+        // Writes entities as a binary snapshot that AmberModelLoader maps back.
+        // Transforms, meshes, materials, lights and the textures they use are
+        // saved; other components are not. Mesh and texture contents are read
+        // back from their buffers, which requires the context owning them to be
+        // active.
+        class AmberModelWriter
+        {
+            public:
+                AmberModelWriter() = default;
+
+                void saveModel(const std::string &fileName, const std::vector<Core::Entity> &entities);
+                void saveWorld(const std::string &fileName, Core::World &world);
+        };
+    }
+}
+
+#endif // AMBERMODELWRITER_H
@@ -11,6 +11,7 @@
 
 #include "Amber/Core/Entity.h"
 #include "Amber/Core/Transform.h"
+#include "Amber/Core/World.h"
 #include "Amber/Rendering/Light.h"
 #include "Amber/Rendering/Material.h"
 #include "Amber/Rendering/Mesh.h"
@@ -28,7 +29,7 @@ namespace Amber
         class ColladaModelLoader::OCLoader : public COLLADAFW::IWriter
         {
             public:
-                OCLoader(std::vector<Core::Entity> &entities);
+                OCLoader(Core::World &world, std::vector<Core::Entity> &entities);
                 virtual ~OCLoader();
 
                 virtual void cancel(const COLLADAFW::String& errorMessage);
@@ -58,6 +59,7 @@ namespace Amber
                 void traverseNodes(const COLLADAFW::NodePointerArray &nodes, Core::Transform *parentTransform);
 
                 Utilities::Logger log;
+                Core::World &world;
                 std::vector<Core::Entity> &entities;
 
                 std::map<COLLADAFW::UniqueId, Rendering::Mesh> meshes;
@@ -71,12 +73,12 @@ namespace Amber
         };
 
 
-        std::vector<Core::Entity> ColladaModelLoader::loadModel(const std::string &fileName)
+        std::vector<Core::Entity> ColladaModelLoader::loadModel(const std::string &fileName, Core::World &world)
         {
             std::vector<Core::Entity> entities;
 
             COLLADASaxFWL::Loader loader;
-            OCLoader writer(entities);
+            OCLoader writer(world, entities);
             COLLADAFW::Root root(&loader, &writer);
 
             if (!root.loadDocument(fileName))
@@ -87,8 +89,9 @@ namespace Amber
             return entities;
         }
 
-        ColladaModelLoader::OCLoader::OCLoader(std::vector<Core::Entity> &entities)
-            : entities(entities)
+        ColladaModelLoader::OCLoader::OCLoader(Core::World &world, std::vector<Core::Entity> &entities)
+            : world(world),
+              entities(entities)
         {
         }
 
@@ -135,7 +138,13 @@ namespace Amber
                              0,-1, 0, 0,
                              0, 0, 0, 1;
 
-            Core::Transform rootTransform(axisFixMatrix);
+            // Parts share the transforms of their nodes, so moving the root entity moves the whole model
+            Core::Transform rootTransform(axisFixMatrix, world.getTransformHierarchy());
+
+            Core::Entity root = world.create();
+            root.emplaceComponent<Core::Transform>(rootTransform);
+            entities.push_back(root);
+
             traverseNodes(visualScene->getRootNodes(), &rootTransform);
 
             return true;
@@ -397,8 +406,7 @@ namespace Amber
                                m[2][0], m[2][1], m[2][2], m[2][3],
                                m[3][0], m[3][1], m[3][2], m[3][3];
 
-                Core::Transform transformComponent(modelMatrix, parentTransform);
-                transformComponent.flatten(); // FIXME find way to share transform across entities
+                Core::Transform transformComponent(modelMatrix, *parentTransform);
 
                 const COLLADAFW::InstanceGeometryPointerArray &geometries = colladaNode->getInstanceGeometries();
 
@@ -410,8 +418,8 @@ namespace Amber
 
                     for (auto it = meshesIt.first; it != meshesIt.second; it++)
                     {
-                        Core::Entity entity;
-                        entity.addComponent(std::unique_ptr<Core::Transform>(new Core::Transform(transformComponent)));
+                        Core::Entity entity = world.create();
+                        entity.emplaceComponent<Core::Transform>(transformComponent);
 
                         Rendering::Mesh &mesh = meshes.at(it->second);
                         Rendering::Material material;
@@ -434,10 +442,10 @@ namespace Amber
                             }
                         }
 
-                        entity.addComponent(std::unique_ptr<Rendering::Mesh>(new Rendering::Mesh(std::move(mesh))));
-                        entity.addComponent(std::unique_ptr<Rendering::Material>(new Rendering::Material(std::move(material))));
+                        entity.emplaceComponent<Rendering::Mesh>(std::move(mesh));
+                        entity.emplaceComponent<Rendering::Material>(std::move(material));
 
-                        entities.push_back(std::move(entity));
+                        entities.push_back(entity);
                     }
                 }
 
@@ -445,13 +453,11 @@ namespace Amber
                 for (int j = 0; j < instanceLights.getCount(); j++)
                 {
                     COLLADAFW::InstanceLight *light = instanceLights[j];
-                    Rendering::Light l = lights.at(light->getInstanciatedObjectId());
-
-                    Core::Entity entity;
-                    entity.addComponent(std::unique_ptr<Core::Transform>(new Core::Transform(transformComponent)));
-                    entity.addComponent(std::unique_ptr<Rendering::Light>(new Rendering::Light(std::move(l))));
+                    Core::Entity entity = world.create();
+                    entity.emplaceComponent<Core::Transform>(transformComponent);
+                    entity.emplaceComponent<Rendering::Light>(lights.at(light->getInstanciatedObjectId()));
 
-                    entities.push_back(std::move(entity));
+                    entities.push_back(entity);
                 }
 
                 traverseNodes(colladaNode->getChildNodes(), &transformComponent);
@@ -20,7 +20,9 @@ namespace Amber
                 ColladaModelLoader() = default;
                 virtual ~ColladaModelLoader() = default;
 
-                virtual std::vector<Core::Entity> loadModel(const std::string &fileName) override final;
+                // The first entity of each visual scene only holds the scene's root
+                // transform, which all the following parts hang off
+                virtual std::vector<Core::Entity> loadModel(const std::string &fileName, Core::World &world) override final;
 
             private:
                 class OCLoader;
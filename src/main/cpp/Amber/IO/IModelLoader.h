@@ -4,6 +4,7 @@
 #include <vector>
 
 #include "Amber/Core/Entity.h"
+#include "Amber/Core/World.h"
 
 namespace Amber
 {
@@ -14,7 +15,7 @@ namespace Amber
             public:
                 virtual ~IModelLoader() = default;
 
-                virtual std::vector<Core::Entity> loadModel(const std::string &fileName) = 0;
+                virtual std::vector<Core::Entity> loadModel(const std::string &fileName, Core::World &world) = 0;
         };
     }
 }
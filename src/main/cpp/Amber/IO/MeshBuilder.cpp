@@ -15,6 +15,7 @@ namespace Amber
                 std::vector<std::uint32_t> reindex();
 
                 void buildVertexArray(Rendering::Mesh &mesh) const;
+                void computeBounds(Rendering::Mesh &mesh) const;
 
                 const float *positions;
                 std::size_t positionsCount;
@@ -138,6 +139,8 @@ namespace Amber
             mesh.setLayout(layout);
             p->buildVertexArray(mesh);
 
+            p->computeBounds(mesh);
+
             return mesh;
         }
 
@@ -233,5 +236,28 @@ namespace Amber
                 }
             }
         }
+
+        void MeshBuilder::Private::computeBounds(Rendering::Mesh &mesh) const
+        {
+            // The positions count is one of floats, not of points
+            if (indexMap.empty())
+            {
+                mesh.setBoundingBox(Math::BoundingBox::fromPoints(positions, positionsCount / 3));
+                mesh.setBoundingSphere(Math::BoundingSphere::fromPoints(positions, positionsCount / 3));
+                return;
+            }
+
+            // Only positions referenced by an index end up in the mesh
+            std::vector<float> points;
+            points.reserve(3 * indexMap.size());
+            for (const auto &indices : indexMap)
+            {
+                const float *position = positions + (3 * indices.first[0]);
+                points.insert(points.end(), position, position + 3);
+            }
+
+            mesh.setBoundingBox(Math::BoundingBox::fromPoints(points.data(), points.size() / 3));
+            mesh.setBoundingSphere(Math::BoundingSphere::fromPoints(points.data(), points.size() / 3));
+        }
     }
 }
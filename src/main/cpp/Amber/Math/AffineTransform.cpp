@@ -0,0 +1,103 @@
+#include "AffineTransform.h"
+
+#ifdef AMBER_SSE
+#  include <xmmintrin.h>
+#endif
+
+namespace Amber
+{
+    namespace Math
+    {
+        AffineTransform AffineTransform::identity()
+        {
+            return AffineTransform {{ { 1.0f, 0.0f, 0.0f, 0.0f },
+                                      { 0.0f, 1.0f, 0.0f, 0.0f },
+                                      { 0.0f, 0.0f, 1.0f, 0.0f } }};
+        }
+
+        AffineTransform AffineTransform::fromMatrix(const Eigen::Matrix4f &matrix)
+        {
+            AffineTransform transform;
+            Eigen::Map<Eigen::Matrix<float, 3, 4, Eigen::RowMajor>, Eigen::Aligned16>(transform.rows[0]) = matrix.topRows<3>();
+
+            return transform;
+        }
+
+        Eigen::Matrix4f AffineTransform::toMatrix() const
+        {
+            Eigen::Matrix4f matrix;
+            matrix.topRows<3>() = Eigen::Map<const Eigen::Matrix<float, 3, 4, Eigen::RowMajor>, Eigen::Aligned16>(rows[0]);
+            matrix.row(3) << 0.0f, 0.0f, 0.0f, 1.0f;
+
+            return matrix;
+        }
+
+#ifdef AMBER_SSE
+        // Each result row is a combination of the rows of rhs weighted by one row
+        // of lhs, plus the translation in the last lane.
+        void multiply(const AffineTransform &lhs, const AffineTransform &rhs, AffineTransform &result)
+        {
+            const __m128 rhs0 = _mm_load_ps(rhs.rows[0]);
+            const __m128 rhs1 = _mm_load_ps(rhs.rows[1]);
+            const __m128 rhs2 = _mm_load_ps(rhs.rows[2]);
+            const __m128 rhs3 = _mm_set_ps(1.0f, 0.0f, 0.0f, 0.0f);
+
+            __m128 rows[3];
+            for (int i = 0; i < 3; i++)
+            {
+                __m128 row = _mm_mul_ps(_mm_set1_ps(lhs.rows[i][0]), rhs0);
+                row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(lhs.rows[i][1]), rhs1));
+                row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(lhs.rows[i][2]), rhs2));
+                rows[i] = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(lhs.rows[i][3]), rhs3));
+            }
+
+            _mm_store_ps(result.rows[0], rows[0]);
+            _mm_store_ps(result.rows[1], rows[1]);
+            _mm_store_ps(result.rows[2], rows[2]);
+        }
+#else
+        void multiply(const AffineTransform &lhs, const AffineTransform &rhs, AffineTransform &result)
+        {
+            AffineTransform product;
+            for (int i = 0; i < 3; i++)
+            {
+                for (int j = 0; j < 4; j++)
+                {
+                    product.rows[i][j] = lhs.rows[i][0] * rhs.rows[0][j]
+                                       + lhs.rows[i][1] * rhs.rows[1][j]
+                                       + lhs.rows[i][2] * rhs.rows[2][j];
+                }
+
+                product.rows[i][3] += lhs.rows[i][3];
+            }
+
+            result = product;
+        }
+#endif
+
+        void multiply(const AffineTransform *lhs, const AffineTransform *rhs, AffineTransform *results, std::size_t count)
+        {
+            for (std::size_t i = 0; i < count; i++)
+            {
+                multiply(lhs[i], rhs[i], results[i]);
+            }
+        }
+
+        void propagateTransforms(const std::uint32_t *parents, const AffineTransform *locals, AffineTransform *worlds,
+                                 std::size_t first, std::size_t last)
+        {
+            for (std::size_t i = first; i < last; i++)
+            {
+                std::uint32_t parent = parents[i];
+                if (parent == NoParent)
+                {
+                    worlds[i] = locals[i];
+                }
+                else
+                {
+                    multiply(worlds[parent], locals[i], worlds[i]);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,43 @@
+#ifndef AFFINETRANSFORM_H
+#define AFFINETRANSFORM_H
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+#include <Eigen/Core>
+
+#include "Amber/Utilities/Defines.h"
+
+namespace Amber
+{
+    namespace Math
+    {
+        // The top three rows of an affine 4x4 matrix, the last row being (0, 0, 0, 1).
+        // Each row is aligned so that it can be loaded into one SSE register.
+        struct alignas(16) AffineTransform
+        {
+            float rows[3][4];
+
+            static AffineTransform identity();
+            static AffineTransform fromMatrix(const Eigen::Matrix4f &matrix);
+
+            Eigen::Matrix4f toMatrix() const;
+        };
+
+        const std::uint32_t NoParent = std::numeric_limits<std::uint32_t>::max();
+
+        // result = lhs * rhs, result may alias either operand
+        void multiply(const AffineTransform &lhs, const AffineTransform &rhs, AffineTransform &result);
+
+        // results[i] = lhs[i] * rhs[i] for count transforms
+        void multiply(const AffineTransform *lhs, const AffineTransform *rhs, AffineTransform *results, std::size_t count);
+
+        // Computes worlds[i] = worlds[parents[i]] * locals[i] for the nodes in
+        // [first, last), where each parent comes before its children or is NoParent
+        void propagateTransforms(const std::uint32_t *parents, const AffineTransform *locals, AffineTransform *worlds,
+                                 std::size_t first, std::size_t last);
+    }
+}
+
+#endif // AFFINETRANSFORM_H
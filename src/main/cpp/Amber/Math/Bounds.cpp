@@ -0,0 +1,102 @@
+#include "Bounds.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace Amber
+{
+    namespace Math
+    {
+        BoundingBox BoundingBox::empty()
+        {
+            const float infinity = std::numeric_limits<float>::infinity();
+            return BoundingBox { Eigen::Vector3f::Constant(infinity), Eigen::Vector3f::Constant(-infinity) };
+        }
+
+        BoundingBox BoundingBox::fromPoints(const float *points, std::size_t count)
+        {
+            BoundingBox box = empty();
+            for (std::size_t i = 0; i < count; i++)
+            {
+                Eigen::Map<const Eigen::Vector3f> point(points + 3 * i);
+                box.min = box.min.cwiseMin(point);
+                box.max = box.max.cwiseMax(point);
+            }
+
+            return box;
+        }
+
+        bool BoundingBox::isEmpty() const
+        {
+            return (min.array() > max.array()).any();
+        }
+
+        Eigen::Vector3f BoundingBox::getCenter() const
+        {
+            return (min + max) * 0.5f;
+        }
+
+        Eigen::Vector3f BoundingBox::getExtents() const
+        {
+            return (max - min) * 0.5f;
+        }
+
+        BoundingBox BoundingBox::transformed(const Eigen::Matrix4f &transform) const
+        {
+            if (isEmpty())
+            {
+                return *this;
+            }
+
+            // The extents of the new box are the absolute rotated extents
+            Eigen::Vector3f center = transform.topLeftCorner<3, 3>() * getCenter() + transform.topRightCorner<3, 1>();
+            Eigen::Vector3f extents = transform.topLeftCorner<3, 3>().cwiseAbs() * getExtents();
+
+            return BoundingBox { center - extents, center + extents };
+        }
+
+        BoundingSphere BoundingSphere::empty()
+        {
+            return BoundingSphere { Eigen::Vector3f::Zero(), -1.0f };
+        }
+
+        BoundingSphere BoundingSphere::fromPoints(const float *points, std::size_t count)
+        {
+            BoundingBox box = BoundingBox::fromPoints(points, count);
+            if (box.isEmpty())
+            {
+                return empty();
+            }
+
+            BoundingSphere sphere { box.getCenter(), 0.0f };
+            float radiusSquared = 0.0f;
+            for (std::size_t i = 0; i < count; i++)
+            {
+                Eigen::Map<const Eigen::Vector3f> point(points + 3 * i);
+                radiusSquared = std::max(radiusSquared, (point - sphere.center).squaredNorm());
+            }
+
+            sphere.radius = std::sqrt(radiusSquared);
+            return sphere;
+        }
+
+        bool BoundingSphere::isEmpty() const
+        {
+            return radius < 0.0f;
+        }
+
+        BoundingSphere BoundingSphere::transformed(const Eigen::Matrix4f &transform) const
+        {
+            if (isEmpty())
+            {
+                return *this;
+            }
+
+            float scale = transform.topLeftCorner<3, 3>().colwise().norm().maxCoeff();
+            Eigen::Vector3f center = transform.topLeftCorner<3, 3>() * this->center + transform.topRightCorner<3, 1>();
+
+            return BoundingSphere { center, radius * scale };
+        }
+    }
+}
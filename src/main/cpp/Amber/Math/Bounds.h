@@ -0,0 +1,52 @@
+#ifndef BOUNDS_H
+#define BOUNDS_H
+
+#include <cstddef>
+
+#include <Eigen/Core>
+
+namespace Amber
+{
+    namespace Math
+    {
+        // Axis-aligned box; an empty box has min above max
+        struct BoundingBox
+        {
+            Eigen::Vector3f min;
+            Eigen::Vector3f max;
+
+            static BoundingBox empty();
+
+            // From count points of three tightly packed floats each
+            static BoundingBox fromPoints(const float *points, std::size_t count);
+
+            bool isEmpty() const;
+            Eigen::Vector3f getCenter() const;
+            Eigen::Vector3f getExtents() const;
+
+            // The box around this one after an affine transform
+            BoundingBox transformed(const Eigen::Matrix4f &transform) const;
+        };
+
+        // An empty sphere has a negative radius
+        struct BoundingSphere
+        {
+            Eigen::Vector3f center;
+            float radius;
+
+            static BoundingSphere empty();
+
+            // Centered on the points' bounding box, which is not the smallest
+            // sphere but close and cheap
+            static BoundingSphere fromPoints(const float *points, std::size_t count);
+
+            bool isEmpty() const;
+
+            // The sphere around this one after an affine transform, scaled by
+            // its largest axis
+            BoundingSphere transformed(const Eigen::Matrix4f &transform) const;
+        };
+    }
+}
+
+#endif // BOUNDS_H
@@ -0,0 +1,122 @@
+#include "Frustum.h"
+
+#include "Amber/Utilities/Defines.h"
+
+#ifdef AMBER_SSE
+#  include <xmmintrin.h>
+#endif
+
+namespace Amber
+{
+    namespace Math
+    {
+        Frustum::Frustum()
+        {
+            // Everything is inside until planes are set
+            planes.fill(Eigen::Vector4f(0.0f, 0.0f, 0.0f, 1.0f));
+        }
+
+        Frustum Frustum::fromMatrix(const Eigen::Matrix4f &viewProjection)
+        {
+            // Clip space is -w <= x, y, z <= w, each side is a sum of rows
+            const Eigen::Vector4f row0 = viewProjection.row(0).transpose();
+            const Eigen::Vector4f row1 = viewProjection.row(1).transpose();
+            const Eigen::Vector4f row2 = viewProjection.row(2).transpose();
+            const Eigen::Vector4f row3 = viewProjection.row(3).transpose();
+
+            Frustum frustum;
+            frustum.planes[Left] = row3 + row0;
+            frustum.planes[Right] = row3 - row0;
+            frustum.planes[Bottom] = row3 + row1;
+            frustum.planes[Top] = row3 - row1;
+            frustum.planes[Near] = row3 + row2;
+            frustum.planes[Far] = row3 - row2;
+
+            for (Eigen::Vector4f &plane : frustum.planes)
+            {
+                float length = plane.head<3>().norm();
+                if (length > 0.0f)
+                {
+                    plane /= length;
+                }
+            }
+
+            return frustum;
+        }
+
+        const Eigen::Vector4f &Frustum::getPlane(Plane plane) const
+        {
+            return planes[plane];
+        }
+
+        bool Frustum::intersects(const BoundingSphere &sphere) const
+        {
+            for (const Eigen::Vector4f &plane : planes)
+            {
+                if (plane.head<3>().dot(sphere.center) + plane.w() < -sphere.radius)
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        bool Frustum::intersects(const BoundingBox &box) const
+        {
+            // The box is outside when even its corner furthest along a plane's
+            // normal is behind it
+            Eigen::Vector3f center = box.getCenter();
+            Eigen::Vector3f extents = box.getExtents();
+
+            for (const Eigen::Vector4f &plane : planes)
+            {
+                float radius = plane.head<3>().cwiseAbs().dot(extents);
+                if (plane.head<3>().dot(center) + plane.w() < -radius)
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        void Frustum::intersects(const float *x, const float *y, const float *z, const float *radius,
+                                 std::size_t count, std::uint8_t *visible) const
+        {
+            std::size_t i = 0;
+
+#ifdef AMBER_SSE
+            for (; i + 4 <= count; i += 4)
+            {
+                const __m128 sphereX = _mm_loadu_ps(x + i);
+                const __m128 sphereY = _mm_loadu_ps(y + i);
+                const __m128 sphereZ = _mm_loadu_ps(z + i);
+                const __m128 negativeRadius = _mm_sub_ps(_mm_setzero_ps(), _mm_loadu_ps(radius + i));
+
+                // Lanes stay set while every plane has the sphere in front
+                __m128 inside = _mm_cmpeq_ps(sphereX, sphereX);
+                for (const Eigen::Vector4f &plane : planes)
+                {
+                    __m128 distance = _mm_mul_ps(sphereX, _mm_set1_ps(plane.x()));
+                    distance = _mm_add_ps(distance, _mm_mul_ps(sphereY, _mm_set1_ps(plane.y())));
+                    distance = _mm_add_ps(distance, _mm_mul_ps(sphereZ, _mm_set1_ps(plane.z())));
+                    distance = _mm_add_ps(distance, _mm_set1_ps(plane.w()));
+                    inside = _mm_and_ps(inside, _mm_cmpge_ps(distance, negativeRadius));
+                }
+
+                int mask = _mm_movemask_ps(inside);
+                visible[i] = mask & 1;
+                visible[i + 1] = (mask >> 1) & 1;
+                visible[i + 2] = (mask >> 2) & 1;
+                visible[i + 3] = (mask >> 3) & 1;
+            }
+#endif
+
+            for (; i < count; i++)
+            {
+                visible[i] = intersects(BoundingSphere { Eigen::Vector3f(x[i], y[i], z[i]), radius[i] }) ? 1 : 0;
+            }
+        }
+    }
+}
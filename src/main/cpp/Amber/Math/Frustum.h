@@ -0,0 +1,55 @@
+#ifndef FRUSTUM_H
+#define FRUSTUM_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include <Eigen/Core>
+
+#include "Amber/Math/Bounds.h"
+
+namespace Amber
+{
+    namespace Math
+    {
+        // Six planes facing inwards, each (normal, distance) with a unit normal,
+        // so that a point p is inside when dot(normal, p) + distance >= 0
+        class Frustum
+        {
+            public:
+                enum Plane
+                {
+                    Left,
+                    Right,
+                    Bottom,
+                    Top,
+                    Near,
+                    Far,
+                    PlaneCount
+                };
+
+                Frustum();
+
+                // Planes of a projection * view matrix, in world space
+                static Frustum fromMatrix(const Eigen::Matrix4f &viewProjection);
+
+                const Eigen::Vector4f &getPlane(Plane plane) const;
+
+                // Conservative: a volume touching the frustum counts as inside
+                bool intersects(const BoundingSphere &sphere) const;
+                bool intersects(const BoundingBox &box) const;
+
+                // Tests count spheres stored as separate coordinate and radius
+                // arrays, four at a time where SSE is available, and writes 1 for
+                // every visible sphere and 0 for every other to visible
+                void intersects(const float *x, const float *y, const float *z, const float *radius,
+                                std::size_t count, std::uint8_t *visible) const;
+
+            private:
+                std::array<Eigen::Vector4f, PlaneCount> planes;
+        };
+    }
+}
+
+#endif // FRUSTUM_H
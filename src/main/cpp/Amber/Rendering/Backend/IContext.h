@@ -32,6 +32,7 @@ namespace Amber
                 virtual void unlock(const Reference<IBindable> &bindable) = 0;
 
                 virtual Reference<IBuffer> createHardwareBuffer(IBuffer::Type type) = 0;
+                virtual void destroyHardwareBuffer(const Reference<IBuffer> &buffer) = 0;
                 virtual Reference<IRenderTarget> createRenderTarget() = 0;
                 virtual Reference<IShader> createShader(IShader::Type type) = 0;
                 virtual Reference<IProgram> createProgram() = 0;
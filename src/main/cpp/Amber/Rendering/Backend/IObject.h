@@ -24,6 +24,7 @@ namespace Amber
                 virtual const Reference<IBuffer> &getIndexBuffer() const = 0;
 
                 virtual Layout &getLayout() = 0;
+                virtual const Layout &getLayout() const = 0;
 
                 virtual bool isInHardwareStorage() const = 0;
                 virtual void moveToHardwareStorage(IContext &context) = 0;
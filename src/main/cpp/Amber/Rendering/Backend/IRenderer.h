@@ -1,6 +1,7 @@
 #ifndef IRENDERER_H
 #define IRENDERER_H
 
+#include <cstddef>
 #include <deque>
 
 #include "Amber/Core/World.h"
@@ -30,7 +31,22 @@ namespace Amber
                 virtual void prepare(Reference<IRenderTarget> renderTarget) = 0;
 
                 virtual void render(Core::World &scene) = 0;
-                virtual void render(IObject &renderable, Material &material) = 0;
+                virtual void render(const IObject &renderable, const Material &material) = 0;
+
+                // For strategies that keep state bound across draws themselves: the
+                // bindable holding a prepared object's vertex data, and a draw of the
+                // object with whatever is currently bound.
+                virtual Reference<IBindable> getVertexArray(const IObject &renderable) = 0;
+                virtual void draw(const IObject &renderable) = 0;
+
+                // Draws the object once per world transform, each a column-major
+                // 4x4 float matrix. Programs read it from the per-instance
+                // attribute mdl_Transform, listed after the object's attributes.
+                virtual void drawInstanced(const IObject &renderable, const float *transforms, std::size_t instanceCount) = 0;
+
+                // Replays recorded commands, on the context's thread. State bound by
+                // the buffer is released when it is done.
+                virtual void execute(const CommandBuffer &buffer) = 0;
 
                 virtual void clear() = 0;
 
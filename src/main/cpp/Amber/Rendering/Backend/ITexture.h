@@ -60,10 +60,16 @@ namespace Amber
                 virtual std::size_t getDepth() const = 0;
 
                 virtual Type getType() const = 0;
+                virtual DataFormat getDataFormat() const = 0;
 
                 virtual void setSize(std::size_t width, std::size_t height, std::size_t depth) = 0;
 
                 virtual void setImageData(const std::uint8_t *data) = 0;
+
+                // Reads back the base level, tightly packed, all sides of a cube map one after another
+                virtual std::size_t getImageDataSize() const = 0;
+                virtual void getImageData(std::uint8_t *data) = 0;
+
                 virtual void setFilterMode(FilterMode mode) = 0;
                 virtual void setWrapMode(WrapMode mode) = 0;
         };
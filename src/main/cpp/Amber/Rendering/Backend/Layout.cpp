@@ -31,6 +31,22 @@ namespace Amber
             return attributes->size();
         }
 
+        std::size_t Layout::getLocation(std::size_t attributeIndex) const
+        {
+            if (attributeIndex >= attributes->size())
+            {
+                throw std::out_of_range("Attribute index out of bounds");
+            }
+
+            std::size_t location = 0;
+            for (std::size_t i = 0; i < attributeIndex; i++)
+            {
+                location += attributes->at(i).getLocationCount();
+            }
+
+            return location;
+        }
+
         std::size_t Layout::getOffset(std::size_t attributeIndex) const
         {
             if (attributeIndex < 0 || attributeIndex >= attributes->size())
@@ -38,11 +54,16 @@ namespace Amber
                 throw std::out_of_range("Attribute index out of bounds");
             }
 
+            bool perInstance = attributes->at(attributeIndex).isPerInstance();
+
             std::size_t offset = 0;
             for (std::size_t i = 0; i < attributeIndex; i++)
             {
                 const Attribute &attribute = attributes->at(i);
-                offset += attribute.getCount() * attribute.getStride();
+                if (attribute.isPerInstance() == perInstance)
+                {
+                    offset += attribute.getCount() * attribute.getStride();
+                }
             }
 
             return offset;
@@ -53,15 +74,56 @@ namespace Amber
             std::size_t stride = 0;
             for (const Attribute &attribute : *attributes)
             {
-                stride += attribute.getCount() * attribute.getStride();
+                if (!attribute.isPerInstance())
+                {
+                    stride += attribute.getCount() * attribute.getStride();
+                }
             }
             return stride;
         }
 
-        Layout::Attribute::Attribute(std::string name, Layout::ComponentType type, std::size_t count)
+        std::size_t Layout::getInstanceStride() const
+        {
+            std::size_t stride = 0;
+            for (const Attribute &attribute : *attributes)
+            {
+                if (attribute.isPerInstance())
+                {
+                    stride += attribute.getCount() * attribute.getStride();
+                }
+            }
+            return stride;
+        }
+
+        bool Layout::hasInstanceAttributes() const
+        {
+            return std::any_of(attributes->begin(), attributes->end(), [] (const Attribute &attribute) {
+                return attribute.isPerInstance();
+            });
+        }
+
+        Layout Layout::clone() const
+        {
+            Layout layout;
+            *layout.attributes = *attributes;
+            return layout;
+        }
+
+        bool Layout::operator==(const Layout &other) const
+        {
+            return attributes == other.attributes || *attributes == *other.attributes;
+        }
+
+        bool Layout::operator!=(const Layout &other) const
+        {
+            return !(*this == other);
+        }
+
+        Layout::Attribute::Attribute(std::string name, Layout::ComponentType type, std::size_t count, std::uint32_t divisor)
             : name(name),
               type(type),
-              count(count)
+              count(count),
+              divisor(divisor)
         {
         }
 
@@ -80,6 +142,34 @@ namespace Amber
             return count;
         }
 
+        std::uint32_t Layout::Attribute::getDivisor() const
+        {
+            return divisor;
+        }
+
+        bool Layout::Attribute::isPerInstance() const
+        {
+            return divisor != 0;
+        }
+
+        std::size_t Layout::Attribute::getLocationCount() const
+        {
+            return (count + 3) / 4;
+        }
+
+        bool Layout::Attribute::operator==(const Attribute &other) const
+        {
+            return name == other.name
+                    && type == other.type
+                    && count == other.count
+                    && divisor == other.divisor;
+        }
+
+        bool Layout::Attribute::operator!=(const Attribute &other) const
+        {
+            return !(*this == other);
+        }
+
         std::size_t Layout::Attribute::getStride() const
         {
             switch (type)
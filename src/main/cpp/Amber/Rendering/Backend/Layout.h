@@ -31,20 +31,30 @@ namespace Amber
                     ArrayOfStructures
                 };
 
+                // An attribute with a divisor advances once every divisor
+                // instances instead of once per vertex. Shader locations hold up
+                // to four components, larger attributes span several.
                 struct Attribute
                 {
                     public:
-                        Attribute(std::string name, ComponentType type, std::size_t count);
+                        Attribute(std::string name, ComponentType type, std::size_t count, std::uint32_t divisor = 0);
 
                         const std::string &getName() const;
                         ComponentType getType() const;
                         std::size_t getCount() const;
                         std::size_t getStride() const;
+                        std::uint32_t getDivisor() const;
+                        bool isPerInstance() const;
+                        std::size_t getLocationCount() const;
+
+                        bool operator==(const Attribute &other) const;
+                        bool operator!=(const Attribute &other) const;
 
                     private:
                         std::string name;
                         ComponentType type;
                         std::size_t count;
+                        std::uint32_t divisor;
                 };
 
                 typedef std::vector<Attribute> AttributeList;
@@ -57,8 +67,24 @@ namespace Amber
                 void insertAttribute(Attribute attribute);
 
                 std::size_t getAttributeCount() const;
+
+                // First shader location of an attribute, after those of the
+                // attributes before it
+                std::size_t getLocation(std::size_t attributeIndex) const;
+
+                // Per-vertex and per-instance attributes are stored in separate
+                // buffers; offsets are within the attribute's own buffer
                 std::size_t getOffset(std::size_t attributeIndex) const;
                 std::size_t getTotalStride() const;
+                std::size_t getInstanceStride() const;
+                bool hasInstanceAttributes() const;
+
+                // Copies share their attribute list, so a layout that must not
+                // follow later changes to this one has to be cloned
+                Layout clone() const;
+
+                bool operator==(const Layout &other) const;
+                bool operator!=(const Layout &other) const;
 
             private:
                 std::shared_ptr<AttributeList> attributes;
@@ -81,7 +81,7 @@ namespace Amber
                 }
 
                 bind();
-                glBufferSubData(getGLType(type), offset, capacity, data);
+                glBufferSubData(getGLType(type), offset, size, data);
                 unbind();
             }
 
@@ -1,5 +1,6 @@
 #include "OpenGL4Context.h"
 
+#include <algorithm>
 #include <condition_variable>
 #include <map>
 #include <memory>
@@ -31,7 +32,21 @@ namespace Amber
                     std::unique_ptr<std::mutex> bindLocksMutex;
                     std::unique_ptr<std::condition_variable> bindSlotLocked;
 
-                    std::map<const IObject *, std::unique_ptr<OpenGL4VertexArray>> vertexArrays;
+                    // Several layouts may read the same buffers, so each buffer
+                    // pair keeps one vertex array per layout it was prepared with
+                    struct VertexArrayEntry
+                    {
+                        Layout layout;
+                        std::unique_ptr<OpenGL4VertexArray> vertexArray;
+                    };
+
+                    typedef std::pair<const IBuffer *, const IBuffer *> VertexArrayKey;
+
+                    static VertexArrayKey getVertexArrayKey(const IObject *object);
+
+                    std::multimap<VertexArrayKey, VertexArrayEntry>::iterator findVertexArray(const IObject *object);
+
+                    std::multimap<VertexArrayKey, VertexArrayEntry> vertexArrays;
                     std::vector<std::unique_ptr<IBuffer>> buffers;
                     std::vector<std::unique_ptr<IRenderTarget>> renderTargets;
                     std::vector<std::unique_ptr<IShader>> shaders;
@@ -49,6 +64,22 @@ namespace Amber
                 }
             }
 
+            OpenGL4Context::Private::VertexArrayKey OpenGL4Context::Private::getVertexArrayKey(const IObject *object)
+            {
+                const Reference<IBuffer> &indexBuffer = object->getIndexBuffer();
+                return VertexArrayKey(object->getVertexBuffer().get(), indexBuffer.isValid() ? indexBuffer.get() : nullptr);
+            }
+
+            std::multimap<OpenGL4Context::Private::VertexArrayKey, OpenGL4Context::Private::VertexArrayEntry>::iterator OpenGL4Context::Private::findVertexArray(const IObject *object)
+            {
+                auto range = vertexArrays.equal_range(getVertexArrayKey(object));
+                auto it = std::find_if(range.first, range.second, [object] (const std::pair<const VertexArrayKey, VertexArrayEntry> &entry) {
+                    return entry.second.layout == object->getLayout();
+                });
+
+                return it != range.second ? it : vertexArrays.end();
+            }
+
             OpenGL4Context::OpenGL4Context()
                 : p(new Private(isMultithreadingSupported()))
             {
@@ -168,6 +199,32 @@ namespace Amber
                 return Reference<IBuffer>(this, p->buffers.back().get());
             }
 
+            void OpenGL4Context::destroyHardwareBuffer(const Reference<IBuffer> &buffer)
+            {
+                const IBuffer *value = buffer.get();
+
+                for (auto it = p->vertexArrays.begin(); it != p->vertexArrays.end();)
+                {
+                    if (it->first.first == value || it->first.second == value)
+                    {
+                        it = p->vertexArrays.erase(it);
+                    }
+                    else
+                    {
+                        ++it;
+                    }
+                }
+
+                auto it = std::find_if(p->buffers.begin(), p->buffers.end(), [value] (const std::unique_ptr<IBuffer> &owned) {
+                    return owned.get() == value;
+                });
+
+                if (it != p->buffers.end())
+                {
+                    p->buffers.erase(it);
+                }
+            }
+
             Reference<IRenderTarget> OpenGL4Context::createRenderTarget()
             {
                 p->renderTargets.emplace_back(new OpenGL4Framebuffer());
@@ -197,11 +254,17 @@ namespace Amber
                 return Reference<IRenderTarget>(this, p->renderTargets.front().get());
             }
 
-            // FIXME this breaks if object's address changes
+            // Vertex arrays are looked up by the buffers and layout they read,
+            // since the object owning them may be relocated by the component storage
             Reference<OpenGL4VertexArray> OpenGL4Context::getVertexArray(const IObject *object)
             {
-                auto it = p->vertexArrays.find(object);
-                return it != p->vertexArrays.end() ? Reference<OpenGL4VertexArray>(this, it->second.get()) : Reference<OpenGL4VertexArray>();
+                if (!object->getVertexBuffer().isValid())
+                {
+                    return Reference<OpenGL4VertexArray>();
+                }
+
+                auto it = p->findVertexArray(object);
+                return it != p->vertexArrays.end() ? Reference<OpenGL4VertexArray>(this, it->second.vertexArray.get()) : Reference<OpenGL4VertexArray>();
             }
 
             void OpenGL4Context::createVertexArray(IObject *object)
@@ -211,10 +274,23 @@ namespace Amber
 
                 assert(vertexBuffer.isValid());
 
+                if (p->findVertexArray(object) != p->vertexArrays.end())
+                {
+                    return;
+                }
+
+                // Layouts share their attribute list between copies, so the
+                // instance transform goes into a clone after the object's own
+                Layout layout = object->getLayout().clone();
+                layout.insertAttribute(Layout::Attribute("mdl_Transform", Layout::ComponentType::Float, 16, 1));
+
                 std::unique_ptr<OpenGL4VertexArray> vertexArray(new OpenGL4VertexArray(vertexBuffer, indexBuffer));
-                vertexArray->setLayout(object->getLayout());
+                vertexArray->setLayout(layout);
 
-                p->vertexArrays.emplace(object, std::move(vertexArray));
+                Private::VertexArrayEntry entry;
+                entry.layout = object->getLayout().clone();
+                entry.vertexArray = std::move(vertexArray);
+                p->vertexArrays.emplace(Private::getVertexArrayKey(object), std::move(entry));
             }
         }
     }
@@ -36,6 +36,7 @@ namespace Amber
                     virtual void unlock(const Reference<IBindable> &bindable) override final;
 
                     virtual Reference<IBuffer> createHardwareBuffer(IBuffer::Type type) override final;
+                    virtual void destroyHardwareBuffer(const Reference<IBuffer> &buffer) override final;
                     virtual Reference<IRenderTarget> createRenderTarget() override final;
                     virtual Reference<IShader> createShader(IShader::Type type) override final;
                     virtual Reference<IProgram> createProgram() override final;
@@ -94,7 +94,8 @@ namespace Amber
                 const Layout::AttributeList &attributes = layout.getAttributes();
                 for (std::size_t i = 0; i < attributes.size(); i++)
                 {
-                    glBindAttribLocation(handle, i, attributes.at(i).getName().c_str());
+                    // Matrices take a location per column from the given one on
+                    glBindAttribLocation(handle, layout.getLocation(i), attributes.at(i).getName().c_str());
                 }
 
                 glLinkProgram(handle);
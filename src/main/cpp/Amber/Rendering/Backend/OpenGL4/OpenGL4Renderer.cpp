@@ -128,7 +128,7 @@ namespace Amber
 //                });
             }
 
-            void OpenGL4Renderer::render(IObject &object, Material &material)
+            void OpenGL4Renderer::render(const IObject &object, const Material &material)
             {
                 Reference<OpenGL4VertexArray> vertexArray = context.getVertexArray(&object);
                 if (!vertexArray.isValid())
@@ -138,21 +138,95 @@ namespace Amber
                     return;
                 }
 
-                std::vector<BindLock> locks;
+                // Called for every draw, so the locks live on the stack
+                const BindLock locks[] = {
+                    BindLock(vertexArray),
+                    BindLock(material.getDiffuseTexture()),
+                    BindLock(material.getNormalMap()),
+                    BindLock(material.getSpecularMap()),
+                    BindLock(material.getDisplacementMap())
+                };
 
-                locks.emplace_back(vertexArray);
-                locks.emplace_back(material.getDiffuseTexture());
-                locks.emplace_back(material.getNormalMap());
-                locks.emplace_back(material.getSpecularMap());
-                locks.emplace_back(material.getDisplacementMap());
+                draw(object);
+            }
 
-                if (vertexArray->hasIndexBuffer())
+            Reference<IBindable> OpenGL4Renderer::getVertexArray(const IObject &object)
+            {
+                return context.getVertexArray(&object);
+            }
+
+            void OpenGL4Renderer::draw(const IObject &object)
+            {
+                Reference<OpenGL4VertexArray> vertexArray = context.getVertexArray(&object);
+                if (!vertexArray.isValid())
                 {
-                    glDrawElementsInstanced(GL_TRIANGLES, object.getPrimitiveCount(), GL_UNSIGNED_INT, 0, object.getInstanceCount());
+                    return;
                 }
-                else
+
+                drawVertexArray(*vertexArray, object, object.getInstanceCount());
+            }
+
+            void OpenGL4Renderer::drawInstanced(const IObject &object, const float *transforms, std::size_t instanceCount)
+            {
+                Reference<OpenGL4VertexArray> vertexArray = context.getVertexArray(&object);
+                if (!vertexArray.isValid() || instanceCount == 0)
                 {
-                    glDrawArraysInstanced(GL_TRIANGLES, 0, object.getPrimitiveCount(), object.getInstanceCount());
+                    return;
+                }
+
+                vertexArray->assignInstances(transforms, sizeof(float) * 16 * instanceCount);
+                drawVertexArray(*vertexArray, object, instanceCount);
+            }
+
+            void OpenGL4Renderer::execute(const CommandBuffer &buffer)
+            {
+                // Bound state is held until replaced or the buffer is done, a
+                // bind only releases the previous holder of its slot
+                BindLock programLock;
+                BindLock vertexArrayLock;
+                BindLock textureLocks[CommandBuffer::MaxTextureSlots];
+                IProgram *program = nullptr;
+
+                auto rebind = [this] (BindLock &lock, IBindable *bindable) {
+                    lock.unlock();
+                    lock = BindLock(bindable != nullptr ? Reference<IBindable>(&context, bindable) : Reference<IBindable>());
+                };
+
+                for (const CommandBuffer::Command &command : buffer.getCommands())
+                {
+                    void *object = const_cast<void *>(command.object);
+
+                    switch (command.type)
+                    {
+                        case CommandBuffer::CommandType::BindProgram:
+                            program = static_cast<IProgram *>(object);
+                            rebind(programLock, program);
+                            break;
+
+                        case CommandBuffer::CommandType::BindTexture:
+                            rebind(textureLocks[command.slot], static_cast<ITexture *>(object));
+                            break;
+
+                        case CommandBuffer::CommandType::BindVertexArray:
+                            rebind(vertexArrayLock, static_cast<IBindable *>(object));
+                            break;
+
+                        case CommandBuffer::CommandType::SetConstant:
+                            if (program != nullptr)
+                            {
+                                setConstant(*program, buffer, command);
+                            }
+                            break;
+
+                        case CommandBuffer::CommandType::Draw:
+                            draw(*static_cast<const IObject *>(command.object));
+                            break;
+
+                        case CommandBuffer::CommandType::DrawInstanced:
+                            drawInstanced(*static_cast<const IObject *>(command.object),
+                                          buffer.getInstanceTransforms(command), command.instanceCount);
+                            break;
+                    }
                 }
             }
 
@@ -192,6 +266,52 @@ namespace Amber
                 return context;
             }
 
+            void OpenGL4Renderer::setConstant(IProgram &program, const CommandBuffer &buffer, const CommandBuffer::Command &command)
+            {
+                const char *name = buffer.getConstantName(command);
+
+                switch (command.constantType)
+                {
+                    case CommandBuffer::ConstantType::Int:
+                        program.setConstant(name, buffer.getConstant<std::int32_t>(command));
+                        break;
+                    case CommandBuffer::ConstantType::UnsignedInt:
+                        program.setConstant(name, buffer.getConstant<std::uint32_t>(command));
+                        break;
+                    case CommandBuffer::ConstantType::Float:
+                        program.setConstant(name, buffer.getConstant<float>(command));
+                        break;
+                    case CommandBuffer::ConstantType::Vector2:
+                        program.setConstant(name, buffer.getConstant<Eigen::Vector2f>(command));
+                        break;
+                    case CommandBuffer::ConstantType::Vector3:
+                        program.setConstant(name, buffer.getConstant<Eigen::Vector3f>(command));
+                        break;
+                    case CommandBuffer::ConstantType::Vector4:
+                        program.setConstant(name, buffer.getConstant<Eigen::Vector4f>(command));
+                        break;
+                    case CommandBuffer::ConstantType::Matrix3:
+                        program.setConstant(name, buffer.getConstant<Eigen::Matrix3f>(command));
+                        break;
+                    case CommandBuffer::ConstantType::Matrix4:
+                        program.setConstant(name, buffer.getConstant<Eigen::Matrix4f>(command));
+                        break;
+                }
+            }
+
+            void OpenGL4Renderer::drawVertexArray(const OpenGL4VertexArray &vertexArray, const IObject &object,
+                                                  std::size_t instanceCount)
+            {
+                if (vertexArray.hasIndexBuffer())
+                {
+                    glDrawElementsInstanced(GL_TRIANGLES, object.getPrimitiveCount(), GL_UNSIGNED_INT, 0, instanceCount);
+                }
+                else
+                {
+                    glDrawArraysInstanced(GL_TRIANGLES, 0, object.getPrimitiveCount(), instanceCount);
+                }
+            }
+
             GLenum OpenGL4Renderer::getRenderOptionId(IRenderer::RenderOption renderOption) const
             {
                 switch (renderOption)
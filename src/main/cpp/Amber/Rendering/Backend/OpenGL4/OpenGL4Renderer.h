@@ -6,6 +6,7 @@
 #include <deque>
 
 #include "Amber/Rendering/ForwardDeclarations.h"
+#include "Amber/Rendering/CommandBuffer.h"
 #include "Amber/Rendering/Backend/OpenGL4/OpenGL4Includes.h"
 #include "Amber/Rendering/Backend/OpenGL4/OpenGL4Context.h"
 
@@ -27,7 +28,13 @@ namespace Amber
                     virtual void prepare(Reference<IRenderTarget> renderTarget) override final;
 
                     virtual void render(Core::World &scene) override final;
-                    virtual void render(IObject &object, Material &material) override final;
+                    virtual void render(const IObject &object, const Material &material) override final;
+
+                    virtual Reference<IBindable> getVertexArray(const IObject &object) override final;
+                    virtual void draw(const IObject &object) override final;
+                    virtual void drawInstanced(const IObject &object, const float *transforms, std::size_t instanceCount) override final;
+
+                    virtual void execute(const CommandBuffer &buffer) override final;
 
                     virtual void clear() override final;
 
@@ -38,6 +45,8 @@ namespace Amber
 
                 private:
                     GLenum getRenderOptionId(IRenderer::RenderOption renderOption) const;
+                    void setConstant(IProgram &program, const CommandBuffer &buffer, const CommandBuffer::Command &command);
+                    void drawVertexArray(const OpenGL4VertexArray &vertexArray, const IObject &object, std::size_t instanceCount);
 
                     OpenGL4Context context;
             };
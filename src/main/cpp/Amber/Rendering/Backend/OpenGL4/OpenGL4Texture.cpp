@@ -1,5 +1,6 @@
 #include "OpenGL4Texture.h"
 
+#include <algorithm>
 #include <cassert>
 #include <stdexcept>
 
@@ -124,6 +125,11 @@ namespace Amber
                 return type;
             }
 
+            ITexture::DataFormat OpenGL4Texture::getDataFormat() const
+            {
+                return dataFormat;
+            }
+
             void OpenGL4Texture::setSize(std::size_t width, std::size_t height, std::size_t depth)
             {
                 this->width = width;
@@ -196,6 +202,34 @@ namespace Amber
                 unbind();
             }
 
+            std::size_t OpenGL4Texture::getImageDataSize() const
+            {
+                std::size_t size = getPixelSize(dataFormat) * std::max<std::size_t>(width, 1) * std::max<std::size_t>(height, 1) * std::max<std::size_t>(depth, 1);
+                return type == Type::TextureCube ? 6 * size : size;
+            }
+
+            void OpenGL4Texture::getImageData(std::uint8_t *data)
+            {
+                GLenum format = getGLFormat(dataFormat);
+                GLenum pixelType = getGLPixelType(dataFormat);
+
+                bind();
+                glPixelStorei(GL_PACK_ALIGNMENT, 1);
+                if (type == Type::TextureCube)
+                {
+                    std::size_t stride = getImageDataSize() / 6;
+                    for (std::size_t side = 0; side < 6; side++)
+                    {
+                        glGetTexImage(GL_TEXTURE_CUBE_MAP_POSITIVE_X + side, 0, format, pixelType, data + side * stride);
+                    }
+                }
+                else
+                {
+                    glGetTexImage(getGLType(type), 0, format, pixelType, data);
+                }
+                unbind();
+            }
+
             void OpenGL4Texture::setFilterMode(ITexture::FilterMode mode)
             {
                 bind();
@@ -361,6 +395,33 @@ namespace Amber
                         throw std::invalid_argument("Unsupported data format.");
                 }
             }
+
+            // Bytes per pixel of the client side data, floats for the half float formats
+            std::size_t OpenGL4Texture::getPixelSize(ITexture::DataFormat dataFormat) const
+            {
+                switch (dataFormat)
+                {
+                    case DataFormat::RGB8:
+                        return 3;
+                    case DataFormat::RGBA8:
+                        return 4;
+                    case DataFormat::RGB16:
+                        return 6;
+                    case DataFormat::RGBA16:
+                        return 8;
+                    case DataFormat::RGB16F:
+                    case DataFormat::RGB32F:
+                        return 12;
+                    case DataFormat::RGBA16F:
+                    case DataFormat::RGBA32F:
+                        return 16;
+                    case DataFormat::Depth32:
+                    case DataFormat::Depth24Stencil8:
+                        return 4;
+                    default:
+                        throw std::invalid_argument("Unsupported data format.");
+                }
+            }
         }
     }
 }
@@ -38,10 +38,15 @@ namespace Amber
                     virtual std::size_t getDepth() const override final;
 
                     virtual Type getType() const override final;
+                    virtual DataFormat getDataFormat() const override final;
 
                     virtual void setSize(std::size_t width = 0, std::size_t height = 0, std::size_t depth = 0) override final;
 
                     virtual void setImageData(const uint8_t *data) override final;
+
+                    virtual std::size_t getImageDataSize() const override final;
+                    virtual void getImageData(std::uint8_t *data) override final;
+
                     virtual void setFilterMode(FilterMode mode) override final;
                     virtual void setWrapMode(WrapMode mode) override final;
 
@@ -51,6 +56,7 @@ namespace Amber
                     GLenum getGLFormat(DataFormat format) const;
                     GLenum getGLPixelType(DataFormat dataFormat) const;
                     std::size_t getChannels(DataFormat dataFormat) const;
+                    std::size_t getPixelSize(DataFormat dataFormat) const;
 
                     Type type;
                     DataFormat dataFormat;
@@ -1,5 +1,7 @@
 #include "OpenGL4VertexArray.h"
 
+#include <algorithm>
+
 #include "Amber/Rendering/Backend/VertexTypes.h"
 #include "OpenGL4Includes.h"
 #include "OpenGL4Buffer.h"
@@ -21,6 +23,7 @@ namespace Amber
                 : OpenGL4Object(other.handle),
                   vertexBuffer(other.vertexBuffer),
                   indexBuffer(other.indexBuffer),
+                  instanceBuffer(std::move(other.instanceBuffer)),
                   layout(std::move(other.layout))
             {
                 other.handle = 0;
@@ -41,6 +44,7 @@ namespace Amber
                     handle = other.handle;
                     vertexBuffer = other.vertexBuffer;
                     indexBuffer = other.indexBuffer;
+                    instanceBuffer = std::move(other.instanceBuffer);
                     layout = std::move(other.layout);
 
                     other.handle = 0;
@@ -90,19 +94,43 @@ namespace Amber
                     indexBuffer->bind();
                 }
 
-                std::size_t stride = layout.getTotalStride();
+                pointAttributes(false);
+                if (instanceBuffer)
+                {
+                    instanceBuffer->bind();
+                    pointAttributes(true);
+                }
+                unbind();
+            }
+
+            void OpenGL4VertexArray::pointAttributes(bool perInstance)
+            {
+                // Reads from the buffer bound as the array buffer
+                std::size_t stride = perInstance ? layout.getInstanceStride() : layout.getTotalStride();
                 for (std::size_t i = 0; i < layout.getAttributeCount(); i++)
                 {
                     const Layout::Attribute &attribute = layout.getAttributes().at(i);
-                    glVertexAttribPointer(i, // FIXME probably not proper
-                                          attribute.getCount(),
-                                          getGLComponentType(attribute.getType()),
-                                          attribute.getType() != Layout::ComponentType::Float,
-                                          stride,
-                                          reinterpret_cast<const void *>(layout.getOffset(i)));
-                    glEnableVertexAttribArray(i); // FIXME probably not proper
+                    if (attribute.isPerInstance() != perInstance)
+                    {
+                        continue;
+                    }
+
+                    // Locations hold four components, a matrix takes one per column
+                    GLuint location = layout.getLocation(i);
+                    std::size_t offset = layout.getOffset(i);
+                    for (std::size_t column = 0; column < attribute.getLocationCount(); column++)
+                    {
+                        std::size_t count = std::min<std::size_t>(4, attribute.getCount() - 4 * column);
+                        glVertexAttribPointer(location + column,
+                                              count,
+                                              getGLComponentType(attribute.getType()),
+                                              attribute.getType() != Layout::ComponentType::Float,
+                                              stride,
+                                              reinterpret_cast<const void *>(offset + 4 * column * attribute.getStride()));
+                        glVertexAttribDivisor(location + column, attribute.getDivisor());
+                        glEnableVertexAttribArray(location + column);
+                    }
                 }
-                unbind();
             }
 
             GLenum OpenGL4VertexArray::getGLComponentType(Layout::ComponentType type) const
@@ -136,6 +164,22 @@ namespace Amber
                 return layout;
             }
 
+            void OpenGL4VertexArray::assignInstances(const void *data, std::size_t size)
+            {
+                if (!instanceBuffer || instanceBuffer->getCapacity() < size)
+                {
+                    // Grown geometrically; attributes keep pointing at the buffer
+                    // they were specified with, so they are pointed at the new one
+                    std::size_t capacity = std::max(size, instanceBuffer ? 2 * instanceBuffer->getCapacity() : 0);
+                    instanceBuffer.reset(new OpenGL4Buffer(IBuffer::Type::Vertex, capacity, nullptr,
+                                                           OpenGL4Buffer::UsagePattern::StreamDraw));
+                    instanceBuffer->bind();
+                    pointAttributes(true);
+                }
+
+                instanceBuffer->assign(0, size, data);
+            }
+
             void OpenGL4VertexArray::setLayout(Layout layout)
             {
                 bool deleteNeeded = !this->layout.getAttributes().empty();
@@ -4,6 +4,9 @@
 #include "Amber/Rendering/Backend/IBindable.h"
 #include "Amber/Rendering/Backend/OpenGL4/OpenGL4Object.h"
 
+#include <cstddef>
+#include <memory>
+
 #include "Amber/Rendering/Backend/Layout.h"
 #include "Amber/Rendering/Backend/Reference.h"
 #include "Amber/Rendering/Backend/OpenGL4/OpenGL4Includes.h"
@@ -38,12 +41,19 @@ namespace Amber
                     const Layout &getLayout() const;
                     void setLayout(Layout layout);
 
+                    // Replaces the data of the layout's per-instance attributes,
+                    // which the vertex array keeps in a buffer of its own. The
+                    // vertex array must be bound.
+                    void assignInstances(const void *data, std::size_t size);
+
                 private:
                     void reset(bool deleteNeeded);
+                    void pointAttributes(bool perInstance);
                     GLenum getGLComponentType(Layout::ComponentType type) const;
 
                     Reference<OpenGL4Buffer> vertexBuffer;
                     Reference<OpenGL4Buffer> indexBuffer;
+                    std::unique_ptr<OpenGL4Buffer> instanceBuffer;
                     Layout layout;
             };
         }
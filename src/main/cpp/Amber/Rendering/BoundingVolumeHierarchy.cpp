@@ -0,0 +1,680 @@
+#include "BoundingVolumeHierarchy.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+#include "Amber/Utilities/FrameArena.h"
+
+namespace Amber
+{
+    namespace Rendering
+    {
+        namespace
+        {
+            const std::size_t BinCount = 12;
+            const std::size_t MaxLeafSize = 4;
+
+            // Boxes are enlarged by this much of their size, and at least the minimum
+            const float MarginRatio = 0.1f;
+            const float MinimumMargin = 0.05f;
+
+            enum Overlap
+            {
+                Outside,
+                Intersects,
+                Inside
+            };
+
+            bool isBounded(const Math::BoundingBox &box)
+            {
+                return box.min.allFinite() && box.max.allFinite();
+            }
+
+            bool contains(const Math::BoundingBox &outer, const Math::BoundingBox &inner)
+            {
+                return (outer.min.array() <= inner.min.array()).all() && (inner.max.array() <= outer.max.array()).all();
+            }
+
+            void merge(Math::BoundingBox &box, const Math::BoundingBox &other)
+            {
+                box.min = box.min.cwiseMin(other.min);
+                box.max = box.max.cwiseMax(other.max);
+            }
+
+            float getArea(const Math::BoundingBox &box)
+            {
+                if (box.isEmpty())
+                {
+                    return 0.0f;
+                }
+
+                Eigen::Vector3f size = box.max - box.min;
+                return 2.0f * (size.x() * size.y() + size.y() * size.z() + size.z() * size.x());
+            }
+
+            Math::BoundingBox enlarge(const Math::BoundingBox &box)
+            {
+                if (box.isEmpty() || !isBounded(box))
+                {
+                    return box;
+                }
+
+                Eigen::Vector3f margin = ((box.max - box.min) * MarginRatio).array() + MinimumMargin;
+                return Math::BoundingBox { box.min - margin, box.max + margin };
+            }
+
+            Overlap classify(const Math::Frustum &frustum, const Math::BoundingBox &box)
+            {
+                if (box.isEmpty())
+                {
+                    return Outside;
+                }
+
+                Eigen::Vector3f center = box.getCenter();
+                Eigen::Vector3f extents = box.getExtents();
+
+                Overlap overlap = Inside;
+                for (int i = 0; i < Math::Frustum::PlaneCount; i++)
+                {
+                    const Eigen::Vector4f &plane = frustum.getPlane(static_cast<Math::Frustum::Plane>(i));
+                    float radius = plane.head<3>().cwiseAbs().dot(extents);
+                    float distance = plane.head<3>().dot(center) + plane.w();
+
+                    if (distance < -radius)
+                    {
+                        return Outside;
+                    }
+
+                    // Unbounded boxes have no meaningful center, never call them inside
+                    if (!(distance >= radius))
+                    {
+                        overlap = Intersects;
+                    }
+                }
+
+                return overlap;
+            }
+
+            Overlap classify(const Math::BoundingSphere &sphere, const Math::BoundingBox &box)
+            {
+                if (box.isEmpty() || sphere.isEmpty())
+                {
+                    return Outside;
+                }
+
+                Eigen::Vector3f closest = sphere.center.cwiseMax(box.min).cwiseMin(box.max);
+                return (closest - sphere.center).squaredNorm() <= sphere.radius * sphere.radius ? Intersects : Outside;
+            }
+
+            // Distance at which the ray enters the box, or a negative one when it misses
+            float intersect(const Eigen::Vector3f &origin, const Eigen::Vector3f &inverseDirection, float maxDistance,
+                            const Math::BoundingBox &box)
+            {
+                if (box.isEmpty())
+                {
+                    return -1.0f;
+                }
+
+                float entry = 0.0f;
+                float exit = maxDistance;
+                for (int axis = 0; axis < 3; axis++)
+                {
+                    float t0 = (box.min[axis] - origin[axis]) * inverseDirection[axis];
+                    float t1 = (box.max[axis] - origin[axis]) * inverseDirection[axis];
+                    if (t0 > t1)
+                    {
+                        std::swap(t0, t1);
+                    }
+
+                    // NaN from a zero direction inside the slab keeps the bounds
+                    entry = t0 > entry ? t0 : entry;
+                    exit = t1 < exit ? t1 : exit;
+                    if (entry > exit)
+                    {
+                        return -1.0f;
+                    }
+                }
+
+                return entry;
+            }
+        }
+
+        struct BoundingVolumeHierarchy::Build
+        {
+            std::vector<Math::BoundingBox> boxes;
+            std::vector<Proxy> ids;
+            Tree tree;
+            Utilities::JobSystem::Counter counter;
+        };
+
+        BoundingVolumeHierarchy::BoundingVolumeHierarchy()
+            : aliveCount(0), refitCount(0), buildJobSystem(nullptr)
+        {
+        }
+
+        BoundingVolumeHierarchy::~BoundingVolumeHierarchy()
+        {
+            // A running build owns its data, so it can finish on its own
+        }
+
+        BoundingVolumeHierarchy::Proxy BoundingVolumeHierarchy::createProxy(const Math::BoundingBox &box,
+                                                                            std::uint32_t userData)
+        {
+            Proxy proxy;
+            if (freeProxies.empty())
+            {
+                proxy = static_cast<Proxy>(proxies.size());
+                proxies.emplace_back();
+            }
+            else
+            {
+                proxy = freeProxies.back();
+                freeProxies.pop_back();
+            }
+
+            ProxyData &data = proxies[proxy];
+            data.box = enlarge(box);
+            data.userData = userData;
+            data.leaf = None;
+            data.alive = true;
+
+            outsideProxies.push_back(proxy);
+            aliveCount++;
+
+            return proxy;
+        }
+
+        void BoundingVolumeHierarchy::destroyProxy(Proxy proxy)
+        {
+            ProxyData &data = proxies.at(proxy);
+            if (!data.alive)
+            {
+                throw std::invalid_argument("Destroying a destroyed proxy.");
+            }
+
+            data.alive = false;
+            aliveCount--;
+
+            if (data.leaf == None)
+            {
+                auto found = std::find(outsideProxies.begin(), outsideProxies.end(), proxy);
+                if (found != outsideProxies.end())
+                {
+                    *found = outsideProxies.back();
+                    outsideProxies.pop_back();
+                }
+            }
+
+            // The tree or a running build may still refer to it
+            if (data.leaf == None && !pendingBuild)
+            {
+                freeProxies.push_back(proxy);
+            }
+            else
+            {
+                destroyedProxies.push_back(proxy);
+            }
+        }
+
+        bool BoundingVolumeHierarchy::moveProxy(Proxy proxy, const Math::BoundingBox &box)
+        {
+            ProxyData &data = proxies.at(proxy);
+            if (!box.isEmpty() && contains(data.box, box))
+            {
+                return false;
+            }
+
+            data.box = enlarge(box);
+            if (data.leaf != None)
+            {
+                if (!dirtyFlags[data.leaf])
+                {
+                    dirtyFlags[data.leaf] = true;
+                    dirtyLeaves.push_back(data.leaf);
+                }
+
+                refitCount++;
+            }
+
+            return true;
+        }
+
+        const Math::BoundingBox &BoundingVolumeHierarchy::getBox(Proxy proxy) const
+        {
+            return proxies.at(proxy).box;
+        }
+
+        std::uint32_t BoundingVolumeHierarchy::getUserData(Proxy proxy) const
+        {
+            return proxies.at(proxy).userData;
+        }
+
+        void BoundingVolumeHierarchy::update(Utilities::JobSystem *jobSystem)
+        {
+            refit();
+
+            if (pendingBuild && pendingBuild->counter.isDone())
+            {
+                std::shared_ptr<Build> finished = std::move(pendingBuild);
+                install(finished->tree);
+            }
+
+            if (pendingBuild || !isRebuildDue())
+            {
+                return;
+            }
+
+            if (jobSystem == nullptr)
+            {
+                rebuild();
+                return;
+            }
+
+            std::shared_ptr<Build> build = snapshot();
+            pendingBuild = build;
+            buildJobSystem = jobSystem;
+
+            jobSystem->submit([build]()
+            {
+                BoundingVolumeHierarchy::build(build->boxes, build->ids, build->tree);
+            }, build->counter);
+        }
+
+        void BoundingVolumeHierarchy::rebuild()
+        {
+            if (pendingBuild)
+            {
+                buildJobSystem->wait(pendingBuild->counter);
+                pendingBuild.reset();
+            }
+
+            refit();
+
+            std::shared_ptr<Build> build = snapshot();
+            BoundingVolumeHierarchy::build(build->boxes, build->ids, build->tree);
+            install(build->tree);
+        }
+
+        std::size_t BoundingVolumeHierarchy::getProxyCount() const
+        {
+            return aliveCount;
+        }
+
+        std::size_t BoundingVolumeHierarchy::getNodeCount() const
+        {
+            return tree.nodes.size();
+        }
+
+        void BoundingVolumeHierarchy::query(const Math::Frustum &frustum,
+                                            const std::function<void(std::uint32_t)> &visit) const
+        {
+            traverse([&frustum](const Math::BoundingBox &box)
+            {
+                return classify(frustum, box);
+            },
+            [&visit](const ProxyData &data)
+            {
+                visit(data.userData);
+            });
+        }
+
+        void BoundingVolumeHierarchy::query(const Math::BoundingSphere &sphere,
+                                            const std::function<void(std::uint32_t)> &visit) const
+        {
+            traverse([&sphere](const Math::BoundingBox &box)
+            {
+                return classify(sphere, box);
+            },
+            [&visit](const ProxyData &data)
+            {
+                visit(data.userData);
+            });
+        }
+
+        void BoundingVolumeHierarchy::raycast(const Eigen::Vector3f &origin, const Eigen::Vector3f &direction,
+                                              float maxDistance,
+                                              const std::function<void(std::uint32_t, float)> &visit) const
+        {
+            const Eigen::Vector3f inverseDirection = direction.cwiseInverse();
+
+            traverse([&](const Math::BoundingBox &box)
+            {
+                return intersect(origin, inverseDirection, maxDistance, box) >= 0.0f ? Intersects : Outside;
+            },
+            [&](const ProxyData &data)
+            {
+                visit(data.userData, intersect(origin, inverseDirection, maxDistance, data.box));
+            });
+        }
+
+        void BoundingVolumeHierarchy::build(std::vector<Math::BoundingBox> &boxes, std::vector<Proxy> &ids, Tree &tree)
+        {
+            tree.nodes.clear();
+            tree.leafProxies.clear();
+            if (ids.empty())
+            {
+                return;
+            }
+
+            // A binary tree with leaves of at least one proxy has fewer than
+            // twice as many nodes
+            tree.nodes.reserve(2 * ids.size());
+            tree.leafProxies.reserve(ids.size());
+
+            tree.nodes.push_back(Node { Math::BoundingBox::empty(), None, 0, 0 });
+            buildNode(boxes, ids, 0, ids.size(), 0, tree);
+        }
+
+        void BoundingVolumeHierarchy::buildNode(std::vector<Math::BoundingBox> &boxes, std::vector<Proxy> &ids,
+                                                std::size_t begin, std::size_t end, std::uint32_t node, Tree &tree)
+        {
+            Math::BoundingBox bounds = Math::BoundingBox::empty();
+            Math::BoundingBox centers = Math::BoundingBox::empty();
+            for (std::size_t i = begin; i < end; i++)
+            {
+                merge(bounds, boxes[i]);
+
+                Eigen::Vector3f center = boxes[i].getCenter();
+                centers.min = centers.min.cwiseMin(center);
+                centers.max = centers.max.cwiseMax(center);
+            }
+
+            tree.nodes[node].box = bounds;
+
+            std::size_t count = end - begin;
+            std::size_t middle = begin + count / 2;
+
+            int axis;
+            (centers.max - centers.min).maxCoeff(&axis);
+            float low = centers.min[axis];
+            float extent = centers.max[axis] - low;
+
+            if (count <= MaxLeafSize)
+            {
+                middle = end;
+            }
+            else if (extent > 0.0f)
+            {
+                // Bin the centers along the widest axis and take the split
+                // between bins with the least area weighted by proxy count
+                std::array<Math::BoundingBox, BinCount> binBoxes;
+                std::array<std::size_t, BinCount> binCounts;
+                binBoxes.fill(Math::BoundingBox::empty());
+                binCounts.fill(0);
+
+                const float scale = BinCount / extent;
+                auto getBin = [&](std::size_t i)
+                {
+                    std::size_t bin = static_cast<std::size_t>((boxes[i].getCenter()[axis] - low) * scale);
+                    return std::min(bin, BinCount - 1);
+                };
+
+                for (std::size_t i = begin; i < end; i++)
+                {
+                    std::size_t bin = getBin(i);
+                    merge(binBoxes[bin], boxes[i]);
+                    binCounts[bin]++;
+                }
+
+                std::array<float, BinCount> rightCosts;
+                Math::BoundingBox right = Math::BoundingBox::empty();
+                std::size_t rightCount = 0;
+                for (std::size_t bin = BinCount - 1; bin > 0; bin--)
+                {
+                    merge(right, binBoxes[bin]);
+                    rightCount += binCounts[bin];
+                    rightCosts[bin] = getArea(right) * rightCount;
+                }
+
+                float bestCost = std::numeric_limits<float>::infinity();
+                std::size_t bestBin = 0;
+                Math::BoundingBox left = Math::BoundingBox::empty();
+                std::size_t leftCount = 0;
+                for (std::size_t bin = 0; bin + 1 < BinCount; bin++)
+                {
+                    merge(left, binBoxes[bin]);
+                    leftCount += binCounts[bin];
+
+                    float cost = getArea(left) * leftCount + rightCosts[bin + 1];
+                    if (cost < bestCost)
+                    {
+                        bestCost = cost;
+                        bestBin = bin;
+                    }
+                }
+
+                // Partition both arrays by the chosen bin
+                std::size_t split = begin;
+                for (std::size_t i = begin; i < end; i++)
+                {
+                    if (getBin(i) <= bestBin)
+                    {
+                        std::swap(boxes[i], boxes[split]);
+                        std::swap(ids[i], ids[split]);
+                        split++;
+                    }
+                }
+
+                if (split != begin && split != end)
+                {
+                    middle = split;
+                }
+            }
+
+            if (middle == end)
+            {
+                tree.nodes[node].first = static_cast<std::uint32_t>(tree.leafProxies.size());
+                tree.nodes[node].count = static_cast<std::uint32_t>(count);
+                tree.leafProxies.insert(tree.leafProxies.end(), ids.begin() + begin, ids.begin() + end);
+                return;
+            }
+
+            // Children are allocated side by side
+            std::uint32_t first = static_cast<std::uint32_t>(tree.nodes.size());
+            tree.nodes[node].first = first;
+            tree.nodes[node].count = 0;
+            tree.nodes.push_back(Node { Math::BoundingBox::empty(), node, 0, 0 });
+            tree.nodes.push_back(Node { Math::BoundingBox::empty(), node, 0, 0 });
+
+            buildNode(boxes, ids, begin, middle, first, tree);
+            buildNode(boxes, ids, middle, end, first + 1, tree);
+        }
+
+        std::shared_ptr<BoundingVolumeHierarchy::Build> BoundingVolumeHierarchy::snapshot() const
+        {
+            std::shared_ptr<Build> build = std::make_shared<Build>();
+            build->boxes.reserve(aliveCount);
+            build->ids.reserve(aliveCount);
+
+            for (std::size_t i = 0; i < proxies.size(); i++)
+            {
+                if (proxies[i].alive && isBounded(proxies[i].box))
+                {
+                    build->boxes.push_back(proxies[i].box);
+                    build->ids.push_back(static_cast<Proxy>(i));
+                }
+            }
+
+            return build;
+        }
+
+        void BoundingVolumeHierarchy::install(Tree &builtTree)
+        {
+            tree = std::move(builtTree);
+
+            for (ProxyData &data : proxies)
+            {
+                data.leaf = None;
+            }
+
+            for (std::size_t i = 0; i < tree.nodes.size(); i++)
+            {
+                const Node &node = tree.nodes[i];
+                for (std::uint32_t j = 0; j < node.count; j++)
+                {
+                    proxies[tree.leafProxies[node.first + j]].leaf = static_cast<std::uint32_t>(i);
+                }
+            }
+
+            // Proxies may have moved while the tree was built. Children always
+            // come after their parent, so one backwards pass refits everything.
+            for (std::size_t i = tree.nodes.size(); i > 0; i--)
+            {
+                refitNode(static_cast<std::uint32_t>(i - 1));
+            }
+
+            outsideProxies.clear();
+            for (std::size_t i = 0; i < proxies.size(); i++)
+            {
+                if (proxies[i].alive && proxies[i].leaf == None)
+                {
+                    outsideProxies.push_back(static_cast<Proxy>(i));
+                }
+            }
+
+            std::size_t kept = 0;
+            for (Proxy proxy : destroyedProxies)
+            {
+                if (proxies[proxy].leaf == None)
+                {
+                    freeProxies.push_back(proxy);
+                }
+                else
+                {
+                    destroyedProxies[kept++] = proxy;
+                }
+            }
+
+            destroyedProxies.resize(kept);
+
+            dirtyLeaves.clear();
+            dirtyFlags.assign(tree.nodes.size(), false);
+            refitCount = 0;
+        }
+
+        void BoundingVolumeHierarchy::refit()
+        {
+            for (std::uint32_t leaf : dirtyLeaves)
+            {
+                dirtyFlags[leaf] = false;
+
+                // Walk up until a box stops changing
+                for (std::uint32_t node = leaf; node != None; node = tree.nodes[node].parent)
+                {
+                    Math::BoundingBox previous = tree.nodes[node].box;
+                    refitNode(node);
+
+                    if (node != leaf && tree.nodes[node].box.min == previous.min && tree.nodes[node].box.max == previous.max)
+                    {
+                        break;
+                    }
+                }
+            }
+
+            dirtyLeaves.clear();
+        }
+
+        void BoundingVolumeHierarchy::refitNode(std::uint32_t node)
+        {
+            Node &data = tree.nodes[node];
+            Math::BoundingBox box = Math::BoundingBox::empty();
+
+            if (data.count == 0)
+            {
+                merge(box, tree.nodes[data.first].box);
+                merge(box, tree.nodes[data.first + 1].box);
+            }
+            else
+            {
+                for (std::uint32_t i = 0; i < data.count; i++)
+                {
+                    const ProxyData &proxy = proxies[tree.leafProxies[data.first + i]];
+                    if (proxy.alive)
+                    {
+                        merge(box, proxy.box);
+                    }
+                }
+            }
+
+            data.box = box;
+        }
+
+        bool BoundingVolumeHierarchy::isRebuildDue() const
+        {
+            if (!destroyedProxies.empty() || refitCount > aliveCount / 4)
+            {
+                return true;
+            }
+
+            // Unbounded proxies stay outside however often the tree is rebuilt
+            for (Proxy proxy : outsideProxies)
+            {
+                if (isBounded(proxies[proxy].box))
+                {
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        template <typename Test, typename Visit>
+        void BoundingVolumeHierarchy::traverse(Test test, Visit visit) const
+        {
+            for (Proxy proxy : outsideProxies)
+            {
+                if (test(proxies[proxy].box) != Outside)
+                {
+                    visit(proxies[proxy]);
+                }
+            }
+
+            if (tree.nodes.empty())
+            {
+                return;
+            }
+
+            // Pairs of a node and whether it is known to be fully inside
+            Utilities::FrameVector<std::pair<std::uint32_t, bool>> stack;
+            stack.emplace_back(0, false);
+
+            while (!stack.empty())
+            {
+                std::uint32_t index = stack.back().first;
+                bool inside = stack.back().second;
+                stack.pop_back();
+
+                const Node &node = tree.nodes[index];
+                if (!inside)
+                {
+                    Overlap overlap = test(node.box);
+                    if (overlap == Outside)
+                    {
+                        continue;
+                    }
+
+                    inside = overlap == Inside;
+                }
+
+                if (node.count == 0)
+                {
+                    stack.emplace_back(node.first + 1, inside);
+                    stack.emplace_back(node.first, inside);
+                    continue;
+                }
+
+                for (std::uint32_t i = 0; i < node.count; i++)
+                {
+                    const ProxyData &proxy = proxies[tree.leafProxies[node.first + i]];
+                    if (proxy.alive && (inside || test(proxy.box) != Outside))
+                    {
+                        visit(proxy);
+                    }
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,131 @@
+#ifndef BOUNDINGVOLUMEHIERARCHY_H
+#define BOUNDINGVOLUMEHIERARCHY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "Amber/Math/Bounds.h"
+#include "Amber/Math/Frustum.h"
+#include "Amber/Utilities/JobSystem.h"
+
+namespace Amber
+{
+    namespace Rendering
+    {
+        // Spatial index over boxes that move every frame. Each proxy keeps a box
+        // slightly larger than the one it was given, so small moves change
+        // nothing and larger ones only refit the boxes above its leaf. The tree
+        // itself is rebuilt with binned SAH splits, on the job system while
+        // the old one keeps answering queries.
+        //
+        // Proxies created since the last rebuild, and those with unbounded boxes,
+        // are kept outside the tree and tested one by one. All calls must come
+        // from one thread.
+        class BoundingVolumeHierarchy
+        {
+            public:
+                typedef std::uint32_t Proxy;
+
+                BoundingVolumeHierarchy();
+                BoundingVolumeHierarchy(const BoundingVolumeHierarchy &other) = delete;
+                ~BoundingVolumeHierarchy();
+
+                BoundingVolumeHierarchy &operator =(const BoundingVolumeHierarchy &other) = delete;
+
+                // userData is what queries report for the proxy
+                Proxy createProxy(const Math::BoundingBox &box, std::uint32_t userData);
+                void destroyProxy(Proxy proxy);
+
+                // Returns whether the box left the proxy's enlarged one
+                bool moveProxy(Proxy proxy, const Math::BoundingBox &box);
+
+                const Math::BoundingBox &getBox(Proxy proxy) const;
+                std::uint32_t getUserData(Proxy proxy) const;
+
+                // Refits moved proxies, installs a finished rebuild and starts the
+                // next one when enough has changed. Without a job system the
+                // rebuild happens right away.
+                void update(Utilities::JobSystem *jobSystem = nullptr);
+
+                // Rebuilds the tree on the calling thread
+                void rebuild();
+
+                std::size_t getProxyCount() const;
+                std::size_t getNodeCount() const;
+
+                // Visit the user data of every proxy whose box may intersect
+                void query(const Math::Frustum &frustum, const std::function<void(std::uint32_t)> &visit) const;
+                void query(const Math::BoundingSphere &sphere, const std::function<void(std::uint32_t)> &visit) const;
+
+                // Visits the user data of every proxy whose box the ray enters
+                // within maxDistance, with the distance at which it does
+                void raycast(const Eigen::Vector3f &origin, const Eigen::Vector3f &direction, float maxDistance,
+                             const std::function<void(std::uint32_t, float)> &visit) const;
+
+            private:
+                static const std::uint32_t None = std::numeric_limits<std::uint32_t>::max();
+
+                // Inner nodes have count 0 and their children at first and first
+                // + 1, leaves own count entries of the leaf proxy array from first
+                struct Node
+                {
+                    Math::BoundingBox box;
+                    std::uint32_t parent;
+                    std::uint32_t first;
+                    std::uint32_t count;
+                };
+
+                struct Tree
+                {
+                    std::vector<Node> nodes;
+                    std::vector<Proxy> leafProxies;
+                };
+
+                struct ProxyData
+                {
+                    Math::BoundingBox box;
+                    std::uint32_t userData;
+                    std::uint32_t leaf;
+                    bool alive;
+                };
+
+                struct Build;
+
+                // Builds over the boxes of the given proxies, reordering both
+                static void build(std::vector<Math::BoundingBox> &boxes, std::vector<Proxy> &ids, Tree &tree);
+                static void buildNode(std::vector<Math::BoundingBox> &boxes, std::vector<Proxy> &ids,
+                                      std::size_t begin, std::size_t end, std::uint32_t node, Tree &tree);
+
+                std::shared_ptr<Build> snapshot() const;
+                void install(Tree &builtTree);
+                void refit();
+                void refitNode(std::uint32_t node);
+                bool isRebuildDue() const;
+
+                template <typename Test, typename Visit>
+                void traverse(Test test, Visit visit) const;
+
+                std::vector<ProxyData> proxies;
+                std::vector<Proxy> freeProxies;
+                std::vector<Proxy> destroyedProxies;
+                std::vector<Proxy> outsideProxies;
+                std::size_t aliveCount;
+
+                Tree tree;
+                std::vector<std::uint32_t> dirtyLeaves;
+                std::vector<bool> dirtyFlags;
+                std::size_t refitCount;
+
+                std::shared_ptr<Build> pendingBuild;
+                Utilities::JobSystem *buildJobSystem;
+        };
+    }
+}
+
+#endif // BOUNDINGVOLUMEHIERARCHY_H
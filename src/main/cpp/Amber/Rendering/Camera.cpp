@@ -57,5 +57,10 @@ namespace Amber
         {
             return projectionMatrix;
         }
+
+        Math::Frustum Camera::getFrustum() const
+        {
+            return Math::Frustum::fromMatrix(projectionMatrix * viewMatrix);
+        }
     }
 }
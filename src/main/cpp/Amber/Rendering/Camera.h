@@ -3,6 +3,8 @@
 
 #include <Eigen/Core>
 
+#include "Amber/Math/Frustum.h"
+
 namespace Amber
 {
     namespace Rendering
@@ -19,6 +21,9 @@ namespace Amber
                 const Eigen::Matrix4f &getViewMatrix() const;
                 const Eigen::Matrix4f &getProjectionMatrix() const;
 
+                // The view volume in world space
+                Math::Frustum getFrustum() const;
+
             private:
                 Eigen::Matrix4f viewMatrix;
                 Eigen::Matrix4f projectionMatrix;
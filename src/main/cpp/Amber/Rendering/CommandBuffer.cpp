@@ -0,0 +1,131 @@
+#include "CommandBuffer.h"
+
+#include <stdexcept>
+
+namespace Amber
+{
+    namespace Rendering
+    {
+        CommandBuffer::CommandBuffer()
+        {
+        }
+
+        CommandBuffer::~CommandBuffer()
+        {
+        }
+
+        void CommandBuffer::bindProgram(IProgram *program)
+        {
+            commands.push_back(Command { CommandType::BindProgram, ConstantType::Int, 0, program, 0, 0, 0 });
+        }
+
+        void CommandBuffer::bindTexture(std::uint32_t slot, ITexture *texture)
+        {
+            if (slot >= MaxTextureSlots)
+            {
+                throw std::out_of_range("Texture slot out of range");
+            }
+
+            commands.push_back(Command { CommandType::BindTexture, ConstantType::Int, slot, texture, 0, 0, 0 });
+        }
+
+        void CommandBuffer::bindVertexArray(IBindable *vertexArray)
+        {
+            commands.push_back(Command { CommandType::BindVertexArray, ConstantType::Int, 0, vertexArray, 0, 0, 0 });
+        }
+
+        void CommandBuffer::setConstant(const std::string &name, std::int32_t value)
+        {
+            addConstant(name, ConstantType::Int, &value, sizeof(value));
+        }
+
+        void CommandBuffer::setConstant(const std::string &name, std::uint32_t value)
+        {
+            addConstant(name, ConstantType::UnsignedInt, &value, sizeof(value));
+        }
+
+        void CommandBuffer::setConstant(const std::string &name, float value)
+        {
+            addConstant(name, ConstantType::Float, &value, sizeof(value));
+        }
+
+        void CommandBuffer::setConstant(const std::string &name, const Eigen::Vector2f &value)
+        {
+            addConstant(name, ConstantType::Vector2, value.data(), sizeof(float) * 2);
+        }
+
+        void CommandBuffer::setConstant(const std::string &name, const Eigen::Vector3f &value)
+        {
+            addConstant(name, ConstantType::Vector3, value.data(), sizeof(float) * 3);
+        }
+
+        void CommandBuffer::setConstant(const std::string &name, const Eigen::Vector4f &value)
+        {
+            addConstant(name, ConstantType::Vector4, value.data(), sizeof(float) * 4);
+        }
+
+        void CommandBuffer::setConstant(const std::string &name, const Eigen::Matrix3f &value)
+        {
+            addConstant(name, ConstantType::Matrix3, value.data(), sizeof(float) * 9);
+        }
+
+        void CommandBuffer::setConstant(const std::string &name, const Eigen::Matrix4f &value)
+        {
+            addConstant(name, ConstantType::Matrix4, value.data(), sizeof(float) * 16);
+        }
+
+        void CommandBuffer::draw(const IObject &object)
+        {
+            commands.push_back(Command { CommandType::Draw, ConstantType::Int, 0, &object, 0, 0, 0 });
+        }
+
+        void CommandBuffer::drawInstanced(const IObject &object, const Eigen::Matrix4f *transforms, std::uint32_t instanceCount)
+        {
+            std::uint32_t dataOffset = static_cast<std::uint32_t>(data.size());
+            const std::uint8_t *bytes = reinterpret_cast<const std::uint8_t *>(transforms);
+            data.insert(data.end(), bytes, bytes + sizeof(float) * 16 * instanceCount);
+
+            commands.push_back(Command { CommandType::DrawInstanced, ConstantType::Int, 0, &object, 0, dataOffset, instanceCount });
+        }
+
+        void CommandBuffer::clear()
+        {
+            commands.clear();
+            names.clear();
+            data.clear();
+        }
+
+        bool CommandBuffer::isEmpty() const
+        {
+            return commands.empty();
+        }
+
+        const std::vector<CommandBuffer::Command> &CommandBuffer::getCommands() const
+        {
+            return commands;
+        }
+
+        const char *CommandBuffer::getConstantName(const Command &command) const
+        {
+            return names.data() + command.nameOffset;
+        }
+
+        const float *CommandBuffer::getInstanceTransforms(const Command &command) const
+        {
+            // Everything in the data is made of 4-byte values, so this stays aligned
+            return reinterpret_cast<const float *>(data.data() + command.dataOffset);
+        }
+
+        void CommandBuffer::addConstant(const std::string &name, ConstantType type, const void *value, std::size_t size)
+        {
+            std::uint32_t nameOffset = static_cast<std::uint32_t>(names.size());
+            names.insert(names.end(), name.c_str(), name.c_str() + name.size() + 1);
+
+            std::uint32_t dataOffset = static_cast<std::uint32_t>(data.size());
+            const std::uint8_t *bytes = static_cast<const std::uint8_t *>(value);
+            data.insert(data.end(), bytes, bytes + size);
+
+            commands.push_back(Command { CommandType::SetConstant, type, 0, nullptr, nameOffset, dataOffset, 0 });
+        }
+    }
+}
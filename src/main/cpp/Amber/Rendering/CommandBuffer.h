@@ -0,0 +1,144 @@
+#ifndef COMMANDBUFFER_H
+#define COMMANDBUFFER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "Amber/Rendering/ForwardDeclarations.h"
+
+namespace Amber
+{
+    namespace Rendering
+    {
+        // Draw, bind and set-constant calls recorded as plain data, to be executed
+        // later by a renderer on its context thread. Recording never touches the
+        // graphics API, so buffers can be filled on any thread.
+        //
+        // Objects are referred to by address and must stay alive until the
+        // buffer was executed.
+        class CommandBuffer
+        {
+            public:
+                enum class CommandType : std::uint8_t
+                {
+                    BindProgram,
+                    BindTexture,
+                    BindVertexArray,
+                    SetConstant,
+                    Draw,
+                    DrawInstanced
+                };
+
+                enum class ConstantType : std::uint8_t
+                {
+                    Int,
+                    UnsignedInt,
+                    Float,
+                    Vector2,
+                    Vector3,
+                    Vector4,
+                    Matrix3,
+                    Matrix4
+                };
+
+                // Object is the program, texture, vertex array or drawn object.
+                // Slot is that of a bound texture. Constants keep their name and
+                // value in the buffer's data, as do instanced draws their
+                // transforms, instanceCount of them.
+                struct Command
+                {
+                    CommandType type;
+                    ConstantType constantType;
+                    std::uint32_t slot;
+                    const void *object;
+                    std::uint32_t nameOffset;
+                    std::uint32_t dataOffset;
+                    std::uint32_t instanceCount;
+                };
+
+                // Texture slots a buffer may bind, so renderers can hold them in a
+                // fixed array
+                static const std::uint32_t MaxTextureSlots = 16;
+
+                CommandBuffer();
+                ~CommandBuffer();
+
+                // A null program, texture or vertex array unbinds the slot. Texture
+                // slots must be below MaxTextureSlots.
+                void bindProgram(IProgram *program);
+                void bindTexture(std::uint32_t slot, ITexture *texture);
+                void bindVertexArray(IBindable *vertexArray);
+
+                // Sets a constant of the bound program
+                void setConstant(const std::string &name, std::int32_t value);
+                void setConstant(const std::string &name, std::uint32_t value);
+                void setConstant(const std::string &name, float value);
+                void setConstant(const std::string &name, const Eigen::Vector2f &value);
+                void setConstant(const std::string &name, const Eigen::Vector3f &value);
+                void setConstant(const std::string &name, const Eigen::Vector4f &value);
+                void setConstant(const std::string &name, const Eigen::Matrix3f &value);
+                void setConstant(const std::string &name, const Eigen::Matrix4f &value);
+
+                // Draws the object with whatever is bound
+                void draw(const IObject &object);
+
+                // Draws the object once per transform, which are copied
+                void drawInstanced(const IObject &object, const Eigen::Matrix4f *transforms, std::uint32_t instanceCount);
+
+                // Keeps the memory for the next recording
+                void clear();
+                bool isEmpty() const;
+
+                const std::vector<Command> &getCommands() const;
+
+                const char *getConstantName(const Command &command) const;
+                const float *getInstanceTransforms(const Command &command) const;
+
+                template <typename T>
+                T getConstant(const Command &command) const
+                {
+                    T value;
+                    std::memcpy(value.data(), data.data() + command.dataOffset, sizeof(typename T::Scalar) * T::SizeAtCompileTime);
+                    return value;
+                }
+
+            private:
+                void addConstant(const std::string &name, ConstantType type, const void *value, std::size_t size);
+
+                std::vector<Command> commands;
+                std::vector<char> names;
+                std::vector<std::uint8_t> data;
+        };
+
+        template <>
+        inline std::int32_t CommandBuffer::getConstant<std::int32_t>(const Command &command) const
+        {
+            std::int32_t value;
+            std::memcpy(&value, data.data() + command.dataOffset, sizeof(value));
+            return value;
+        }
+
+        template <>
+        inline std::uint32_t CommandBuffer::getConstant<std::uint32_t>(const Command &command) const
+        {
+            std::uint32_t value;
+            std::memcpy(&value, data.data() + command.dataOffset, sizeof(value));
+            return value;
+        }
+
+        template <>
+        inline float CommandBuffer::getConstant<float>(const Command &command) const
+        {
+            float value;
+            std::memcpy(&value, data.data() + command.dataOffset, sizeof(value));
+            return value;
+        }
+    }
+}
+
+#endif // COMMANDBUFFER_H
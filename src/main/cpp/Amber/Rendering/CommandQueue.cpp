@@ -0,0 +1,71 @@
+#include "CommandQueue.h"
+
+#include <stdexcept>
+
+#include "Amber/Rendering/Backend/IRenderer.h"
+
+namespace Amber
+{
+    namespace Rendering
+    {
+        CommandQueue::CommandQueue()
+            : count(0)
+        {
+        }
+
+        CommandQueue::~CommandQueue()
+        {
+        }
+
+        void CommandQueue::reset(std::size_t count)
+        {
+            while (buffers.size() < count)
+            {
+                buffers.emplace_back(new CommandBuffer());
+            }
+
+            for (std::size_t i = 0; i < count; i++)
+            {
+                buffers[i]->clear();
+            }
+
+            this->count = count;
+        }
+
+        std::size_t CommandQueue::getBufferCount() const
+        {
+            return count;
+        }
+
+        CommandBuffer &CommandQueue::getBuffer(std::size_t index)
+        {
+            if (index >= count)
+            {
+                throw std::out_of_range("Command buffer index out of range");
+            }
+
+            return *buffers[index];
+        }
+
+        const CommandBuffer &CommandQueue::getBuffer(std::size_t index) const
+        {
+            if (index >= count)
+            {
+                throw std::out_of_range("Command buffer index out of range");
+            }
+
+            return *buffers[index];
+        }
+
+        void CommandQueue::submit(IRenderer &renderer) const
+        {
+            for (std::size_t i = 0; i < count; i++)
+            {
+                if (!buffers[i]->isEmpty())
+                {
+                    renderer.execute(*buffers[i]);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,50 @@
+#ifndef COMMANDQUEUE_H
+#define COMMANDQUEUE_H
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "Amber/Rendering/CommandBuffer.h"
+#include "Amber/Rendering/ForwardDeclarations.h"
+
+namespace Amber
+{
+    namespace Rendering
+    {
+        // Command buffers of the parts of one frame, recorded by as many jobs.
+        // Each buffer belongs to the job recording it, so recording takes no
+        // lock; submit() executes them on the context thread in index order,
+        // whichever job finished first.
+        //
+        // The renderer releases bound state after each buffer, so each must
+        // bind all the state its draws need.
+        class CommandQueue
+        {
+            public:
+                CommandQueue();
+                CommandQueue(const CommandQueue &other) = delete;
+                ~CommandQueue();
+
+                CommandQueue &operator =(const CommandQueue &other) = delete;
+
+                // Clears the buffers and makes count of them available, keeping
+                // the memory of earlier ones
+                void reset(std::size_t count);
+
+                std::size_t getBufferCount() const;
+                CommandBuffer &getBuffer(std::size_t index);
+                const CommandBuffer &getBuffer(std::size_t index) const;
+
+                // Executes the buffers in index order. Must not run concurrently
+                // with recording.
+                void submit(IRenderer &renderer) const;
+
+            private:
+                std::vector<std::unique_ptr<CommandBuffer>> buffers;
+                std::size_t count;
+        };
+    }
+}
+
+#endif // COMMANDQUEUE_H
@@ -20,6 +20,7 @@ namespace Amber
         class Layout;
 
         class Camera;
+        class CommandBuffer;
         class Light;
         class Material;
         class Mesh;
@@ -0,0 +1,520 @@
+#include "ForwardRenderingStrategy.h"
+
+#include <algorithm>
+#include <cstring>
+#include <tuple>
+
+#include "Amber/Rendering/Backend/IBuffer.h"
+#include "Amber/Rendering/Backend/IProgram.h"
+#include "Amber/Rendering/Backend/ITexture.h"
+#include "Amber/Rendering/Backend/Layout.h"
+
+namespace Amber
+{
+    namespace Rendering
+    {
+        namespace
+        {
+            // Key layout, most significant bits first. Opaque draws sort by
+            // state and then front to back, translucent ones back to front
+            // before anything else:
+            //   opaque:      pass:2 program:10 textures:14 vertexArray:14 depth:24
+            //   translucent: pass:2 depth:24 program:10 textures:14 vertexArray:14
+            const unsigned ProgramBits = 10;
+            const unsigned TextureSetBits = 14;
+            const unsigned VertexArrayBits = 14;
+            const unsigned DepthBits = 24;
+
+            // Frames a program, texture set or vertex array may go undrawn
+            // before its id is recycled
+            const std::uint64_t StateIdLifetime = 120;
+
+            // Sorted draws recorded by one job, at least
+            const std::size_t RecordChunkSize = 1024;
+
+            const std::uint64_t OpaquePass = 0;
+            const std::uint64_t TranslucentPass = 1;
+
+            std::uint64_t mask(std::uint32_t value, unsigned bits)
+            {
+                return value & ((std::uint64_t(1) << bits) - 1);
+            }
+
+            // The last id of a field is shared by all state that found no other
+            std::uint32_t getOverflowId(unsigned bits)
+            {
+                return (std::uint32_t(1) << bits) - 1;
+            }
+
+            template <typename Map, typename Key>
+            std::uint32_t acquireId(Map &ids, std::vector<std::uint32_t> &freeIds, const Key &key,
+                                    std::uint64_t frame, unsigned bits, bool &overflow)
+            {
+                auto it = ids.find(key);
+                if (it == ids.end())
+                {
+                    // Ids in use and on the free list are all that were ever handed out
+                    std::uint32_t id = static_cast<std::uint32_t>(ids.size() + freeIds.size());
+                    if (!freeIds.empty())
+                    {
+                        id = freeIds.back();
+                        freeIds.pop_back();
+                    }
+                    else if (id >= getOverflowId(bits))
+                    {
+                        // Not kept, the state gets an id of its own once one is released
+                        overflow = true;
+                        return getOverflowId(bits);
+                    }
+
+                    it = ids.emplace(key, typename Map::mapped_type { id, frame }).first;
+                }
+
+                it->second.lastFrame = frame;
+                return it->second.id;
+            }
+
+            template <typename Map>
+            void releaseUnusedIds(Map &ids, std::vector<std::uint32_t> &freeIds, std::uint64_t frame)
+            {
+                for (auto it = ids.begin(); it != ids.end();)
+                {
+                    if (frame - it->second.lastFrame > StateIdLifetime)
+                    {
+                        freeIds.push_back(it->second.id);
+                        it = ids.erase(it);
+                    }
+                    else
+                    {
+                        ++it;
+                    }
+                }
+            }
+
+            // The bits of a non-negative float order like the float itself, its
+            // top bits are a coarse but monotonic depth
+            std::uint32_t quantizeDepth(float depth)
+            {
+                if (!(depth > 0.0f))
+                {
+                    return 0;
+                }
+
+                std::uint32_t bits;
+                std::memcpy(&bits, &depth, sizeof(bits));
+                return bits >> (32 - DepthBits - 1);
+            }
+
+            std::uint64_t makeKey(bool translucent, std::uint32_t program, std::uint32_t textureSet,
+                                  std::uint32_t vertexArray, float depth)
+            {
+                // Ids never exceed their fields' overflow ids
+                std::uint64_t state = (std::uint64_t(program) << (TextureSetBits + VertexArrayBits))
+                        | (std::uint64_t(textureSet) << VertexArrayBits)
+                        | vertexArray;
+                std::uint64_t quantizedDepth = quantizeDepth(depth);
+                const unsigned stateBits = ProgramBits + TextureSetBits + VertexArrayBits;
+
+                if (translucent)
+                {
+                    std::uint64_t farFirst = mask(~static_cast<std::uint32_t>(quantizedDepth), DepthBits);
+                    return (TranslucentPass << 62) | (farFirst << stateBits) | state;
+                }
+
+                return (OpaquePass << 62) | (state << DepthBits) | quantizedDepth;
+            }
+
+            IProgram *getPointer(const Reference<IProgram> &program)
+            {
+                return program.isValid() ? program.get() : nullptr;
+            }
+
+            ITexture *getPointer(const Reference<ITexture> &texture)
+            {
+                return texture.isValid() ? texture.get() : nullptr;
+            }
+
+            IBuffer *getPointer(const Reference<IBuffer> &buffer)
+            {
+                return buffer.isValid() ? buffer.get() : nullptr;
+            }
+
+            // Whether one draw call can stand for both meshes once their vertex
+            // arrays match. Draws always cover whole triangle lists from the
+            // start of the buffers, so there is no offset or primitive type
+            // to tell them apart.
+            bool isSameDraw(const RenderSnapshot::MeshInstance &lhs, const RenderSnapshot::MeshInstance &rhs)
+            {
+                return getPointer(lhs.getIndexBuffer()) == getPointer(rhs.getIndexBuffer())
+                        && lhs.getPrimitiveCount() == rhs.getPrimitiveCount();
+            }
+        }
+
+        std::size_t ForwardRenderingStrategy::Stats::getStateChanges() const
+        {
+            return programChanges + textureChanges + vertexArrayChanges;
+        }
+
+        std::size_t ForwardRenderingStrategy::Stats::getUnsortedStateChanges() const
+        {
+            return unsortedProgramChanges + unsortedTextureChanges + unsortedVertexArrayChanges;
+        }
+
+        std::size_t ForwardRenderingStrategy::Stats::getAvoidedStateChanges() const
+        {
+            std::size_t changes = getStateChanges();
+            std::size_t unsortedChanges = getUnsortedStateChanges();
+            return unsortedChanges > changes ? unsortedChanges - changes : 0;
+        }
+
+        ForwardRenderingStrategy::ForwardRenderingStrategy(Utilities::JobSystem *jobSystem)
+            : jobSystem(jobSystem),
+              stats(Stats { 0, 0, 0, 0, 0, 0, 0, 0 }),
+              frame(0),
+              idOverflow(false)
+        {
+        }
+
+        ForwardRenderingStrategy::~ForwardRenderingStrategy()
+        {
+        }
+
+        void ForwardRenderingStrategy::render(const RenderSnapshot &snapshot, IRenderer *renderer)
+        {
+            // The camera as it was when the snapshot was taken, the live one may
+            // already have moved on
+            const Eigen::Matrix4f &viewMatrix = snapshot.getViewMatrix();
+            const Eigen::Matrix4f &projectionMatrix = snapshot.getProjectionMatrix();
+
+            const std::vector<RenderSnapshot::MeshInstance> &meshes = snapshot.getMeshes();
+            float alpha = snapshot.getInterpolationAlpha();
+
+            items.clear();
+            states.clear();
+
+            frame++;
+            idOverflow = false;
+            releaseUnusedIds(programIds, freeProgramIds, frame);
+            releaseUnusedIds(textureSetIds, freeTextureSetIds, frame);
+            releaseUnusedIds(vertexArrayIds, freeVertexArrayIds, frame);
+
+            for (std::size_t i = 0; i < meshes.size(); i++)
+            {
+                const RenderSnapshot::MeshInstance &mesh = meshes[i];
+                const Material &material = mesh.getMaterial();
+
+                Reference<IBindable> vertexArray = renderer->getVertexArray(mesh);
+                if (!vertexArray.isValid())
+                {
+                    continue;
+                }
+
+                TextureSet textureSet = {{
+                    getPointer(material.getDiffuseTexture()),
+                    getPointer(material.getNormalMap()),
+                    getPointer(material.getSpecularMap()),
+                    getPointer(material.getDisplacementMap())
+                }};
+
+                DrawState state = {
+                    static_cast<std::uint32_t>(i),
+                    getPointer(material.getProgram()),
+                    textureSet,
+                    vertexArray.get()
+                };
+
+                // Distance along the view direction, which looks down negative z
+                Eigen::Vector4f position = viewMatrix * mesh.getInterpolatedTransform(alpha).col(3);
+                float depth = -position.z();
+
+                items.push_back(DrawItem {
+                    makeKey(material.getTranslucency() > 0.0f, getProgramId(state.program), getTextureSetId(state.textureSet),
+                            getVertexArrayId(state.vertexArray), depth),
+                    static_cast<std::uint32_t>(states.size())
+                });
+                states.push_back(state);
+            }
+
+            // What the snapshot's own order would have cost, before it is sorted
+            stats = Stats { items.size(), 0, 0, 0, 0, 0, 0, 0 };
+            for (std::size_t i = 1; i < states.size(); i++)
+            {
+                stats.unsortedProgramChanges += states[i].program != states[i - 1].program;
+                stats.unsortedTextureChanges += states[i].textureSet != states[i - 1].textureSet;
+                stats.unsortedVertexArrayChanges += states[i].vertexArray != states[i - 1].vertexArray;
+            }
+
+            if (idOverflow)
+            {
+                sortByState();
+            }
+            else
+            {
+                sort();
+            }
+
+            for (std::size_t i = 1; i < items.size(); i++)
+            {
+                const DrawState &state = states[items[i].index];
+                const DrawState &previous = states[items[i - 1].index];
+                stats.programChanges += state.program != previous.program;
+                stats.textureChanges += state.textureSet != previous.textureSet;
+                stats.vertexArrayChanges += state.vertexArray != previous.vertexArray;
+            }
+
+            record(snapshot, viewMatrix, projectionMatrix);
+            commands.submit(*renderer);
+        }
+
+        const ForwardRenderingStrategy::Stats &ForwardRenderingStrategy::getStats() const
+        {
+            return stats;
+        }
+
+        std::uint32_t ForwardRenderingStrategy::getProgramId(const IProgram *program)
+        {
+            return acquireId(programIds, freeProgramIds, program, frame, ProgramBits, idOverflow);
+        }
+
+        std::uint32_t ForwardRenderingStrategy::getTextureSetId(const TextureSet &textureSet)
+        {
+            return acquireId(textureSetIds, freeTextureSetIds, textureSet, frame, TextureSetBits, idOverflow);
+        }
+
+        std::uint32_t ForwardRenderingStrategy::getVertexArrayId(const IBindable *vertexArray)
+        {
+            return acquireId(vertexArrayIds, freeVertexArrayIds, vertexArray, frame, VertexArrayBits, idOverflow);
+        }
+
+        bool ForwardRenderingStrategy::isInstancingSupported(const IProgram *program)
+        {
+            if (program == nullptr)
+            {
+                return false;
+            }
+
+            for (const Layout::Attribute &attribute : program->getLayout().getAttributes())
+            {
+                if (attribute.isPerInstance() && attribute.getName() == "mdl_Transform")
+                {
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        void ForwardRenderingStrategy::sort()
+        {
+            // Least significant digit radix sort, a byte per pass. It is stable,
+            // so draws with equal keys keep the snapshot's order.
+            sortBuffer.resize(items.size());
+
+            for (unsigned shift = 0; shift < 64; shift += 8)
+            {
+                std::size_t offsets[256] = {};
+                for (const DrawItem &item : items)
+                {
+                    offsets[(item.key >> shift) & 0xff]++;
+                }
+
+                // Nothing to do when every key has the same byte here, which is
+                // common for the unused high bits of small scenes
+                if (!items.empty() && offsets[(items.front().key >> shift) & 0xff] == items.size())
+                {
+                    continue;
+                }
+
+                std::size_t offset = 0;
+                for (std::size_t &count : offsets)
+                {
+                    std::size_t start = offset;
+                    offset += count;
+                    count = start;
+                }
+
+                for (const DrawItem &item : items)
+                {
+                    sortBuffer[offsets[(item.key >> shift) & 0xff]++] = item;
+                }
+
+                items.swap(sortBuffer);
+            }
+        }
+
+        void ForwardRenderingStrategy::sortByState()
+        {
+            // Draws sharing an overflow id look alike in their keys whatever
+            // their state, so the state itself is compared where the keys
+            // compare state. The order is otherwise that of the keys.
+            auto getDepth = [] (const DrawItem &item)
+            {
+                bool translucent = (item.key >> 62) == TranslucentPass;
+                std::uint64_t depth = translucent ? item.key >> (ProgramBits + TextureSetBits + VertexArrayBits) : item.key;
+                return mask(static_cast<std::uint32_t>(depth), DepthBits);
+            };
+
+            auto getState = [this] (const DrawItem &item)
+            {
+                const DrawState &state = states[item.index];
+                return std::make_tuple(state.program, state.textureSet, state.vertexArray);
+            };
+
+            std::stable_sort(items.begin(), items.end(), [&] (const DrawItem &lhs, const DrawItem &rhs)
+            {
+                std::uint64_t pass = lhs.key >> 62;
+                if (pass != rhs.key >> 62)
+                {
+                    return pass < rhs.key >> 62;
+                }
+
+                // Translucent draws sort by depth before state, opaque ones after
+                std::uint64_t lhsDepth = getDepth(lhs);
+                std::uint64_t rhsDepth = getDepth(rhs);
+                if (pass == TranslucentPass && lhsDepth != rhsDepth)
+                {
+                    return lhsDepth < rhsDepth;
+                }
+
+                if (getState(lhs) != getState(rhs))
+                {
+                    return getState(lhs) < getState(rhs);
+                }
+
+                return lhsDepth < rhsDepth;
+            });
+        }
+
+        void ForwardRenderingStrategy::record(const RenderSnapshot &snapshot, const Eigen::Matrix4f &viewMatrix,
+                                              const Eigen::Matrix4f &projectionMatrix)
+        {
+            // Ranges start where the state changes, a run of equal state would
+            // otherwise be split into two instanced draws
+            std::size_t rangeCount = 0;
+            for (std::size_t begin = 0; begin < items.size(); rangeCount++)
+            {
+                std::size_t end = std::min(items.size(), begin + RecordChunkSize);
+                while (end < items.size() && isSameState(states[items[end - 1].index], states[items[end].index]))
+                {
+                    end++;
+                }
+
+                if (ranges.size() == rangeCount)
+                {
+                    ranges.emplace_back();
+                }
+
+                ranges[rangeCount].begin = begin;
+                ranges[rangeCount].end = end;
+                ranges[rangeCount].drawCallCount = 0;
+                begin = end;
+            }
+
+            commands.reset(rangeCount);
+
+            auto recordChunk = [&] (std::size_t index)
+            {
+                recordRange(snapshot, viewMatrix, projectionMatrix, ranges[index], commands.getBuffer(index));
+            };
+
+            if (jobSystem != nullptr && rangeCount > 1)
+            {
+                jobSystem->parallelFor(rangeCount, recordChunk, 1);
+            }
+            else
+            {
+                for (std::size_t index = 0; index < rangeCount; index++)
+                {
+                    recordChunk(index);
+                }
+            }
+
+            for (std::size_t index = 0; index < rangeCount; index++)
+            {
+                stats.drawCallCount += ranges[index].drawCallCount;
+            }
+        }
+
+        void ForwardRenderingStrategy::recordRange(const RenderSnapshot &snapshot, const Eigen::Matrix4f &viewMatrix,
+                                                   const Eigen::Matrix4f &projectionMatrix, RecordRange &range,
+                                                   CommandBuffer &commands)
+        {
+            const std::vector<RenderSnapshot::MeshInstance> &meshes = snapshot.getMeshes();
+            float alpha = snapshot.getInterpolationAlpha();
+
+            // State stays bound across draws and is only rebound when it changes.
+            // Nothing is bound at the start of a buffer.
+            const DrawState *previous = nullptr;
+            bool instancing = false;
+            for (std::size_t i = range.begin; i < range.end;)
+            {
+                const DrawState &state = states[items[i].index];
+                const RenderSnapshot::MeshInstance &mesh = meshes[state.mesh];
+                const Material &material = mesh.getMaterial();
+
+                if (previous == nullptr || state.program != previous->program)
+                {
+                    commands.bindProgram(state.program);
+                    if (state.program != nullptr)
+                    {
+                        commands.setConstant("mdl_Projection", projectionMatrix);
+                        commands.setConstant("mdl_View", viewMatrix);
+                    }
+
+                    instancing = isInstancingSupported(state.program);
+                }
+
+                if (previous == nullptr || state.textureSet != previous->textureSet)
+                {
+                    // Material textures each have their own slot
+                    commands.bindTexture(0, getPointer(material.getDiffuseTexture()));
+                    commands.bindTexture(1, getPointer(material.getNormalMap()));
+                    commands.bindTexture(2, getPointer(material.getSpecularMap()));
+                    commands.bindTexture(3, getPointer(material.getDisplacementMap()));
+                }
+
+                if (previous == nullptr || state.vertexArray != previous->vertexArray)
+                {
+                    commands.bindVertexArray(state.vertexArray);
+                }
+
+                previous = &state;
+                range.drawCallCount++;
+
+                if (!instancing)
+                {
+                    if (state.program != nullptr)
+                    {
+                        commands.setConstant("mdl_ModelView", Eigen::Matrix4f(viewMatrix * mesh.getInterpolatedTransform(alpha)));
+                    }
+
+                    commands.draw(mesh);
+                    i++;
+                    continue;
+                }
+
+                // Sorting put draws with equal state next to each other. All of
+                // them are drawn like the first, so they must also agree on what
+                // is drawn from the vertex array.
+                range.instanceTransforms.clear();
+                for (; i < range.end; i++)
+                {
+                    const DrawState &instance = states[items[i].index];
+                    if (!isSameState(instance, state) || !isSameDraw(meshes[instance.mesh], mesh))
+                    {
+                        break;
+                    }
+
+                    range.instanceTransforms.push_back(meshes[instance.mesh].getInterpolatedTransform(alpha));
+                }
+
+                commands.drawInstanced(mesh, range.instanceTransforms.data(), static_cast<std::uint32_t>(range.instanceTransforms.size()));
+            }
+        }
+
+        bool ForwardRenderingStrategy::isSameState(const DrawState &lhs, const DrawState &rhs)
+        {
+            return lhs.program == rhs.program && lhs.textureSet == rhs.textureSet && lhs.vertexArray == rhs.vertexArray;
+        }
+    }
+}
@@ -0,0 +1,151 @@
+#ifndef FORWARDRENDERINGSTRATEGY_H
+#define FORWARDRENDERINGSTRATEGY_H
+
+#include "Amber/Rendering/IRenderingStrategy.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "Amber/Rendering/CommandBuffer.h"
+#include "Amber/Rendering/CommandQueue.h"
+#include "Amber/Rendering/Backend/Reference.h"
+#include "Amber/Utilities/JobSystem.h"
+
+namespace Amber
+{
+    namespace Rendering
+    {
+        // Draws every mesh of a snapshot in one forward pass. Draws are sorted by
+        // a 64-bit key so that meshes sharing a program, textures and vertex
+        // array are recorded together and their state is bound only once.
+        // Opaque meshes go first, front to back; translucent ones after, back
+        // to front. Culling is left to the snapshot's extraction, every mesh
+        // of the snapshot is drawn as seen by its camera.
+        //
+        // Programs with a per-instance mdl_Transform attribute get every run of
+        // draws sharing all state as one instanced draw, with the world
+        // transforms as instance data and the view in mdl_View. Others get a
+        // draw per mesh with mdl_ModelView.
+        //
+        // The sorted draws are recorded in ranges, each into its own buffer of
+        // a command queue, which is executed in range order.
+        class ForwardRenderingStrategy : public IRenderingStrategy
+        {
+            public:
+                // Counts of the last rendered frame. Draw calls are what the
+                // drawn meshes took after instancing. Changes are binds of a
+                // program, texture set or vertex array that differ from the
+                // previous draw's; the unsorted ones are what submitting the
+                // snapshot's order would have cost.
+                struct Stats
+                {
+                    std::size_t drawCount;
+                    std::size_t drawCallCount;
+
+                    std::size_t programChanges;
+                    std::size_t textureChanges;
+                    std::size_t vertexArrayChanges;
+
+                    std::size_t unsortedProgramChanges;
+                    std::size_t unsortedTextureChanges;
+                    std::size_t unsortedVertexArrayChanges;
+
+                    std::size_t getStateChanges() const;
+                    std::size_t getUnsortedStateChanges() const;
+                    std::size_t getAvoidedStateChanges() const;
+                };
+
+                // Recording is split into chunks run on the job system, when given
+                explicit ForwardRenderingStrategy(Utilities::JobSystem *jobSystem = nullptr);
+                virtual ~ForwardRenderingStrategy();
+
+                virtual void render(const RenderSnapshot &snapshot, IRenderer *renderer) override;
+
+                const Stats &getStats() const;
+
+            private:
+                typedef std::array<const ITexture *, 4> TextureSet;
+
+                // Index is into the draw states, in snapshot order
+                struct DrawItem
+                {
+                    std::uint64_t key;
+                    std::uint32_t index;
+                };
+
+                // The state itself rather than its ids, which may not tell it
+                // apart once they ran out
+                struct DrawState
+                {
+                    std::uint32_t mesh;
+                    IProgram *program;
+                    TextureSet textureSet;
+                    IBindable *vertexArray;
+                };
+
+                // Sort key id of a program, texture set or vertex array and the
+                // frame it was last drawn in
+                struct StateId
+                {
+                    std::uint32_t id;
+                    std::uint64_t lastFrame;
+                };
+
+                std::uint32_t getProgramId(const IProgram *program);
+                std::uint32_t getTextureSetId(const TextureSet &textureSet);
+                std::uint32_t getVertexArrayId(const IBindable *vertexArray);
+
+                // Sorted draws recorded into one buffer of the queue, and the
+                // draw calls they took
+                struct RecordRange
+                {
+                    std::size_t begin;
+                    std::size_t end;
+                    std::size_t drawCallCount;
+                    std::vector<Eigen::Matrix4f> instanceTransforms;
+                };
+
+                static bool isInstancingSupported(const IProgram *program);
+                static bool isSameState(const DrawState &lhs, const DrawState &rhs);
+
+                void sort();
+                void sortByState();
+                void record(const RenderSnapshot &snapshot, const Eigen::Matrix4f &viewMatrix,
+                            const Eigen::Matrix4f &projectionMatrix);
+                void recordRange(const RenderSnapshot &snapshot, const Eigen::Matrix4f &viewMatrix,
+                                 const Eigen::Matrix4f &projectionMatrix, RecordRange &range, CommandBuffer &commands);
+
+                Utilities::JobSystem *jobSystem;
+                Stats stats;
+
+                // Ids are handed out on first sight and kept while the state is
+                // drawn, so equal state sorts the same way every frame. State not
+                // drawn for a while has likely been released, its id goes back
+                // to the free list to keep ids small enough for their key field.
+                // Once a field's ids run out, further state shares its last id
+                // and the frame is sorted by comparing the state itself.
+                std::uint64_t frame;
+                bool idOverflow;
+                std::unordered_map<const IProgram *, StateId> programIds;
+                std::map<TextureSet, StateId> textureSetIds;
+                std::unordered_map<const IBindable *, StateId> vertexArrayIds;
+                std::vector<std::uint32_t> freeProgramIds;
+                std::vector<std::uint32_t> freeTextureSetIds;
+                std::vector<std::uint32_t> freeVertexArrayIds;
+
+                std::vector<DrawItem> items;
+                std::vector<DrawItem> sortBuffer;
+                std::vector<DrawState> states;
+                std::vector<RecordRange> ranges;
+                CommandQueue commands;
+        };
+    }
+}
+
+#endif // FORWARDRENDERINGSTRATEGY_H
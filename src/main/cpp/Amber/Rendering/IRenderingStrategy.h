@@ -1,7 +1,7 @@
 #ifndef IRENDERINGSTRATEGY_H
 #define IRENDERINGSTRATEGY_H
 
-#include "Amber/Rendering/Scene.h"
+#include "Amber/Rendering/RenderSnapshot.h"
 #include "Amber/Rendering/Backend/IRenderer.h"
 
 namespace Amber
@@ -14,7 +14,7 @@ namespace Amber
                 IRenderingStrategy() = default;
                 virtual ~IRenderingStrategy() = default;
 
-                virtual void render(Scene &scene, IRenderer *renderer) = 0;
+                virtual void render(const RenderSnapshot &snapshot, IRenderer *renderer) = 0;
         };
     }
 }
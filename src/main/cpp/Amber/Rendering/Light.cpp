@@ -1,5 +1,8 @@
 #include "Light.h"
 
+#include <cmath>
+#include <limits>
+
 namespace Amber
 {
     namespace Rendering
@@ -11,6 +14,11 @@ namespace Amber
         {
         }
 
+        Light::Type Light::getType() const
+        {
+            return type;
+        }
+
         const Eigen::Vector3f &Light::getAttenuationCoefficients() const
         {
             return attenuationCoefficients;
@@ -21,6 +29,37 @@ namespace Amber
             this->attenuationCoefficients = std::move(attenuationCoefficients);
         }
 
+        float Light::getRange() const
+        {
+            const float infinity = std::numeric_limits<float>::infinity();
+            if (type == Type::Directional)
+            {
+                return infinity;
+            }
+
+            // Solve constant + linear * d + quadratic * d^2 = 256 for d
+            float constant = attenuationCoefficients.x() - 256.0f;
+            float linear = attenuationCoefficients.y();
+            float quadratic = attenuationCoefficients.z();
+
+            if (constant >= 0.0f)
+            {
+                return 0.0f;
+            }
+
+            if (quadratic > 0.0f)
+            {
+                return (-linear + std::sqrt(linear * linear - 4.0f * quadratic * constant)) / (2.0f * quadratic);
+            }
+
+            if (linear > 0.0f)
+            {
+                return -constant / linear;
+            }
+
+            return infinity;
+        }
+
         const Eigen::Vector4f &Light::getColor() const
         {
             return color;
@@ -1,6 +1,7 @@
 #ifndef LIGHT_H
 #define LIGHT_H
 
+#include "Amber/Core/ComponentType.h"
 #include "Amber/Core/IComponent.h"
 
 #include <Eigen/Core>
@@ -22,9 +23,15 @@ namespace Amber
                 Light(Type type);
                 virtual ~Light() = default;
 
+                Type getType() const;
+
                 const Eigen::Vector3f &getAttenuationCoefficients() const;
                 void setAttenuationCoefficients(Eigen::Vector3f attenuationCoefficients);
 
+                // Distance past which the light falls below 1/256 of its color,
+                // infinite for directional lights and lights that do not fade
+                float getRange() const;
+
                 const Eigen::Vector4f &getColor() const;
                 void setColor(Eigen::Vector4f color);
 
@@ -37,4 +44,6 @@ namespace Amber
     }
 }
 
+AMBER_COMPONENT_TYPE(Amber::Rendering::Light, 3)
+
 #endif // LIGHT_H
@@ -64,6 +64,16 @@ namespace Amber
             this->diffuseColor = std::move(diffuseColor);
         }
 
+        Reference<IProgram> Material::getProgram() const
+        {
+            return program;
+        }
+
+        void Material::setProgram(const Reference<IProgram> &program)
+        {
+            this->program = program;
+        }
+
         Reference<ITexture> Material::getDiffuseTexture() const
         {
             return diffuseTexture;
@@ -1,6 +1,7 @@
 #ifndef MATERIAL_H
 #define MATERIAL_H
 
+#include "Amber/Core/ComponentType.h"
 #include "Amber/Core/IComponent.h"
 
 #include <memory>
@@ -35,6 +36,10 @@ namespace Amber
                 const Eigen::Vector4f &getDiffuseColor() const;
                 void setDiffuseColor(Eigen::Vector4f diffuseColor);
 
+                // Program the material is drawn with
+                Reference<IProgram> getProgram() const;
+                void setProgram(const Reference<IProgram> &program);
+
                 Reference<ITexture> getDiffuseTexture() const;
                 void setDiffuseTexture(const Reference<ITexture> &diffuseTexture);
 
@@ -55,6 +60,7 @@ namespace Amber
                 bool subsurfaceScattering;
 
                 Eigen::Vector4f diffuseColor;
+                Reference<IProgram> program;
                 Reference<ITexture> diffuseTexture;
 
                 Reference<ITexture> normalMap;
@@ -64,4 +70,6 @@ namespace Amber
     }
 }
 
+AMBER_COMPONENT_TYPE(Amber::Rendering::Material, 2)
+
 #endif // MATERIAL_H
@@ -10,7 +10,9 @@ namespace Amber
     {
         Mesh::Mesh()
             : vertexCount(0),
-              primitiveCount(0)
+              primitiveCount(0),
+              boundingBox(Math::BoundingBox::empty()),
+              boundingSphere(Math::BoundingSphere::empty())
         {
             // FIXME I'd rather we didn't depend on an active context in this constructor
             IContext *context = IContext::getActiveContext();
@@ -46,6 +48,11 @@ namespace Amber
             return layout;
         }
 
+        const Layout &Mesh::getLayout() const
+        {
+            return layout;
+        }
+
         bool Mesh::isInHardwareStorage() const
         {
             // return !vertexBuffer.cast<DeferredBuffer>().isValid();
@@ -101,5 +108,25 @@ namespace Amber
         {
             this->primitiveCount = primitiveCount;
         }
+
+        const Math::BoundingBox &Mesh::getBoundingBox() const
+        {
+            return boundingBox;
+        }
+
+        void Mesh::setBoundingBox(const Math::BoundingBox &boundingBox)
+        {
+            this->boundingBox = boundingBox;
+        }
+
+        const Math::BoundingSphere &Mesh::getBoundingSphere() const
+        {
+            return boundingSphere;
+        }
+
+        void Mesh::setBoundingSphere(const Math::BoundingSphere &boundingSphere)
+        {
+            this->boundingSphere = boundingSphere;
+        }
     }
 }
@@ -1,6 +1,7 @@
 #ifndef MESH_H
 #define MESH_H
 
+#include "Amber/Core/ComponentType.h"
 #include "Amber/Core/IComponent.h"
 #include "Amber/Rendering/Backend/IObject.h"
 
@@ -9,6 +10,7 @@
 
 #include <Eigen/Core>
 
+#include "Amber/Math/Bounds.h"
 #include "Amber/Rendering/Backend/Layout.h"
 #include "Amber/Rendering/Backend/Reference.h"
 #include "Amber/Rendering/Backend/VertexTypes.h"
@@ -35,6 +37,7 @@ namespace Amber
                 virtual const Reference<IBuffer> &getIndexBuffer() const override final;
 
                 virtual Layout &getLayout() override final;
+                virtual const Layout &getLayout() const override final;
 
                 virtual bool isInHardwareStorage() const override final;
                 virtual void moveToHardwareStorage(IContext &context) override final;
@@ -48,14 +51,25 @@ namespace Amber
                 void setVertexCount(std::size_t vertexCount);
                 void setPrimitiveCount(std::size_t primitiveCount);
 
+                // Bounds of the vertex positions in model space, empty when unknown
+                const Math::BoundingBox &getBoundingBox() const;
+                void setBoundingBox(const Math::BoundingBox &boundingBox);
+
+                const Math::BoundingSphere &getBoundingSphere() const;
+                void setBoundingSphere(const Math::BoundingSphere &boundingSphere);
+
             private:
                 Reference<IBuffer> vertexBuffer;
                 Reference<IBuffer> indexBuffer;
                 Layout layout;
                 std::size_t vertexCount;
                 std::size_t primitiveCount;
+                Math::BoundingBox boundingBox;
+                Math::BoundingSphere boundingSphere;
         };
     }
 }
 
+AMBER_COMPONENT_TYPE(Amber::Rendering::Mesh, 1)
+
 #endif // MESH_H
@@ -0,0 +1,215 @@
+#include "RenderSnapshot.h"
+
+#include <stdexcept>
+
+#include "Amber/Core/Transform.h"
+#include "Amber/Rendering/Camera.h"
+
+namespace Amber
+{
+    namespace Rendering
+    {
+        RenderSnapshot::MeshInstance::MeshInstance(Core::EntityId entity, const Mesh &mesh, Material material,
+                                                   Eigen::Matrix4f previousTransform, Eigen::Matrix4f transform)
+            : entity(entity),
+              vertexBuffer(mesh.getVertexBuffer()),
+              indexBuffer(mesh.getIndexBuffer()),
+              layout(mesh.getLayout()),
+              vertexCount(mesh.getVertexCount()),
+              primitiveCount(mesh.getPrimitiveCount()),
+              boundingBox(mesh.getBoundingBox()),
+              boundingSphere(mesh.getBoundingSphere()),
+              material(std::move(material)),
+              previousTransform(std::move(previousTransform)),
+              transform(std::move(transform))
+        {
+        }
+
+        Reference<IBuffer> &RenderSnapshot::MeshInstance::getVertexBuffer()
+        {
+            return vertexBuffer;
+        }
+
+        const Reference<IBuffer> &RenderSnapshot::MeshInstance::getVertexBuffer() const
+        {
+            return vertexBuffer;
+        }
+
+        Reference<IBuffer> &RenderSnapshot::MeshInstance::getIndexBuffer()
+        {
+            return indexBuffer;
+        }
+
+        const Reference<IBuffer> &RenderSnapshot::MeshInstance::getIndexBuffer() const
+        {
+            return indexBuffer;
+        }
+
+        Layout &RenderSnapshot::MeshInstance::getLayout()
+        {
+            return layout;
+        }
+
+        const Layout &RenderSnapshot::MeshInstance::getLayout() const
+        {
+            return layout;
+        }
+
+        bool RenderSnapshot::MeshInstance::isInHardwareStorage() const
+        {
+            return true;
+        }
+
+        void RenderSnapshot::MeshInstance::moveToHardwareStorage(IContext &)
+        {
+            throw std::logic_error("Snapshot meshes cannot be moved to hardware storage");
+        }
+
+        std::size_t RenderSnapshot::MeshInstance::getVertexCount() const
+        {
+            return vertexCount;
+        }
+
+        std::size_t RenderSnapshot::MeshInstance::getPrimitiveCount() const
+        {
+            return primitiveCount;
+        }
+
+        std::size_t RenderSnapshot::MeshInstance::getInstanceCount() const
+        {
+            return 1;
+        }
+
+        Core::EntityId RenderSnapshot::MeshInstance::getEntity() const
+        {
+            return entity;
+        }
+
+        const Material &RenderSnapshot::MeshInstance::getMaterial() const
+        {
+            return material;
+        }
+
+        const Math::BoundingBox &RenderSnapshot::MeshInstance::getBoundingBox() const
+        {
+            return boundingBox;
+        }
+
+        const Math::BoundingSphere &RenderSnapshot::MeshInstance::getBoundingSphere() const
+        {
+            return boundingSphere;
+        }
+
+        const Eigen::Matrix4f &RenderSnapshot::MeshInstance::getPreviousTransform() const
+        {
+            return previousTransform;
+        }
+
+        const Eigen::Matrix4f &RenderSnapshot::MeshInstance::getTransform() const
+        {
+            return transform;
+        }
+
+        Eigen::Matrix4f RenderSnapshot::MeshInstance::getInterpolatedTransform(float alpha) const
+        {
+            return Core::Transform::interpolate(previousTransform, transform, alpha);
+        }
+
+        RenderSnapshot::RenderSnapshot()
+            : tick(0),
+              interpolationAlpha(1.0f),
+              viewMatrix(Eigen::Matrix4f::Identity()),
+              projectionMatrix(Eigen::Matrix4f::Identity())
+        {
+        }
+
+        void RenderSnapshot::extract(Scene &scene, std::uint64_t tick, float interpolationAlpha)
+        {
+            this->tick = tick;
+            this->interpolationAlpha = interpolationAlpha;
+            viewMatrix = Eigen::Matrix4f::Identity();
+            projectionMatrix = Eigen::Matrix4f::Identity();
+
+            meshes.clear();
+            meshes.reserve(scene.getMeshes().size());
+            for (const Core::Entity &entity : scene.getMeshes())
+            {
+                addMesh(entity);
+            }
+
+            lights.clear();
+            lights.reserve(scene.getLights().size());
+            for (const Core::Entity &entity : scene.getLights())
+            {
+                addLight(entity);
+            }
+        }
+
+        void RenderSnapshot::extract(Scene &scene, const Camera &camera, std::uint64_t tick, float interpolationAlpha)
+        {
+            this->tick = tick;
+            this->interpolationAlpha = interpolationAlpha;
+            viewMatrix = camera.getViewMatrix();
+            projectionMatrix = camera.getProjectionMatrix();
+
+            Math::Frustum frustum = camera.getFrustum();
+
+            meshes.clear();
+            scene.queryMeshes(frustum, [this](const Core::Entity &entity)
+            {
+                addMesh(entity);
+            });
+
+            lights.clear();
+            scene.queryLights(frustum, [this](const Core::Entity &entity)
+            {
+                addLight(entity);
+            });
+        }
+
+        void RenderSnapshot::addMesh(const Core::Entity &entity)
+        {
+            // Read through const entities, so extraction does not count as a write
+            const Core::Transform &transform = *entity.getComponent<Core::Transform>();
+            meshes.emplace_back(entity.getId(), *entity.getComponent<Mesh>(), *entity.getComponent<Material>(),
+                                transform.getPreviousTransform(), transform.getTransform());
+        }
+
+        void RenderSnapshot::addLight(const Core::Entity &entity)
+        {
+            const Core::Transform &transform = *entity.getComponent<Core::Transform>();
+            lights.push_back(LightInstance { entity.getId(), *entity.getComponent<Light>(),
+                                             transform.getPreviousTransform(), transform.getTransform() });
+        }
+
+        std::uint64_t RenderSnapshot::getTick() const
+        {
+            return tick;
+        }
+
+        float RenderSnapshot::getInterpolationAlpha() const
+        {
+            return interpolationAlpha;
+        }
+
+        const Eigen::Matrix4f &RenderSnapshot::getViewMatrix() const
+        {
+            return viewMatrix;
+        }
+
+        const Eigen::Matrix4f &RenderSnapshot::getProjectionMatrix() const
+        {
+            return projectionMatrix;
+        }
+
+        const std::vector<RenderSnapshot::MeshInstance> &RenderSnapshot::getMeshes() const
+        {
+            return meshes;
+        }
+
+        const std::vector<RenderSnapshot::LightInstance> &RenderSnapshot::getLights() const
+        {
+            return lights;
+        }
+    }
+}
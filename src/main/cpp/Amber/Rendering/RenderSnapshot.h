@@ -0,0 +1,120 @@
+#ifndef RENDERSNAPSHOT_H
+#define RENDERSNAPSHOT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "Amber/Core/Entity.h"
+#include "Amber/Core/EntityId.h"
+#include "Amber/Rendering/ForwardDeclarations.h"
+#include "Amber/Rendering/Backend/IObject.h"
+#include "Amber/Rendering/Light.h"
+#include "Amber/Rendering/Material.h"
+#include "Amber/Rendering/Mesh.h"
+#include "Amber/Rendering/Scene.h"
+
+namespace Amber
+{
+    namespace Rendering
+    {
+        // Everything needed to draw one frame, copied out of the world so that it
+        // can be rendered while the simulation already changes the next one.
+        class RenderSnapshot
+        {
+            public:
+                class MeshInstance : public IObject
+                {
+                    public:
+                        MeshInstance(Core::EntityId entity, const Mesh &mesh, Material material,
+                                     Eigen::Matrix4f previousTransform, Eigen::Matrix4f transform);
+                        virtual ~MeshInstance() = default;
+
+                        virtual Reference<IBuffer> &getVertexBuffer() override final;
+                        virtual const Reference<IBuffer> &getVertexBuffer() const override final;
+
+                        virtual Reference<IBuffer> &getIndexBuffer() override final;
+                        virtual const Reference<IBuffer> &getIndexBuffer() const override final;
+
+                        virtual Layout &getLayout() override final;
+                        virtual const Layout &getLayout() const override final;
+
+                        // The buffers are owned by the mesh and already in hardware storage
+                        virtual bool isInHardwareStorage() const override final;
+                        virtual void moveToHardwareStorage(IContext &context) override final;
+
+                        virtual std::size_t getVertexCount() const override final;
+                        virtual std::size_t getPrimitiveCount() const override final;
+                        virtual std::size_t getInstanceCount() const override final;
+
+                        Core::EntityId getEntity() const;
+                        const Material &getMaterial() const;
+
+                        const Math::BoundingBox &getBoundingBox() const;
+                        const Math::BoundingSphere &getBoundingSphere() const;
+
+                        const Eigen::Matrix4f &getPreviousTransform() const;
+                        const Eigen::Matrix4f &getTransform() const;
+                        Eigen::Matrix4f getInterpolatedTransform(float alpha) const;
+
+                    private:
+                        Core::EntityId entity;
+                        Reference<IBuffer> vertexBuffer;
+                        Reference<IBuffer> indexBuffer;
+                        Layout layout;
+                        std::size_t vertexCount;
+                        std::size_t primitiveCount;
+                        Math::BoundingBox boundingBox;
+                        Math::BoundingSphere boundingSphere;
+                        Material material;
+                        Eigen::Matrix4f previousTransform;
+                        Eigen::Matrix4f transform;
+                };
+
+                struct LightInstance
+                {
+                    Core::EntityId entity;
+                    Light light;
+                    Eigen::Matrix4f previousTransform;
+                    Eigen::Matrix4f transform;
+                };
+
+                RenderSnapshot();
+                ~RenderSnapshot() = default;
+
+                // Replaces the contents with the current state of the scene's
+                // entities, seen without a camera
+                void extract(Scene &scene, std::uint64_t tick, float interpolationAlpha);
+
+                // Same, but seen through the camera and only with the entities
+                // the scene's spatial index places within its frustum
+                void extract(Scene &scene, const Camera &camera, std::uint64_t tick, float interpolationAlpha);
+
+                std::uint64_t getTick() const;
+                float getInterpolationAlpha() const;
+
+                // The camera's as of extraction, identities without one
+                const Eigen::Matrix4f &getViewMatrix() const;
+                const Eigen::Matrix4f &getProjectionMatrix() const;
+
+                const std::vector<MeshInstance> &getMeshes() const;
+                const std::vector<LightInstance> &getLights() const;
+
+            private:
+                void addMesh(const Core::Entity &entity);
+                void addLight(const Core::Entity &entity);
+
+                std::uint64_t tick;
+                float interpolationAlpha;
+                Eigen::Matrix4f viewMatrix;
+                Eigen::Matrix4f projectionMatrix;
+
+                std::vector<MeshInstance> meshes;
+                std::vector<LightInstance> lights;
+        };
+    }
+}
+
+#endif // RENDERSNAPSHOT_H
@@ -0,0 +1,83 @@
+#include "RenderSnapshotBuffer.h"
+
+namespace Amber
+{
+    namespace Rendering
+    {
+        RenderSnapshotBuffer::RenderSnapshotBuffer()
+            : front(0),
+              published(false),
+              reading(false),
+              closed(false)
+        {
+        }
+
+        RenderSnapshot &RenderSnapshotBuffer::getBackSnapshot()
+        {
+            return snapshots[1 - front];
+        }
+
+        void RenderSnapshotBuffer::publish()
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            changed.wait(lock, [this] () { return !reading || closed; });
+
+            // The reader may still hold the front snapshot after closing
+            if (closed)
+            {
+                return;
+            }
+
+            front = 1 - front;
+            published = true;
+
+            changed.notify_all();
+        }
+
+        const RenderSnapshot *RenderSnapshotBuffer::acquire()
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            changed.wait(lock, [this] () { return published || closed; });
+
+            if (closed)
+            {
+                return nullptr;
+            }
+
+            published = false;
+            reading = true;
+
+            return &snapshots[front];
+        }
+
+        const RenderSnapshot *RenderSnapshotBuffer::tryAcquire()
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!published || closed)
+            {
+                return nullptr;
+            }
+
+            published = false;
+            reading = true;
+
+            return &snapshots[front];
+        }
+
+        void RenderSnapshotBuffer::release()
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            reading = false;
+
+            changed.notify_all();
+        }
+
+        void RenderSnapshotBuffer::close()
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            closed = true;
+
+            changed.notify_all();
+        }
+    }
+}
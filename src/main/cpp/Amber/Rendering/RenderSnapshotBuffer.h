@@ -0,0 +1,55 @@
+#ifndef RENDERSNAPSHOTBUFFER_H
+#define RENDERSNAPSHOTBUFFER_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+
+#include "Amber/Rendering/RenderSnapshot.h"
+
+namespace Amber
+{
+    namespace Rendering
+    {
+        // Double buffer between the thread extracting snapshots and the one
+        // rendering them. The writer fills the back snapshot while the reader
+        // holds the front one; publishing swaps them once the reader is done.
+        class RenderSnapshotBuffer
+        {
+            public:
+                RenderSnapshotBuffer();
+                RenderSnapshotBuffer(const RenderSnapshotBuffer &other) = delete;
+                ~RenderSnapshotBuffer() = default;
+
+                RenderSnapshotBuffer &operator =(const RenderSnapshotBuffer &other) = delete;
+
+                RenderSnapshot &getBackSnapshot();
+
+                // Does nothing once the buffer is closed, the back snapshot stays
+                // the writer's
+                void publish();
+
+                // Returns the latest published snapshot, blocking until there is a
+                // new one, or null once the buffer is closed. Pair with release().
+                const RenderSnapshot *acquire();
+
+                // Like acquire, but returns null instead of waiting
+                const RenderSnapshot *tryAcquire();
+                void release();
+
+                void close();
+
+            private:
+                RenderSnapshot snapshots[2];
+                std::size_t front;
+                bool published;
+                bool reading;
+                bool closed;
+
+                std::mutex mutex;
+                std::condition_variable changed;
+        };
+    }
+}
+
+#endif // RENDERSNAPSHOTBUFFER_H
@@ -3,9 +3,10 @@
 #include "Amber/Utilities/Config.h"
 
 #include "Amber/IO/ShaderLoader.h"
-#include "Amber/Rendering/IRenderingStrategy.h"
+#include "Amber/Rendering/ForwardRenderingStrategy.h"
 #include "Amber/Rendering/Camera.h"
 #include "Amber/Rendering/Backend/OpenGL4/OpenGL4Renderer.h"
+#include "Amber/Utilities/FrameArena.h"
 
 namespace Amber
 {
@@ -13,39 +14,178 @@ namespace Amber
     {
         // FIXME add support for loading platform specific renderer
         // and loading custom renderers
-        RenderingSystem::RenderingSystem(Core::Game &game)
+        RenderingSystem::RenderingSystem(Core::Game &game, bool renderOnSeparateThread)
             : renderer(new GL4::OpenGL4Renderer()),
-              game(&game)
+              renderingStrategy(new ForwardRenderingStrategy(&game.getJobSystem())),
+              game(&game),
+              renderOnSeparateThread(renderOnSeparateThread)
         {
+            readsComponent<Mesh>();
+            readsComponent<Material>();
+            readsComponent<Light>();
+            readsComponent<Core::Transform>();
+            requiresMainThread();
         }
 
         bool RenderingSystem::isOnSeparateThread() const
         {
-            return false; // FIXME temporary
+            return false;
+        }
+
+        Core::ISystem::Phase RenderingSystem::getPhase() const
+        {
+            return Phase::Presentation;
+        }
+
+        bool RenderingSystem::isRenderingOnSeparateThread() const
+        {
+            return renderOnSeparateThread;
         }
 
         void RenderingSystem::runSingleIteration()
         {
-            renderingStrategy->render(scene, renderer.get());
+            scene.update(&game->getJobSystem());
+
+            // Only what the camera can see is copied out, along with the camera
+            RenderSnapshot &backSnapshot = snapshots.getBackSnapshot();
+            if (viewport.getCamera() != nullptr)
+            {
+                backSnapshot.extract(scene, *viewport.getCamera(), game->getTickCount(), game->getInterpolationAlpha());
+            }
+            else
+            {
+                backSnapshot.extract(scene, game->getTickCount(), game->getInterpolationAlpha());
+            }
+
+            snapshots.publish();
+
+            if (!renderOnSeparateThread)
+            {
+                const RenderSnapshot *snapshot = snapshots.tryAcquire();
+                if (snapshot != nullptr)
+                {
+                    render(*snapshot);
+                    snapshots.release();
+                }
+            }
         }
 
         void RenderingSystem::run()
         {
-            // FIXME no-op
+            while (const RenderSnapshot *snapshot = snapshots.acquire())
+            {
+                render(*snapshot);
+                snapshots.release();
+
+                // The rendering thread's frames end here, not with the game's
+                Utilities::FrameArena::getCurrent().reset();
+            }
         }
 
-        void RenderingSystem::registerEntity(Core::Entity &entity)
+        void RenderingSystem::stop()
         {
-            registerProxy<Mesh, Material, Core::Transform>(entity, [=] (auto p) {
-                renderer->prepare(*p.template get<Mesh>());
-                scene.addMesh(p);
-            });
-            registerProxy<Light, Core::Transform>(entity, [=] (auto p) { scene.addLight(p); });
+            snapshots.close();
+        }
+
+        void RenderingSystem::processChanges(const Core::EntityChanges &changes)
+        {
+            auto update = [this] (const std::vector<Core::Entity> &entities) {
+                for (const Core::Entity &entity : entities)
+                {
+                    updateEntity(entity);
+                }
+            };
+
+            update(changes.getDestroyed());
+
+            update(changes.getAdded<Mesh>());
+            update(changes.getAdded<Material>());
+            update(changes.getAdded<Light>());
+            update(changes.getAdded<Core::Transform>());
+
+            update(changes.getRemoved<Mesh>());
+            update(changes.getRemoved<Material>());
+            update(changes.getRemoved<Light>());
+            update(changes.getRemoved<Core::Transform>());
+
+            for (Core::Entity entity : changes.getChanged<Core::Transform>())
+            {
+                scene.updateTransform(entity);
+            }
+
+            // Buffers or layout of a mesh may have been replaced
+            for (Core::Entity entity : changes.getChanged<Mesh>())
+            {
+                if (entity.hasComponents<Mesh, Material, Core::Transform>())
+                {
+                    prepareMesh(entity);
+                }
+            }
+        }
+
+        void RenderingSystem::updateEntity(Core::Entity entity)
+        {
+            if (entity.hasComponents<Mesh, Material, Core::Transform>())
+            {
+                if (scene.addMesh(entity))
+                {
+                    prepareMesh(entity);
+                }
+            }
+            else
+            {
+                scene.removeMesh(entity);
+            }
+
+            if (entity.hasComponents<Light, Core::Transform>())
+            {
+                scene.addLight(entity);
+            }
+            else
+            {
+                scene.removeLight(entity);
+            }
+        }
+
+        void RenderingSystem::prepareMesh(const Core::Entity &entity)
+        {
+            // Only the buffers and layout matter for preparing, snapshots of the
+            // mesh share them
+            std::lock_guard<std::mutex> lock(unpreparedMutex);
+            unpreparedMeshes.emplace_back(entity.getId(), *entity.getComponent<Mesh>(), *entity.getComponent<Material>(),
+                                          Eigen::Matrix4f::Identity(), Eigen::Matrix4f::Identity());
+        }
+
+        void RenderingSystem::render(const RenderSnapshot &snapshot)
+        {
+            // Queued before the snapshot was published, so every mesh it holds
+            // is prepared by now
+            std::vector<RenderSnapshot::MeshInstance> meshes;
+            {
+                std::lock_guard<std::mutex> lock(unpreparedMutex);
+                meshes.swap(unpreparedMeshes);
+            }
+
+            for (RenderSnapshot::MeshInstance &mesh : meshes)
+            {
+                // Meshes made without an active context have no buffers to draw
+                if (mesh.getVertexBuffer().isValid())
+                {
+                    renderer->prepare(mesh);
+                }
+            }
+
+            renderingStrategy->render(snapshot, renderer.get());
         }
 
         Viewport &RenderingSystem::getViewport()
         {
             return viewport;
         }
+
+        IRenderingStrategy &RenderingSystem::getRenderingStrategy()
+        {
+            return *renderingStrategy;
+        }
     }
 }
@@ -4,10 +4,13 @@
 #include "Amber/Core/ISystem.h"
 
 #include <memory>
+#include <mutex>
+#include <vector>
 
 #include "Amber/Core/Game.h"
 #include "Amber/Rendering/Backend/IRenderer.h"
 #include "Amber/Rendering/IRenderingStrategy.h"
+#include "Amber/Rendering/RenderSnapshotBuffer.h"
 #include "Amber/Rendering/Scene.h"
 #include "Amber/Rendering/Viewport.h"
 
@@ -18,24 +21,51 @@ namespace Amber
         class RenderingSystem : public Core::ISystem
         {
             public:
-                RenderingSystem(Core::Game &game);
+                // With renderOnSeparateThread, snapshots are left for run() to
+                // render on a thread of the caller's, which must own the context.
+                explicit RenderingSystem(Core::Game &game, bool renderOnSeparateThread = false);
                 virtual ~RenderingSystem() = default;
 
-                virtual bool isOnSeparateThread() const;
+                // The game always runs the system, since snapshots are extracted
+                // on its thread; only rendering may happen elsewhere.
+                virtual bool isOnSeparateThread() const override;
+                virtual Phase getPhase() const override;
 
-                virtual void runSingleIteration();
-                virtual void run();
+                bool isRenderingOnSeparateThread() const;
 
-                virtual void registerEntity(Core::Entity &entity) override;
+                // Extracts and publishes a snapshot of the scene for the current
+                // tick; unless rendering is on a separate thread, it is also
+                // rendered right away.
+                virtual void runSingleIteration() override;
+
+                // Renders published snapshots until stop() is called. Meant to be
+                // run on its own thread while the game keeps ticking.
+                virtual void run() override;
+                void stop();
+
+                virtual void processChanges(const Core::EntityChanges &changes) override;
 
                 Viewport &getViewport();
+                IRenderingStrategy &getRenderingStrategy();
 
             private:
+                void updateEntity(Core::Entity entity);
+                void prepareMesh(const Core::Entity &entity);
+                void render(const RenderSnapshot &snapshot);
+
                 Scene scene;
+                RenderSnapshotBuffer snapshots;
                 Viewport viewport;
                 std::unique_ptr<IRenderer> renderer;
                 std::unique_ptr<IRenderingStrategy> renderingStrategy;
                 Core::Game *game;
+                bool renderOnSeparateThread;
+
+                // Meshes added or changed since the last render. The renderer's
+                // context belongs to the rendering thread, which prepares them
+                // before drawing the next snapshot.
+                std::mutex unpreparedMutex;
+                std::vector<RenderSnapshot::MeshInstance> unpreparedMeshes;
         };
     }
 }
@@ -1,27 +1,282 @@
 #include "Scene.h"
 
+#include <cmath>
+#include <limits>
+
 namespace Amber
 {
     namespace Rendering
     {
-        Scene::RenderMeshCollection &Scene::getMeshes()
+        namespace
+        {
+            Math::BoundingBox getUnboundedBox()
+            {
+                const float infinity = std::numeric_limits<float>::infinity();
+                return Math::BoundingBox { Eigen::Vector3f::Constant(-infinity), Eigen::Vector3f::Constant(infinity) };
+            }
+        }
+
+        void Scene::Index::insert(const Core::Entity &entity, const Math::BoundingBox &box)
+        {
+            std::uint32_t slot;
+            if (freeSlots.empty())
+            {
+                slot = static_cast<std::uint32_t>(slots.size());
+                slots.push_back(entity);
+                proxies.push_back(0);
+                nodes.push_back(Core::TransformHierarchy::None);
+            }
+            else
+            {
+                slot = freeSlots.back();
+                freeSlots.pop_back();
+                slots[slot] = entity;
+            }
+
+            proxies[slot] = hierarchy.createProxy(box, slot);
+            nodes[slot] = entity.getComponent<Core::Transform>()->getNode();
+            slotsByEntity.emplace(key(entity), slot);
+        }
+
+        void Scene::Index::erase(const Core::Entity &entity)
+        {
+            auto it = slotsByEntity.find(key(entity));
+            if (it == slotsByEntity.end())
+            {
+                return;
+            }
+
+            // The hierarchy no longer reports a destroyed proxy, so the slot is
+            // free right away
+            std::uint32_t slot = it->second;
+            hierarchy.destroyProxy(proxies[slot]);
+            nodes[slot] = Core::TransformHierarchy::None;
+            freeSlots.push_back(slot);
+            slotsByEntity.erase(it);
+        }
+
+        void Scene::Index::updateTransform(const Core::Entity &entity, BoxFunction getBox)
+        {
+            auto it = slotsByEntity.find(key(entity));
+            if (it != slotsByEntity.end())
+            {
+                nodes[it->second] = entity.getComponent<Core::Transform>()->getNode();
+                hierarchy.moveProxy(proxies[it->second], getBox(entity));
+            }
+        }
+
+        void Scene::Index::refit(const Core::TransformHierarchy &transforms, std::uint32_t since,
+                                 Core::ComponentSignature required, BoxFunction getBox)
+        {
+            for (std::uint32_t slot = 0; slot < slots.size(); slot++)
+            {
+                // Free slots have no node. Entities destroyed or stripped since the
+                // last sync are left alone until they are removed at the next one.
+                const Core::TransformHierarchy::Node node = nodes[slot];
+                if (!transforms.contains(node) || transforms.getLastChange(node) < since)
+                {
+                    continue;
+                }
+
+                if ((slots[slot].getSignature() & required) == required)
+                {
+                    hierarchy.moveProxy(proxies[slot], getBox(slots[slot]));
+                }
+            }
+        }
+
+        Scene::Scene()
+            : transforms(nullptr),
+              lastUpdateCount(0)
+        {
+        }
+
+        const Scene::EntityCollection &Scene::getMeshes() const
+        {
+            return meshes.getEntities();
+        }
+
+        const Scene::EntityCollection &Scene::getLights() const
+        {
+            return lights.getEntities();
+        }
+
+        bool Scene::addMesh(const Core::Entity &mesh)
+        {
+            if (!this->meshes.insert(mesh))
+            {
+                return false;
+            }
+
+            watchTransforms(mesh);
+            meshIndex.insert(mesh, getMeshBox(mesh));
+            return true;
+        }
+
+        bool Scene::removeMesh(const Core::Entity &mesh)
+        {
+            if (!this->meshes.erase(mesh))
+            {
+                return false;
+            }
+
+            meshIndex.erase(mesh);
+            releaseTransforms();
+            return true;
+        }
+
+        bool Scene::addLight(const Core::Entity &light)
+        {
+            if (!this->lights.insert(light))
+            {
+                return false;
+            }
+
+            watchTransforms(light);
+            lightIndex.insert(light, getLightBox(light));
+            return true;
+        }
+
+        bool Scene::removeLight(const Core::Entity &light)
+        {
+            if (!this->lights.erase(light))
+            {
+                return false;
+            }
+
+            lightIndex.erase(light);
+            releaseTransforms();
+            return true;
+        }
+
+        void Scene::updateTransform(const Core::Entity &entity)
         {
-            return meshes;
+            if (entity.hasComponent<Core::Transform>())
+            {
+                meshIndex.updateTransform(entity, &Scene::getMeshBox);
+                lightIndex.updateTransform(entity, &Scene::getLightBox);
+            }
         }
 
-        Scene::RenderLightCollection &Scene::getLights()
+        void Scene::update(Utilities::JobSystem *jobSystem)
         {
-            return lights;
+            // A box spans the previous and the current world transform, so it
+            // changes in the update that moved the node and again in the next.
+            // Moves inside a proxy's enlarged box cost nothing in the hierarchy.
+            if (transforms != nullptr && transforms->getUpdateCount() != lastUpdateCount)
+            {
+                meshIndex.refit(*transforms, lastUpdateCount, Core::componentSignature<Mesh, Core::Transform>(),
+                                &Scene::getMeshBox);
+                lightIndex.refit(*transforms, lastUpdateCount, Core::componentSignature<Light, Core::Transform>(),
+                                 &Scene::getLightBox);
+
+                lastUpdateCount = transforms->getUpdateCount();
+            }
+
+            meshIndex.hierarchy.update(jobSystem);
+            lightIndex.hierarchy.update(jobSystem);
         }
 
-        void Scene::addMesh(Scene::RenderMesh mesh)
+        void Scene::queryMeshes(const Math::Frustum &frustum,
+                                const std::function<void(const Core::Entity &)> &visit) const
         {
-            this->meshes.push_back(std::move(mesh));
+            meshIndex.hierarchy.query(frustum, [this, &visit](std::uint32_t slot)
+            {
+                visit(meshIndex.slots[slot]);
+            });
         }
 
-        void Scene::addLight(Scene::RenderLight light)
+        void Scene::queryMeshes(const Math::BoundingSphere &sphere,
+                                const std::function<void(const Core::Entity &)> &visit) const
         {
-            this->lights.push_back(std::move(light));
+            meshIndex.hierarchy.query(sphere, [this, &visit](std::uint32_t slot)
+            {
+                visit(meshIndex.slots[slot]);
+            });
+        }
+
+        void Scene::queryLights(const Math::Frustum &frustum,
+                                const std::function<void(const Core::Entity &)> &visit) const
+        {
+            lightIndex.hierarchy.query(frustum, [this, &visit](std::uint32_t slot)
+            {
+                visit(lightIndex.slots[slot]);
+            });
+        }
+
+        void Scene::queryLights(const Math::BoundingSphere &sphere,
+                                const std::function<void(const Core::Entity &)> &visit) const
+        {
+            lightIndex.hierarchy.query(sphere, [this, &visit](std::uint32_t slot)
+            {
+                visit(lightIndex.slots[slot]);
+            });
+        }
+
+        void Scene::raycastMeshes(const Eigen::Vector3f &origin, const Eigen::Vector3f &direction, float maxDistance,
+                                  const std::function<void(const Core::Entity &, float)> &visit) const
+        {
+            meshIndex.hierarchy.raycast(origin, direction, maxDistance, [this, &visit](std::uint32_t slot, float distance)
+            {
+                visit(meshIndex.slots[slot], distance);
+            });
+        }
+
+        void Scene::watchTransforms(const Core::Entity &entity)
+        {
+            // A new world brings its own hierarchy, whose nodes all count as changed
+            const Core::TransformHierarchy *hierarchy = &entity.getComponent<Core::Transform>()->getHierarchy();
+            if (hierarchy != transforms)
+            {
+                transforms = hierarchy;
+                lastUpdateCount = 0;
+            }
+        }
+
+        void Scene::releaseTransforms()
+        {
+            // Replacing the world empties the scene before its hierarchy goes
+            if (meshes.getEntities().empty() && lights.getEntities().empty())
+            {
+                transforms = nullptr;
+            }
+        }
+
+        std::uint64_t Scene::key(const Core::Entity &entity)
+        {
+            Core::EntityId id = entity.getId();
+            return (static_cast<std::uint64_t>(id.generation) << 32) | id.index;
+        }
+
+        Math::BoundingBox Scene::getMeshBox(const Core::Entity &entity)
+        {
+            const Math::BoundingBox &bounds = entity.getComponent<Mesh>()->getBoundingBox();
+            if (bounds.isEmpty())
+            {
+                return getUnboundedBox();
+            }
+
+            // Cover both ends of the tick, frames interpolate between them
+            const Core::Transform &transform = *entity.getComponent<Core::Transform>();
+            Math::BoundingBox previous = bounds.transformed(transform.getPreviousTransform());
+            Math::BoundingBox current = bounds.transformed(transform.getTransform());
+
+            return Math::BoundingBox { previous.min.cwiseMin(current.min), previous.max.cwiseMax(current.max) };
+        }
+
+        Math::BoundingBox Scene::getLightBox(const Core::Entity &entity)
+        {
+            float range = entity.getComponent<Light>()->getRange();
+            if (!std::isfinite(range))
+            {
+                return getUnboundedBox();
+            }
+
+            const Core::Transform &transform = *entity.getComponent<Core::Transform>();
+            Eigen::Vector3f previous = transform.getPreviousTransform().topRightCorner<3, 1>();
+            Eigen::Vector3f current = transform.getTransform().topRightCorner<3, 1>();
+
+            return Math::BoundingBox { previous.cwiseMin(current).array() - range, previous.cwiseMax(current).array() + range };
         }
     }
 }
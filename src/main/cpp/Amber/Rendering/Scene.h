@@ -1,8 +1,20 @@
 #ifndef SCENE_H
 #define SCENE_H
 
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+#include <Eigen/Core>
+
 #include "Amber/Core/Entity.h"
+#include "Amber/Core/EntitySet.h"
 #include "Amber/Core/Transform.h"
+#include "Amber/Core/TransformHierarchy.h"
+#include "Amber/Math/Bounds.h"
+#include "Amber/Math/Frustum.h"
+#include "Amber/Rendering/BoundingVolumeHierarchy.h"
 #include "Amber/Rendering/Mesh.h"
 #include "Amber/Rendering/Material.h"
 #include "Amber/Rendering/Light.h"
@@ -17,21 +29,86 @@ namespace Amber
                 typedef Core::Entity::Proxy<Mesh, Material, Core::Transform> RenderMesh;
                 typedef Core::Entity::Proxy<Light, Core::Transform> RenderLight;
 
-                typedef std::vector<RenderMesh> RenderMeshCollection;
-                typedef std::vector<RenderLight> RenderLightCollection;
+                // Entities are kept rather than component pointers, which move
+                // whenever the world's storage changes.
+                typedef std::vector<Core::Entity> EntityCollection;
 
-                Scene() = default;
+                Scene();
                 ~Scene() = default;
 
-                RenderMeshCollection &getMeshes();
-                RenderLightCollection &getLights();
+                const EntityCollection &getMeshes() const;
+                const EntityCollection &getLights() const;
+
+                // Return whether the entity was added or removed
+                bool addMesh(const Core::Entity &mesh);
+                bool removeMesh(const Core::Entity &mesh);
+                bool addLight(const Core::Entity &light);
+                bool removeLight(const Core::Entity &light);
+
+                // Rereads the transform of an entity whose Transform component
+                // was replaced, which may be another node of the hierarchy
+                void updateTransform(const Core::Entity &entity);
 
-                void addMesh(RenderMesh mesh);
-                void addLight(RenderLight light);
+                // Moves the entities whose world transform changed since the last
+                // call to where their transform put them. Index rebuilds run on
+                // the job system when one is given.
+                void update(Utilities::JobSystem *jobSystem = nullptr);
+
+                // Visit the entities whose bounds may intersect, as of the last update
+                void queryMeshes(const Math::Frustum &frustum, const std::function<void(const Core::Entity &)> &visit) const;
+                void queryMeshes(const Math::BoundingSphere &sphere,
+                                 const std::function<void(const Core::Entity &)> &visit) const;
+                void queryLights(const Math::Frustum &frustum, const std::function<void(const Core::Entity &)> &visit) const;
+                void queryLights(const Math::BoundingSphere &sphere,
+                                 const std::function<void(const Core::Entity &)> &visit) const;
+
+                // Visits the meshes whose bounds the ray enters within maxDistance,
+                // in no particular order, with the distance at which it does
+                void raycastMeshes(const Eigen::Vector3f &origin, const Eigen::Vector3f &direction, float maxDistance,
+                                   const std::function<void(const Core::Entity &, float)> &visit) const;
 
             private:
-                RenderMeshCollection meshes;
-                RenderLightCollection lights;
+                typedef Math::BoundingBox (*BoxFunction)(const Core::Entity &entity);
+
+                // Entities of one kind in a hierarchy, whose proxies carry the
+                // entity's slot as user data. Slots also hold the proxy and the
+                // transform node, free ones have no node.
+                struct Index
+                {
+                    BoundingVolumeHierarchy hierarchy;
+                    std::unordered_map<std::uint64_t, std::uint32_t> slotsByEntity;
+                    std::vector<Core::Entity> slots;
+                    std::vector<BoundingVolumeHierarchy::Proxy> proxies;
+                    std::vector<Core::TransformHierarchy::Node> nodes;
+                    std::vector<std::uint32_t> freeSlots;
+
+                    void insert(const Core::Entity &entity, const Math::BoundingBox &box);
+                    void erase(const Core::Entity &entity);
+                    void updateTransform(const Core::Entity &entity, BoxFunction getBox);
+
+                    // Moves the proxies of entities that still have the required
+                    // components and whose node changed in update since or later
+                    void refit(const Core::TransformHierarchy &transforms, std::uint32_t since,
+                               Core::ComponentSignature required, BoxFunction getBox);
+                };
+
+                void watchTransforms(const Core::Entity &entity);
+                void releaseTransforms();
+
+                static std::uint64_t key(const Core::Entity &entity);
+                static Math::BoundingBox getMeshBox(const Core::Entity &entity);
+                static Math::BoundingBox getLightBox(const Core::Entity &entity);
+
+                Core::EntitySet meshes;
+                Core::EntitySet lights;
+
+                Index meshIndex;
+                Index lightIndex;
+
+                // Hierarchy of the entities' transforms and its update count as of
+                // the last update()
+                const Core::TransformHierarchy *transforms;
+                std::uint32_t lastUpdateCount;
         };
     }
 }
@@ -4,6 +4,13 @@ namespace Amber
 {
     namespace Rendering
     {
+        Viewport::Viewport()
+            : camera(nullptr),
+              width(0),
+              height(0)
+        {
+        }
+
         int Viewport::getWidth() const
         {
             return width;
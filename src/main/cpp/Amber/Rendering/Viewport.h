@@ -10,7 +10,7 @@ namespace Amber
         class Viewport
         {
             public:
-                Viewport() = default;
+                Viewport();
 
                 int getWidth() const;
                 int getHeight() const;
@@ -28,4 +28,8 @@
 
 #define AMBER_UNUSED(variable) ((void) variable)
 
+#if !defined(AMBER_DISABLE_SIMD) && (defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1))
+#  define AMBER_SSE 1
+#endif
+
 #endif // DEFINES_H
@@ -0,0 +1,118 @@
+#include "FrameArena.h"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace Amber
+{
+    namespace Utilities
+    {
+        namespace
+        {
+            thread_local FrameArena *currentArena = nullptr;
+            thread_local std::unique_ptr<FrameArena> threadArena;
+        }
+
+        FrameArena::FrameArena(std::size_t blockSize)
+            : blockSize(blockSize),
+              top(nullptr),
+              end(nullptr),
+              filledBytes(0),
+              peakBytes(0)
+        {
+        }
+
+        FrameArena::~FrameArena()
+        {
+            if (currentArena == this)
+            {
+                currentArena = nullptr;
+            }
+        }
+
+        FrameArena &FrameArena::getCurrent()
+        {
+            if (currentArena == nullptr)
+            {
+                if (!threadArena)
+                {
+                    threadArena.reset(new FrameArena());
+                }
+
+                currentArena = threadArena.get();
+            }
+
+            return *currentArena;
+        }
+
+        void FrameArena::bind(FrameArena *arena)
+        {
+            currentArena = arena;
+        }
+
+        void *FrameArena::allocate(std::size_t size, std::size_t alignment)
+        {
+            std::uintptr_t address = (reinterpret_cast<std::uintptr_t>(top) + alignment - 1) & ~(alignment - 1);
+            if (top == nullptr || address + size > reinterpret_cast<std::uintptr_t>(end))
+            {
+                addBlock(size + alignment);
+                address = (reinterpret_cast<std::uintptr_t>(top) + alignment - 1) & ~(alignment - 1);
+            }
+
+            top = reinterpret_cast<unsigned char *>(address + size);
+            return reinterpret_cast<void *>(address);
+        }
+
+        void FrameArena::reset()
+        {
+            std::size_t usedBytes = getUsedBytes();
+            peakBytes = std::max(peakBytes, usedBytes);
+
+            if (blocks.size() > 1)
+            {
+                std::size_t size = getReservedBytes();
+                blocks.clear();
+                addBlock(size);
+            }
+
+            filledBytes = 0;
+            top = blocks.empty() ? nullptr : blocks.back().memory.get();
+        }
+
+        std::size_t FrameArena::getUsedBytes() const
+        {
+            return blocks.empty() ? 0 : filledBytes + static_cast<std::size_t>(top - blocks.back().memory.get());
+        }
+
+        std::size_t FrameArena::getPeakBytes() const
+        {
+            return std::max(peakBytes, getUsedBytes());
+        }
+
+        std::size_t FrameArena::getReservedBytes() const
+        {
+            std::size_t size = 0;
+            for (const Block &block : blocks)
+            {
+                size += block.size;
+            }
+
+            return size;
+        }
+
+        void FrameArena::addBlock(std::size_t minimumSize)
+        {
+            // The rest of the current block is wasted until the next reset
+            if (!blocks.empty())
+            {
+                filledBytes += blocks.back().size;
+            }
+
+            std::size_t size = std::max(blockSize, minimumSize);
+            blocks.push_back(Block { std::unique_ptr<unsigned char[]>(new unsigned char[size]), size });
+
+            top = blocks.back().memory.get();
+            end = top + size;
+        }
+    }
+}
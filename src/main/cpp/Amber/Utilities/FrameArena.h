@@ -0,0 +1,132 @@
+#ifndef FRAMEARENA_H
+#define FRAMEARENA_H
+
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "Amber/Utilities/Defines.h"
+
+namespace Amber
+{
+    namespace Utilities
+    {
+        // A bump allocator for data that does not outlive the current frame.
+        // Freeing is a no-op, reset() releases everything at once. Memory is
+        // kept between frames, after a frame that needed more than one block
+        // the blocks are merged, so that steady frames never allocate.
+        class AMBER_EXPORTS FrameArena
+        {
+            public:
+                static const std::size_t DefaultBlockSize = 64 * 1024;
+
+                explicit FrameArena(std::size_t blockSize = DefaultBlockSize);
+                FrameArena(const FrameArena &other) = delete;
+                ~FrameArena();
+
+                FrameArena &operator =(const FrameArena &other) = delete;
+
+                // The arena bound to the calling thread, each thread has its own
+                // unless one was bound with bind()
+                static FrameArena &getCurrent();
+                static void bind(FrameArena *arena);
+
+                void *allocate(std::size_t size, std::size_t alignment);
+
+                // Invalidates everything allocated since the last reset
+                void reset();
+
+                // Bytes allocated in the current frame, the most any frame used
+                // and what the arena holds from the system allocator
+                std::size_t getUsedBytes() const;
+                std::size_t getPeakBytes() const;
+                std::size_t getReservedBytes() const;
+
+            private:
+                struct Block
+                {
+                    std::unique_ptr<unsigned char[]> memory;
+                    std::size_t size;
+                };
+
+                void addBlock(std::size_t minimumSize);
+
+                std::size_t blockSize;
+                std::vector<Block> blocks;
+                unsigned char *top;
+                unsigned char *end;
+
+                // Bytes in blocks before the current one
+                std::size_t filledBytes;
+                std::size_t peakBytes;
+        };
+
+        // Standard allocator on top of a frame arena, the current thread's by default
+        template <typename T>
+        class FrameAllocator
+        {
+            public:
+                typedef T value_type;
+
+                FrameAllocator()
+                    : arena(&FrameArena::getCurrent())
+                {
+                }
+
+                explicit FrameAllocator(FrameArena &arena)
+                    : arena(&arena)
+                {
+                }
+
+                template <typename U>
+                FrameAllocator(const FrameAllocator<U> &other)
+                    : arena(other.getArena())
+                {
+                }
+
+                T *allocate(std::size_t count)
+                {
+                    if (count > std::numeric_limits<std::size_t>::max() / sizeof(T))
+                    {
+                        throw std::bad_alloc();
+                    }
+
+                    return static_cast<T *>(arena->allocate(count * sizeof(T), alignof(T)));
+                }
+
+                void deallocate(T *, std::size_t)
+                {
+                }
+
+                FrameArena *getArena() const
+                {
+                    return arena;
+                }
+
+            private:
+                FrameArena *arena;
+        };
+
+        template <typename T, typename U>
+        bool operator ==(const FrameAllocator<T> &lhs, const FrameAllocator<U> &rhs)
+        {
+            return lhs.getArena() == rhs.getArena();
+        }
+
+        template <typename T, typename U>
+        bool operator !=(const FrameAllocator<T> &lhs, const FrameAllocator<U> &rhs)
+        {
+            return !(lhs == rhs);
+        }
+
+        template <typename T>
+        using FrameVector = std::vector<T, FrameAllocator<T>>;
+
+        typedef std::basic_string<char, std::char_traits<char>, FrameAllocator<char>> FrameString;
+    }
+}
+
+#endif // FRAMEARENA_H
@@ -0,0 +1,33 @@
+#ifndef INDEXSEQUENCE_H
+#define INDEXSEQUENCE_H
+
+#include <cstddef>
+
+namespace Amber
+{
+    namespace Utilities
+    {
+        // C++11 stand-in for std::index_sequence, used to expand parameter
+        // packs by position
+        template <std::size_t... Is>
+        struct IndexSequence
+        {
+        };
+
+        template <std::size_t N, std::size_t... Is>
+        struct MakeIndexSequenceHelper : MakeIndexSequenceHelper<N - 1, N - 1, Is...>
+        {
+        };
+
+        template <std::size_t... Is>
+        struct MakeIndexSequenceHelper<0, Is...>
+        {
+            typedef IndexSequence<Is...> Type;
+        };
+
+        template <std::size_t N>
+        using MakeIndexSequence = typename MakeIndexSequenceHelper<N>::Type;
+    }
+}
+
+#endif // INDEXSEQUENCE_H
@@ -0,0 +1,376 @@
+#include "JobSystem.h"
+
+#include <iterator>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#elif defined(WIN32) || defined(_WIN32)
+#define NOMINMAX
+#include <windows.h>
+#endif
+
+namespace Amber
+{
+    namespace Utilities
+    {
+        namespace
+        {
+            // Workers record which system and queue they belong to
+            thread_local const JobSystem *currentSystem = nullptr;
+            thread_local std::size_t currentQueue = 0;
+
+            thread_local const void *currentOwner = nullptr;
+
+            void pinThread(std::thread &thread, std::size_t core)
+            {
+#if defined(__linux__)
+                cpu_set_t cpus;
+                CPU_ZERO(&cpus);
+                CPU_SET(core % CPU_SETSIZE, &cpus);
+                pthread_setaffinity_np(thread.native_handle(), sizeof(cpus), &cpus);
+#elif defined(WIN32) || defined(_WIN32)
+                SetThreadAffinityMask(thread.native_handle(), DWORD_PTR(1) << (core % (sizeof(DWORD_PTR) * 8)));
+#else
+                AMBER_UNUSED(thread);
+                AMBER_UNUSED(core);
+#endif
+            }
+        }
+
+        struct JobSystem::Counter::State
+        {
+            std::atomic<std::size_t> pending;
+            std::mutex mutex;
+            std::vector<Job> continuations;
+        };
+
+        JobSystem::OwnerScope::OwnerScope(const void *owner)
+            : previous(currentOwner)
+        {
+            currentOwner = owner;
+        }
+
+        JobSystem::OwnerScope::~OwnerScope()
+        {
+            currentOwner = previous;
+        }
+
+        JobSystem::Counter::Counter()
+            : state(std::make_shared<State>())
+        {
+            state->pending = 0;
+        }
+
+        bool JobSystem::Counter::isDone() const
+        {
+            return state->pending.load(std::memory_order_acquire) == 0;
+        }
+
+        JobSystem::JobSystem()
+            : JobSystem(std::max(1u, std::thread::hardware_concurrency()) - 1)
+        {
+        }
+
+        JobSystem::JobSystem(std::size_t workerCount, bool pinWorkers)
+            : frame(0),
+              queuedJobs(0),
+              sleepingWorkers(0),
+              stopping(false)
+        {
+            // The last queue is shared by all threads that are not workers
+            for (std::size_t i = 0; i <= workerCount; i++)
+            {
+                queues.emplace_back(new Queue());
+            }
+
+            for (std::size_t i = 0; i < workerCount; i++)
+            {
+                frameArenas.emplace_back(new FrameArena());
+            }
+
+            std::size_t coreCount = std::max(1u, std::thread::hardware_concurrency());
+            for (std::size_t i = 0; i < workerCount; i++)
+            {
+                workers.emplace_back(&JobSystem::work, this, i);
+
+                // Core 0 is left to the thread that created the system
+                if (pinWorkers)
+                {
+                    pinThread(workers.back(), (i + 1) % coreCount);
+                }
+            }
+        }
+
+        JobSystem::~JobSystem()
+        {
+            {
+                std::lock_guard<std::mutex> lock(sleepMutex);
+                stopping = true;
+            }
+
+            jobAvailable.notify_all();
+            for (std::thread &worker : workers)
+            {
+                worker.join();
+            }
+        }
+
+        std::size_t JobSystem::getWorkerCount() const
+        {
+            return workers.size();
+        }
+
+        const FrameArena &JobSystem::getFrameArena(std::size_t worker) const
+        {
+            return *frameArenas.at(worker);
+        }
+
+        void JobSystem::resetFrameArenas()
+        {
+            frame.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        void JobSystem::submit(std::function<void()> job)
+        {
+            push(Job { std::move(job), currentOwner });
+        }
+
+        void JobSystem::submit(std::function<void()> job, const Counter &counter)
+        {
+            counter.state->pending++;
+
+            std::shared_ptr<Counter::State> state = counter.state;
+            push(Job { [this, job, state] ()
+            {
+                job();
+                finish(*state);
+            }, currentOwner });
+        }
+
+        void JobSystem::submitAfter(const Counter &dependency, std::function<void()> job)
+        {
+            std::unique_lock<std::mutex> lock(dependency.state->mutex);
+            if (dependency.state->pending.load(std::memory_order_acquire) > 0)
+            {
+                dependency.state->continuations.push_back(Job { std::move(job), currentOwner });
+                return;
+            }
+
+            lock.unlock();
+            push(Job { std::move(job), currentOwner });
+        }
+
+        void JobSystem::submitAfter(const Counter &dependency, std::function<void()> job, const Counter &counter)
+        {
+            // Counted now, so that waiting on counter also waits for dependency
+            counter.state->pending++;
+
+            std::shared_ptr<Counter::State> state = counter.state;
+            submitAfter(dependency, [this, job, state] ()
+            {
+                job();
+                finish(*state);
+            });
+        }
+
+        void JobSystem::wait(const Counter &counter)
+        {
+            std::size_t queueIndex = getQueueIndex();
+            while (!counter.isDone())
+            {
+                if (!tryRunJob(queueIndex))
+                {
+                    std::this_thread::yield();
+                }
+            }
+        }
+
+        bool JobSystem::runPendingJob()
+        {
+            return tryRunJob(getQueueIndex());
+        }
+
+        void JobSystem::parallelFor(std::size_t count, const std::function<void(std::size_t)> &function, std::size_t grainSize)
+        {
+            if (count == 0)
+            {
+                return;
+            }
+
+            if (grainSize == 0)
+            {
+                grainSize = getGrainSize(count);
+            }
+
+            Counter counter;
+            splitRange(0, count, grainSize, function, counter);
+            wait(counter);
+        }
+
+        std::size_t JobSystem::getGrainSize(std::size_t count) const
+        {
+            // A few batches per thread leave room for stealing to even out the load
+            return std::max<std::size_t>(1, count / ((workers.size() + 1) * 4));
+        }
+
+        std::size_t JobSystem::getQueueIndex() const
+        {
+            return currentSystem == this ? currentQueue : workers.size();
+        }
+
+        void JobSystem::push(Job job)
+        {
+            if (workers.empty())
+            {
+                run(job);
+                return;
+            }
+
+            Queue &queue = *queues[getQueueIndex()];
+            {
+                std::lock_guard<std::mutex> lock(queue.mutex);
+                queue.jobs.push_back(std::move(job));
+            }
+
+            // Pairs with the check in work(), either the sleeper sees the job or we see the sleeper
+            queuedJobs++;
+            if (sleepingWorkers.load() > 0)
+            {
+                {
+                    std::lock_guard<std::mutex> lock(sleepMutex);
+                }
+
+                jobAvailable.notify_one();
+            }
+        }
+
+        bool JobSystem::tryRunJob(std::size_t queueIndex)
+        {
+            // Without an owner any job will do
+            const void *owner = currentOwner;
+            auto isRunnable = [owner] (const Job &job) {
+                return owner == nullptr || job.owner == owner;
+            };
+
+            Job job;
+
+            {
+                Queue &own = *queues[queueIndex];
+                std::lock_guard<std::mutex> lock(own.mutex);
+
+                auto it = std::find_if(own.jobs.rbegin(), own.jobs.rend(), isRunnable);
+                if (it != own.jobs.rend())
+                {
+                    job = std::move(*it);
+                    own.jobs.erase(std::next(it).base());
+                }
+            }
+
+            // Steal the oldest job, for split ranges that is the largest remaining piece
+            for (std::size_t i = 1; !job.function && i < queues.size(); i++)
+            {
+                Queue &victim = *queues[(queueIndex + i) % queues.size()];
+                std::lock_guard<std::mutex> lock(victim.mutex);
+
+                auto it = std::find_if(victim.jobs.begin(), victim.jobs.end(), isRunnable);
+                if (it != victim.jobs.end())
+                {
+                    job = std::move(*it);
+                    victim.jobs.erase(it);
+                }
+            }
+
+            if (!job.function)
+            {
+                return false;
+            }
+
+            queuedJobs--;
+            run(job);
+
+            return true;
+        }
+
+        void JobSystem::run(Job &job)
+        {
+            OwnerScope scope(job.owner);
+            job.function();
+        }
+
+        void JobSystem::finish(Counter::State &state)
+        {
+            if (state.pending.fetch_sub(1, std::memory_order_acq_rel) != 1)
+            {
+                return;
+            }
+
+            std::vector<Job> continuations;
+            {
+                std::lock_guard<std::mutex> lock(state.mutex);
+                continuations.swap(state.continuations);
+            }
+
+            for (Job &continuation : continuations)
+            {
+                push(std::move(continuation));
+            }
+        }
+
+        void JobSystem::splitRange(std::size_t begin, std::size_t end, std::size_t grainSize,
+                                   const std::function<void(std::size_t)> &function, const Counter &counter)
+        {
+            // Hands the upper half to thieves and keeps working on the lower one
+            while (end - begin > grainSize)
+            {
+                std::size_t middle = begin + (end - begin) / 2;
+                submit([this, middle, end, grainSize, &function, counter] ()
+                {
+                    splitRange(middle, end, grainSize, function, counter);
+                }, counter);
+
+                end = middle;
+            }
+
+            for (std::size_t i = begin; i < end; i++)
+            {
+                function(i);
+            }
+        }
+
+        void JobSystem::work(std::size_t index)
+        {
+            currentSystem = this;
+            currentQueue = index;
+            FrameArena::bind(frameArenas[index].get());
+
+            std::uint64_t arenaFrame = frame.load(std::memory_order_relaxed);
+
+            while (true)
+            {
+                // Only between top-level jobs, a job waiting for others runs them nested
+                std::uint64_t currentFrame = frame.load(std::memory_order_relaxed);
+                if (currentFrame != arenaFrame)
+                {
+                    frameArenas[index]->reset();
+                    arenaFrame = currentFrame;
+                }
+
+                if (tryRunJob(index))
+                {
+                    continue;
+                }
+
+                std::unique_lock<std::mutex> lock(sleepMutex);
+                sleepingWorkers++;
+                jobAvailable.wait(lock, [this] () { return stopping || queuedJobs.load() > 0; });
+                sleepingWorkers--;
+
+                if (stopping && queuedJobs.load() == 0)
+                {
+                    return;
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,187 @@
+#ifndef JOBSYSTEM_H
+#define JOBSYSTEM_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Amber/Utilities/Defines.h"
+#include "Amber/Utilities/FrameArena.h"
+
+namespace Amber
+{
+    namespace Utilities
+    {
+        // Runs jobs on a fixed set of worker threads. Each worker pushes to and
+        // pops from the back of its own deque, idle workers steal from the front
+        // of the others'. Threads that are not workers share one extra deque.
+        //
+        // Jobs belong to the owner current on the thread submitting them and run
+        // with it current. A thread waiting while an owner is current only runs
+        // jobs of that owner, so that clients sharing the system, like the games
+        // of a server, do not run each other's work while they wait.
+        class AMBER_EXPORTS JobSystem
+        {
+            public:
+                // Makes owner current on the calling thread for its lifetime
+                class AMBER_EXPORTS OwnerScope
+                {
+                    public:
+                        explicit OwnerScope(const void *owner);
+                        OwnerScope(const OwnerScope &other) = delete;
+                        ~OwnerScope();
+
+                        OwnerScope &operator =(const OwnerScope &other) = delete;
+
+                    private:
+                        const void *previous;
+                };
+
+                // A group of jobs that can be waited for or depended on. Copies
+                // refer to the same group.
+                class AMBER_EXPORTS Counter
+                {
+                    public:
+                        Counter();
+
+                        bool isDone() const;
+
+                    private:
+                        friend class JobSystem;
+
+                        struct State;
+
+                        std::shared_ptr<State> state;
+                };
+
+                // The calling thread takes part in wait(), so by default one worker
+                // fewer than the number of hardware threads is started. Pinned
+                // workers are each bound to their own core where supported.
+                JobSystem();
+                explicit JobSystem(std::size_t workerCount, bool pinWorkers = false);
+                JobSystem(const JobSystem &other) = delete;
+                ~JobSystem();
+
+                JobSystem &operator =(const JobSystem &other) = delete;
+
+                std::size_t getWorkerCount() const;
+
+                // Each worker allocates frame data from its own arena. Ending the
+                // frame does not touch them: every worker resets its own arena
+                // before the next job it takes, so that jobs still running, like
+                // background builds, keep their data. Jobs therefore must not hand
+                // frame data to other threads beyond the frame it was made in.
+                const FrameArena &getFrameArena(std::size_t worker) const;
+                void resetFrameArenas();
+
+                void submit(std::function<void()> job);
+
+                // counter is not done before job has finished
+                void submit(std::function<void()> job, const Counter &counter);
+
+                // Submits job once every job of dependency has finished, right away
+                // if none is pending
+                void submitAfter(const Counter &dependency, std::function<void()> job);
+                void submitAfter(const Counter &dependency, std::function<void()> job, const Counter &counter);
+
+                // Runs pending jobs on the calling thread until counter is done
+                void wait(const Counter &counter);
+
+                // Runs one pending job on the calling thread, if there is any of
+                // the current owner
+                bool runPendingJob();
+
+                // Calls function for every index in [0, count) and returns once all
+                // of them have completed. The range is split in halves down to
+                // grainSize indices, 0 picks a size from the worker count. Safe to
+                // call from inside a job.
+                void parallelFor(std::size_t count, const std::function<void(std::size_t)> &function, std::size_t grainSize = 0);
+
+                // Folds map(i) for every index in [0, count) with reduce, which must
+                // be associative. Partial results are combined in index order.
+                template <typename T, typename Map, typename Reduce>
+                T parallelReduce(std::size_t count, T identity, Map map, Reduce reduce, std::size_t grainSize = 0)
+                {
+                    if (grainSize == 0)
+                    {
+                        grainSize = getGrainSize(count);
+                    }
+
+                    std::size_t batchCount = (count + grainSize - 1) / grainSize;
+                    FrameVector<T> partials(batchCount, identity);
+
+                    parallelFor(batchCount, [&] (std::size_t batch)
+                    {
+                        std::size_t end = std::min(count, (batch + 1) * grainSize);
+
+                        T value = identity;
+                        for (std::size_t i = batch * grainSize; i < end; i++)
+                        {
+                            value = reduce(value, map(i));
+                        }
+
+                        partials[batch] = std::move(value);
+                    }, 1);
+
+                    T result = std::move(identity);
+                    for (T &partial : partials)
+                    {
+                        result = reduce(result, partial);
+                    }
+
+                    return result;
+                }
+
+            private:
+                struct Job
+                {
+                    std::function<void()> function;
+                    const void *owner;
+                };
+
+                struct Queue
+                {
+                    std::deque<Job> jobs;
+                    std::mutex mutex;
+                };
+
+                std::size_t getGrainSize(std::size_t count) const;
+
+                // Index of the calling thread's queue
+                std::size_t getQueueIndex() const;
+
+                void push(Job job);
+                bool tryRunJob(std::size_t queueIndex);
+                void run(Job &job);
+                void finish(Counter::State &state);
+
+                void splitRange(std::size_t begin, std::size_t end, std::size_t grainSize,
+                                const std::function<void(std::size_t)> &function, const Counter &counter);
+
+                void work(std::size_t index);
+
+                std::vector<std::thread> workers;
+                std::vector<std::unique_ptr<Queue>> queues;
+                std::vector<std::unique_ptr<FrameArena>> frameArenas;
+
+                // Advanced by resetFrameArenas(), followed by each worker
+                std::atomic<std::uint64_t> frame;
+
+                std::atomic<std::size_t> queuedJobs;
+                std::atomic<std::size_t> sleepingWorkers;
+                std::mutex sleepMutex;
+                std::condition_variable jobAvailable;
+                bool stopping;
+        };
+    }
+}
+
+#endif // JOBSYSTEM_H
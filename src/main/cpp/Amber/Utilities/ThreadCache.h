@@ -0,0 +1,68 @@
+#ifndef THREADCACHE_H
+#define THREADCACHE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace Amber
+{
+    namespace Utilities
+    {
+        // A few pointers per thread, so that an owner handing each thread its
+        // own object finds it again without a lock. Owners of the same type
+        // share a small table per thread, indexed by their serial, so a thread
+        // alternating between several owners keeps hitting. Owners are told
+        // apart by serial rather than address, which may be reused.
+        template <typename T>
+        class ThreadCache
+        {
+            public:
+                ThreadCache()
+                    : serial(nextSerial++)
+                {
+                }
+
+                ThreadCache(const ThreadCache &other) = delete;
+                ThreadCache &operator =(const ThreadCache &other) = delete;
+
+                // What the calling thread last set, null if an owner sharing the
+                // slot has set something since
+                T *get() const
+                {
+                    const Entry &entry = entries[serial % EntryCount];
+                    return entry.serial == serial ? entry.value : nullptr;
+                }
+
+                void set(T *value)
+                {
+                    entries[serial % EntryCount] = Entry { serial, value };
+                }
+
+            private:
+                struct Entry
+                {
+                    std::uint64_t serial;
+                    T *value;
+                };
+
+                static const std::size_t EntryCount = 8;
+
+                static std::atomic<std::uint64_t> nextSerial;
+                static thread_local Entry entries[EntryCount];
+
+                std::uint64_t serial;
+        };
+
+        template <typename T>
+        std::atomic<std::uint64_t> ThreadCache<T>::nextSerial(1);
+
+        template <typename T>
+        const std::size_t ThreadCache<T>::EntryCount;
+
+        template <typename T>
+        thread_local typename ThreadCache<T>::Entry ThreadCache<T>::entries[EntryCount] = {};
+    }
+}
+
+#endif // THREADCACHE_H
@@ -0,0 +1,217 @@
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+
+#include "Amber/Core/Transform.h"
+#include "Amber/Core/World.h"
+#include "Amber/IO/AmberModelFormat.h"
+#include "Amber/IO/AmberModelLoader.h"
+#include "Amber/IO/AmberModelWriter.h"
+#include "Amber/Math/Bounds.h"
+#include "Amber/Rendering/Light.h"
+#include "Amber/Rendering/Material.h"
+#include "Amber/Rendering/Mesh.h"
+
+#include "Test.h"
+
+using namespace Amber;
+
+namespace
+{
+    const char *const FileName = "AmberModelTest.amber";
+    const char *const CorruptFileName = "AmberModelTest.corrupt.amber";
+
+    Eigen::Matrix4f createTransform(const Eigen::Vector3f &translation, float angle)
+    {
+        Eigen::Affine3f transform(Eigen::Translation3f(translation) * Eigen::AngleAxisf(angle, Eigen::Vector3f::UnitY()));
+        return transform.matrix();
+    }
+
+    // Without an active context the writer stores empty payloads and the
+    // loader creates no buffers, everything else still round trips
+    void populate(Core::World &world)
+    {
+        Core::Entity parent = world.create();
+        parent.emplaceComponent<Core::Transform>(createTransform(Eigen::Vector3f(1.0f, 2.0f, 3.0f), 0.5f), world.getTransformHierarchy());
+
+        Rendering::Layout layout;
+        layout.insertAttribute(Rendering::Layout::Attribute("mdl_Position", Rendering::Layout::ComponentType::Float, 3));
+        layout.insertAttribute(Rendering::Layout::Attribute("mdl_TexCoord", Rendering::Layout::ComponentType::UInt16, 2));
+
+        Rendering::Mesh *mesh = parent.emplaceComponent<Rendering::Mesh>();
+        mesh->setLayout(layout);
+        mesh->setVertexCount(24);
+        mesh->setPrimitiveCount(12);
+        mesh->setBoundingBox(Math::BoundingBox{Eigen::Vector3f(-1.0f, -2.0f, -3.0f), Eigen::Vector3f(1.0f, 2.0f, 3.0f)});
+        mesh->setBoundingSphere(Math::BoundingSphere{Eigen::Vector3f(0.5f, 0.0f, 0.0f), 4.0f});
+
+        Rendering::Material *material = parent.emplaceComponent<Rendering::Material>();
+        material->setEmission(0.25f);
+        material->setTranslucency(0.5f);
+        material->setReflectivity(0.75f);
+        material->setIndexOfRefraction(1.5f);
+        material->setDiffuseColor(Eigen::Vector4f(0.1f, 0.2f, 0.3f, 1.0f));
+
+        // Adding components moved the parent's, fetch its transform afterwards
+        Core::Entity child = world.create();
+        child.emplaceComponent<Core::Transform>(createTransform(Eigen::Vector3f(0.0f, 5.0f, 0.0f), 1.0f), *parent.getComponent<Core::Transform>());
+
+        Rendering::Light *light = child.emplaceComponent<Rendering::Light>(Rendering::Light::Type::Point);
+        light->setAttenuationCoefficients(Eigen::Vector3f(1.0f, 0.1f, 0.01f));
+        light->setColor(Eigen::Vector4f(1.0f, 0.5f, 0.25f, 1.0f));
+
+        world.getTransformHierarchy().update();
+    }
+
+    void checkRoundTrip(const std::vector<Core::Entity> &entities, Core::World &world)
+    {
+        TEST_CHECK(entities.size() == 2);
+        if (entities.size() != 2)
+        {
+            return;
+        }
+
+        world.getTransformHierarchy().update();
+
+        const Core::Entity &parent = entities[0];
+        const Core::Entity &child = entities[1];
+
+        TEST_CHECK((parent.hasComponents<Core::Transform, Rendering::Mesh, Rendering::Material>()));
+        TEST_CHECK(!parent.hasComponent<Rendering::Light>());
+        TEST_CHECK((child.hasComponents<Core::Transform, Rendering::Light>()));
+        TEST_CHECK(!child.hasComponent<Rendering::Mesh>());
+
+        const Core::Transform *parentTransform = parent.getComponent<Core::Transform>();
+        const Core::Transform *childTransform = child.getComponent<Core::Transform>();
+        Eigen::Matrix4f expectedParent = createTransform(Eigen::Vector3f(1.0f, 2.0f, 3.0f), 0.5f);
+        Eigen::Matrix4f expectedChild = expectedParent * createTransform(Eigen::Vector3f(0.0f, 5.0f, 0.0f), 1.0f);
+        TEST_CHECK(!parentTransform->hasParent());
+        TEST_CHECK(childTransform->hasParent());
+        TEST_CHECK(parentTransform->getTransform().isApprox(expectedParent, 1e-5f));
+        TEST_CHECK(childTransform->getTransform().isApprox(expectedChild, 1e-5f));
+
+        const Rendering::Mesh *mesh = parent.getComponent<Rendering::Mesh>();
+        TEST_CHECK(mesh->getVertexCount() == 24);
+        TEST_CHECK(mesh->getPrimitiveCount() == 12);
+        TEST_CHECK(!mesh->getVertexBuffer().isValid());
+        TEST_CHECK(!mesh->getIndexBuffer().isValid());
+
+        const Rendering::Layout::AttributeList &attributes = mesh->getLayout().getAttributes();
+        TEST_CHECK(attributes.size() == 2);
+        if (attributes.size() == 2)
+        {
+            TEST_CHECK(attributes[0] == Rendering::Layout::Attribute("mdl_Position", Rendering::Layout::ComponentType::Float, 3));
+            TEST_CHECK(attributes[1] == Rendering::Layout::Attribute("mdl_TexCoord", Rendering::Layout::ComponentType::UInt16, 2));
+        }
+
+        TEST_CHECK(mesh->getBoundingBox().min == Eigen::Vector3f(-1.0f, -2.0f, -3.0f));
+        TEST_CHECK(mesh->getBoundingBox().max == Eigen::Vector3f(1.0f, 2.0f, 3.0f));
+        TEST_CHECK(mesh->getBoundingSphere().center == Eigen::Vector3f(0.5f, 0.0f, 0.0f));
+        TEST_CHECK(mesh->getBoundingSphere().radius == 4.0f);
+
+        const Rendering::Material *material = parent.getComponent<Rendering::Material>();
+        TEST_CHECK(material->getEmission() == 0.25f);
+        TEST_CHECK(material->getTranslucency() == 0.5f);
+        TEST_CHECK(material->getReflectivity() == 0.75f);
+        TEST_CHECK(material->getIndexOfRefraction() == 1.5f);
+        TEST_CHECK(material->getDiffuseColor() == Eigen::Vector4f(0.1f, 0.2f, 0.3f, 1.0f));
+        TEST_CHECK(!material->getDiffuseTexture().isValid());
+
+        const Rendering::Light *light = child.getComponent<Rendering::Light>();
+        TEST_CHECK(light->getType() == Rendering::Light::Type::Point);
+        TEST_CHECK(light->getAttenuationCoefficients() == Eigen::Vector3f(1.0f, 0.1f, 0.01f));
+        TEST_CHECK(light->getColor() == Eigen::Vector4f(1.0f, 0.5f, 0.25f, 1.0f));
+    }
+
+    std::vector<char> readFile(const char *fileName)
+    {
+        std::ifstream stream(fileName, std::ios::binary);
+        return std::vector<char>(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+    }
+
+    void writeFile(const char *fileName, const std::vector<char> &contents)
+    {
+        std::ofstream stream(fileName, std::ios::binary | std::ios::trunc);
+        stream.write(contents.data(), contents.size());
+    }
+
+    bool isRejected(const std::vector<char> &contents)
+    {
+        writeFile(CorruptFileName, contents);
+
+        Core::World world;
+        try
+        {
+            IO::AmberModelLoader().loadModel(CorruptFileName, world);
+        }
+        catch (const std::runtime_error &)
+        {
+            return true;
+        }
+
+        return false;
+    }
+
+    // Counts large enough to wrap around when multiplied by the record size
+    // and truncated files must be refused before anything is read
+    void checkCorruptSnapshots()
+    {
+        std::vector<char> contents = readFile(FileName);
+        TEST_CHECK(contents.size() >= sizeof(IO::AmberModelFormat::Header));
+        if (contents.size() < sizeof(IO::AmberModelFormat::Header))
+        {
+            return;
+        }
+
+        IO::AmberModelFormat::Header header;
+        std::memcpy(&header, contents.data(), sizeof(header));
+
+        std::vector<char> corrupt = contents;
+        IO::AmberModelFormat::Header wrapping = header;
+        wrapping.textures.count = ~std::uint64_t(0) / sizeof(IO::AmberModelFormat::Texture) + 2;
+        std::memcpy(corrupt.data(), &wrapping, sizeof(wrapping));
+        TEST_CHECK(isRejected(corrupt));
+
+        IO::AmberModelFormat::Header overlong = header;
+        overlong.meshes.count = contents.size();
+        std::memcpy(corrupt.data(), &overlong, sizeof(overlong));
+        TEST_CHECK(isRejected(corrupt));
+
+        IO::AmberModelFormat::Header newer = header;
+        newer.version = IO::AmberModelFormat::Version + 1;
+        std::memcpy(corrupt.data(), &newer, sizeof(newer));
+        TEST_CHECK(isRejected(corrupt));
+
+        TEST_CHECK(isRejected(std::vector<char>(contents.begin(), contents.begin() + sizeof(header) - 1)));
+        TEST_CHECK(isRejected(std::vector<char>(contents.begin(), contents.end() - IO::AmberModelFormat::Alignment)));
+
+        std::remove(CorruptFileName);
+    }
+}
+
+int main()
+{
+    {
+        Core::World world;
+        populate(world);
+        IO::AmberModelWriter().saveWorld(FileName, world);
+    }
+
+    {
+        Core::World world;
+        std::vector<Core::Entity> entities = IO::AmberModelLoader().loadModel(FileName, world);
+        checkRoundTrip(entities, world);
+    }
+
+    checkCorruptSnapshots();
+    std::remove(FileName);
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,168 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <set>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "Amber/Math/Bounds.h"
+#include "Amber/Math/Frustum.h"
+#include "Amber/Rendering/BoundingVolumeHierarchy.h"
+#include "Amber/Rendering/Camera.h"
+#include "Amber/Utilities/JobSystem.h"
+
+#include "Test.h"
+
+using namespace Amber;
+
+namespace
+{
+    bool intersects(const Math::BoundingSphere &sphere, const Math::BoundingBox &box)
+    {
+        Eigen::Vector3f closest = sphere.center.cwiseMax(box.min).cwiseMin(box.max);
+        return (closest - sphere.center).squaredNorm() <= sphere.radius * sphere.radius;
+    }
+
+    bool intersects(const Eigen::Vector3f &origin, const Eigen::Vector3f &direction, float maxDistance, const Math::BoundingBox &box)
+    {
+        float entry = 0.0f;
+        float exit = maxDistance;
+        for (int axis = 0; axis < 3; axis++)
+        {
+            float first = (box.min[axis] - origin[axis]) / direction[axis];
+            float second = (box.max[axis] - origin[axis]) / direction[axis];
+            entry = std::max(entry, std::min(first, second));
+            exit = std::min(exit, std::max(first, second));
+        }
+
+        return entry <= exit;
+    }
+
+    // Queries may report more than what intersects, since the hierarchy keeps
+    // enlarged boxes, but never less
+    struct Checker
+    {
+        const std::vector<Math::BoundingBox> &boxes;
+        const std::vector<bool> &alive;
+        const Rendering::BoundingVolumeHierarchy &hierarchy;
+
+        void check(const Math::Frustum &frustum, const Math::BoundingSphere &sphere,
+                   const Eigen::Vector3f &origin, const Eigen::Vector3f &direction) const
+        {
+            std::set<std::uint32_t> frustumHits, sphereHits, rayHits;
+            hierarchy.query(frustum, [&frustumHits] (std::uint32_t id) { frustumHits.insert(id); });
+            hierarchy.query(sphere, [&sphereHits] (std::uint32_t id) { sphereHits.insert(id); });
+            hierarchy.raycast(origin, direction, 1000.0f, [&rayHits] (std::uint32_t id, float distance) {
+                TEST_CHECK(distance >= 0.0f && distance <= 1000.0f);
+                rayHits.insert(id);
+            });
+
+            for (std::uint32_t i = 0; i < boxes.size(); i++)
+            {
+                if (!alive[i])
+                {
+                    TEST_CHECK(frustumHits.count(i) == 0 && sphereHits.count(i) == 0 && rayHits.count(i) == 0);
+                    continue;
+                }
+
+                TEST_CHECK(!frustum.intersects(boxes[i]) || frustumHits.count(i) == 1);
+                TEST_CHECK(!intersects(sphere, boxes[i]) || sphereHits.count(i) == 1);
+                TEST_CHECK(!intersects(origin, direction, 1000.0f, boxes[i]) || rayHits.count(i) == 1);
+            }
+        }
+    };
+}
+
+int main()
+{
+    // Frustum against boxes and spheres on either side of its planes
+    Rendering::Camera camera;
+    camera.setLookAt(Eigen::Vector3f(0.0f, 0.0f, 0.0f), Eigen::Vector3f(0.0f, 0.0f, -1.0f), Eigen::Vector3f(0.0f, 1.0f, 0.0f));
+    camera.setPerspectiveProjection(60.0f, 1.5f, 0.1f, 100.0f);
+    Math::Frustum frustum = camera.getFrustum();
+
+    TEST_CHECK(frustum.intersects(Math::BoundingSphere { Eigen::Vector3f(0.0f, 0.0f, -10.0f), 1.0f }));
+    TEST_CHECK(!frustum.intersects(Math::BoundingSphere { Eigen::Vector3f(0.0f, 0.0f, 10.0f), 1.0f }));
+    TEST_CHECK(!frustum.intersects(Math::BoundingSphere { Eigen::Vector3f(0.0f, 0.0f, -101.0f), 0.5f }));
+    TEST_CHECK(frustum.intersects(Math::BoundingBox { Eigen::Vector3f(-1.0f, -1.0f, -200.0f), Eigen::Vector3f(1.0f, 1.0f, -5.0f) }));
+    TEST_CHECK(!frustum.intersects(Math::BoundingBox { Eigen::Vector3f(50.0f, -1.0f, -6.0f), Eigen::Vector3f(51.0f, 1.0f, -5.0f) }));
+
+    // Hierarchy queries against brute force, while proxies move, die and are born
+    const std::uint32_t ProxyCount = 20000;
+
+    std::mt19937 random(7);
+    std::uniform_real_distribution<float> position(-150.0f, 150.0f), size(0.1f, 3.0f), step(-2.0f, 2.0f);
+
+    std::vector<Math::BoundingBox> boxes(ProxyCount);
+    std::vector<bool> alive(ProxyCount, true);
+    std::vector<Rendering::BoundingVolumeHierarchy::Proxy> proxies(ProxyCount);
+
+    Rendering::BoundingVolumeHierarchy hierarchy;
+    for (std::uint32_t i = 0; i < ProxyCount; i++)
+    {
+        Eigen::Vector3f center(position(random), position(random), position(random));
+        float extent = size(random);
+        boxes[i] = Math::BoundingBox { center.array() - extent, center.array() + extent };
+        proxies[i] = hierarchy.createProxy(boxes[i], i);
+    }
+
+    // Unbounded proxies are always reported
+    const float Infinity = std::numeric_limits<float>::infinity();
+    const std::uint32_t Unbounded = ProxyCount;
+    hierarchy.createProxy(Math::BoundingBox { Eigen::Vector3f::Constant(-Infinity), Eigen::Vector3f::Constant(Infinity) }, Unbounded);
+
+    hierarchy.update();
+
+    Math::BoundingSphere sphere { Eigen::Vector3f(10.0f, 20.0f, -30.0f), 40.0f };
+    Eigen::Vector3f origin = Eigen::Vector3f::Zero();
+    Eigen::Vector3f direction = boxes[5].getCenter().normalized();
+
+    Checker checker { boxes, alive, hierarchy };
+    checker.check(frustum, sphere, origin, direction);
+
+    std::size_t unboundedHits = 0;
+    hierarchy.query(frustum, [&unboundedHits, Unbounded] (std::uint32_t id) { unboundedHits += id == Unbounded ? 1 : 0; });
+    TEST_CHECK(unboundedHits == 1);
+
+    Utilities::JobSystem jobSystem(3);
+    for (int frame = 0; frame < 20; frame++)
+    {
+        for (std::uint32_t i = 0; i < ProxyCount; i += 7)
+        {
+            if (alive[i])
+            {
+                Eigen::Vector3f offset(step(random), step(random), step(random));
+                boxes[i].min += offset;
+                boxes[i].max += offset;
+                hierarchy.moveProxy(proxies[i], boxes[i]);
+            }
+        }
+
+        for (int j = 0; j < 100; j++)
+        {
+            std::uint32_t i = random() % ProxyCount;
+            if (alive[i])
+            {
+                hierarchy.destroyProxy(proxies[i]);
+                alive[i] = false;
+            }
+            else
+            {
+                proxies[i] = hierarchy.createProxy(boxes[i], i);
+                alive[i] = true;
+            }
+        }
+
+        // Rebuilds finish in the background, queries see refitted trees meanwhile
+        hierarchy.update(&jobSystem);
+        checker.check(frustum, sphere, origin, direction);
+    }
+
+    hierarchy.rebuild();
+    checker.check(frustum, sphere, origin, direction);
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,205 @@
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "Amber/Rendering/CommandBuffer.h"
+#include "Amber/Rendering/CommandQueue.h"
+#include "Amber/Rendering/Material.h"
+#include "Amber/Rendering/Mesh.h"
+#include "Amber/Rendering/RenderSnapshot.h"
+#include "Amber/Rendering/Backend/IRenderer.h"
+#include "Amber/Utilities/JobSystem.h"
+
+#include "Test.h"
+
+using namespace Amber;
+
+namespace
+{
+    // What a renderer saw of a command, with the first instance transform
+    // of instanced draws and the value of unsigned constants
+    struct Replayed
+    {
+        Rendering::CommandBuffer::CommandType type;
+        std::uint32_t slot;
+        const void *object;
+        std::string name;
+        std::uint32_t value;
+        std::uint32_t instanceCount;
+        Eigen::Matrix4f firstTransform;
+    };
+
+    // Replays buffers into a list instead of a graphics API
+    class Renderer : public Rendering::IRenderer
+    {
+        public:
+            virtual void prepare(Rendering::IObject &) override {}
+            virtual void prepare(Rendering::Reference<Rendering::IProgram>) override {}
+            virtual void prepare(Rendering::Reference<Rendering::ITexture>) override {}
+            virtual void prepare(Rendering::Reference<Rendering::IRenderTarget>) override {}
+
+            virtual void render(Core::World &) override {}
+            virtual void render(const Rendering::IObject &, const Rendering::Material &) override {}
+
+            virtual Rendering::Reference<Rendering::IBindable> getVertexArray(const Rendering::IObject &) override
+            {
+                return Rendering::Reference<Rendering::IBindable>();
+            }
+
+            virtual void draw(const Rendering::IObject &) override {}
+            virtual void drawInstanced(const Rendering::IObject &, const float *, std::size_t) override {}
+
+            virtual void execute(const Rendering::CommandBuffer &buffer) override
+            {
+                executeCount++;
+
+                for (const Rendering::CommandBuffer::Command &command : buffer.getCommands())
+                {
+                    Replayed replayed = { command.type, command.slot, command.object, std::string(), 0, 0,
+                                          Eigen::Matrix4f::Zero() };
+
+                    if (command.type == Rendering::CommandBuffer::CommandType::SetConstant)
+                    {
+                        replayed.name = buffer.getConstantName(command);
+                        if (command.constantType == Rendering::CommandBuffer::ConstantType::UnsignedInt)
+                        {
+                            replayed.value = buffer.getConstant<std::uint32_t>(command);
+                        }
+                    }
+                    else if (command.type == Rendering::CommandBuffer::CommandType::DrawInstanced)
+                    {
+                        replayed.instanceCount = command.instanceCount;
+                        replayed.firstTransform = Eigen::Map<const Eigen::Matrix4f>(buffer.getInstanceTransforms(command));
+                    }
+
+                    commands.push_back(replayed);
+                }
+            }
+
+            virtual void clear() override {}
+            virtual bool getRenderOption(RenderOption) const override { return false; }
+            virtual void setRenderOption(RenderOption, bool) override {}
+
+            virtual Rendering::IContext &getContext() override
+            {
+                throw std::logic_error("The test renderer has no context");
+            }
+
+            std::vector<Replayed> commands;
+            std::size_t executeCount = 0;
+    };
+
+    // Commands come back as recorded, instance counts apart from texture slots
+    void testReplay()
+    {
+        Rendering::RenderSnapshot::MeshInstance mesh(Core::EntityId {}, Rendering::Mesh(), Rendering::Material(),
+                                                     Eigen::Matrix4f::Identity(), Eigen::Matrix4f::Identity());
+
+        std::vector<Eigen::Matrix4f> transforms(3, Eigen::Matrix4f::Identity());
+        transforms[0](0, 3) = 5.0f;
+
+        Rendering::CommandQueue queue;
+        queue.reset(1);
+        Rendering::CommandBuffer &buffer = queue.getBuffer(0);
+        buffer.bindTexture(3, nullptr);
+        buffer.setConstant("mdl_Index", std::uint32_t(7));
+        buffer.drawInstanced(mesh, transforms.data(), 3);
+        buffer.draw(mesh);
+
+        Renderer renderer;
+        queue.submit(renderer);
+
+        const std::vector<Replayed> &commands = renderer.commands;
+        TEST_CHECK(commands.size() == 4);
+        TEST_CHECK(commands[0].type == Rendering::CommandBuffer::CommandType::BindTexture && commands[0].slot == 3);
+        TEST_CHECK(commands[1].name == "mdl_Index" && commands[1].value == 7);
+        TEST_CHECK(commands[2].type == Rendering::CommandBuffer::CommandType::DrawInstanced);
+        TEST_CHECK(commands[2].object == &mesh && commands[2].instanceCount == 3 && commands[2].slot == 0);
+        TEST_CHECK(commands[2].firstTransform.isApprox(transforms[0]));
+        TEST_CHECK(commands[3].type == Rendering::CommandBuffer::CommandType::Draw && commands[3].instanceCount == 0);
+
+        // Submitting again replays the same commands, resetting drops them
+        queue.submit(renderer);
+        TEST_CHECK(renderer.commands.size() == 8);
+
+        queue.reset(1);
+        queue.submit(renderer);
+        TEST_CHECK(renderer.commands.size() == 8);
+        TEST_CHECK(queue.getBuffer(0).isEmpty());
+    }
+
+    // Buffers recorded by jobs finishing in any order execute in index order
+    void testRangeOrder()
+    {
+        const std::size_t BufferCount = 64;
+
+        Utilities::JobSystem jobSystem(3);
+        Rendering::CommandQueue queue;
+
+        for (int repetition = 0; repetition < 5; repetition++)
+        {
+            queue.reset(BufferCount);
+            jobSystem.parallelFor(BufferCount, [&queue] (std::size_t index) {
+                // Early buffers take the longest to record
+                std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now()
+                        + std::chrono::microseconds((BufferCount - index) * 20);
+                while (std::chrono::steady_clock::now() < end)
+                {
+                }
+
+                Rendering::CommandBuffer &buffer = queue.getBuffer(index);
+                for (std::uint32_t i = 0; i < 4; i++)
+                {
+                    buffer.setConstant("mdl_Index", static_cast<std::uint32_t>(index * 4 + i));
+                }
+            }, 1);
+
+            Renderer renderer;
+            queue.submit(renderer);
+
+            bool ordered = renderer.commands.size() == BufferCount * 4;
+            for (std::size_t i = 0; ordered && i < renderer.commands.size(); i++)
+            {
+                ordered = renderer.commands[i].value == static_cast<std::uint32_t>(i);
+            }
+
+            TEST_CHECK(ordered);
+            TEST_CHECK(renderer.executeCount == BufferCount);
+        }
+
+        // Fewer buffers than before leave the rest out
+        queue.reset(2);
+        TEST_CHECK(queue.getBufferCount() == 2);
+        queue.getBuffer(1).setConstant("mdl_Index", std::uint32_t(1));
+
+        Renderer renderer;
+        queue.submit(renderer);
+        TEST_CHECK(renderer.executeCount == 1);
+        TEST_CHECK(renderer.commands.size() == 1 && renderer.commands[0].value == 1);
+
+        bool rejected = false;
+        try
+        {
+            queue.getBuffer(2);
+        }
+        catch (const std::out_of_range &)
+        {
+            rejected = true;
+        }
+
+        TEST_CHECK(rejected);
+    }
+}
+
+int main()
+{
+    testReplay();
+    testRangeOrder();
+
+    return TEST_RESULT();
+}
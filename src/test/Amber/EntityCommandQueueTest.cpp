@@ -0,0 +1,264 @@
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "Amber/Core/EntityCommandBuffer.h"
+#include "Amber/Core/IComponent.h"
+#include "Amber/Core/World.h"
+#include "Amber/Utilities/JobSystem.h"
+
+#include "Test.h"
+
+using namespace Amber;
+
+namespace
+{
+    struct Value : Core::IComponent
+    {
+        explicit Value(int value) : value(value) {}
+        int value;
+    };
+
+    struct Spawned : Core::IComponent
+    {
+        explicit Spawned(int value) : value(value) {}
+        int value;
+    };
+}
+
+AMBER_COMPONENT_TYPE(Value, 16)
+AMBER_COMPONENT_TYPE(Spawned, 17)
+
+namespace
+{
+    void recordValue(Core::World &world, Core::Entity entity, int value)
+    {
+        world.getCommandBuffer().addComponent(entity, Value(value));
+    }
+
+    // Commands of the same thread apply in recording order
+    void testRecordingOrder()
+    {
+        Core::World world;
+        Core::Entity entity = world.create();
+
+        recordValue(world, entity, 1);
+        recordValue(world, entity, 2);
+        world.getCommandBuffer().destroy(entity);
+        recordValue(world, entity, 3);
+        world.playbackCommands();
+
+        TEST_CHECK(!entity.isValid());
+        TEST_CHECK(world.getEntityCount() == 0);
+    }
+
+    // Systems apply in schedule order, whatever order they recorded in
+    void testSystemOrder()
+    {
+        Core::World world;
+        Core::Entity entity = world.create();
+
+        {
+            Core::EntityCommandBuffer::Scope scope(2);
+            recordValue(world, entity, 2);
+        }
+
+        {
+            Core::EntityCommandBuffer::Scope scope(1);
+            recordValue(world, entity, 1);
+        }
+
+        world.playbackCommands();
+        TEST_CHECK(entity.getComponent<Value>()->value == 2);
+    }
+
+    void recordSpawn(Core::World &world, int value)
+    {
+        Core::EntityCommandBuffer &commands = world.getCommandBuffer();
+        commands.addComponent(commands.create(), Spawned(value));
+    }
+
+    std::vector<int> getSpawned(Core::World &world)
+    {
+        std::vector<int> spawned;
+        world.query<const Spawned>().forEach([&spawned] (const Spawned &value) {
+            spawned.push_back(value.value);
+        });
+
+        return spawned;
+    }
+
+    // Batches forked inside a chunk sort within that chunk, and before the
+    // commands the forking scope records afterwards
+    void testNestedBatchOrder()
+    {
+        Core::World world;
+
+        {
+            Core::EntityCommandBuffer::Scope scope(0);
+            recordSpawn(world, 0);
+
+            Core::EntityCommandBuffer::SortKey batch = Core::EntityCommandBuffer::Scope::fork();
+            {
+                Core::EntityCommandBuffer::Scope chunk(batch, 1);
+                recordSpawn(world, 5);
+            }
+
+            {
+                Core::EntityCommandBuffer::Scope chunk(batch, 0);
+                recordSpawn(world, 1);
+
+                Core::EntityCommandBuffer::SortKey nested = Core::EntityCommandBuffer::Scope::fork();
+                {
+                    Core::EntityCommandBuffer::Scope nestedChunk(nested, 1);
+                    recordSpawn(world, 3);
+                }
+
+                {
+                    Core::EntityCommandBuffer::Scope nestedChunk(nested, 0);
+                    recordSpawn(world, 2);
+                }
+
+                recordSpawn(world, 4);
+            }
+
+            recordSpawn(world, 6);
+
+            Core::EntityCommandBuffer::SortKey next = Core::EntityCommandBuffer::Scope::fork();
+            {
+                Core::EntityCommandBuffer::Scope chunk(next, 0);
+                recordSpawn(world, 7);
+            }
+
+            recordSpawn(world, 8);
+        }
+
+        world.playbackCommands();
+
+        std::vector<int> spawned = getSpawned(world);
+        TEST_CHECK(spawned.size() == 9);
+        for (std::size_t i = 0; i < spawned.size(); i++)
+        {
+            TEST_CHECK(spawned[i] == static_cast<int>(i));
+        }
+    }
+
+    // Entity ids mean nothing in another world's storage
+    void testForeignEntity()
+    {
+        Core::World world;
+        Core::World other;
+        Core::Entity entity = world.create();
+        Core::Entity foreign = other.create();
+
+        recordValue(world, entity, 1);
+        world.getCommandBuffer().destroy(foreign);
+
+        bool rejected = false;
+        try
+        {
+            world.playbackCommands();
+        }
+        catch (const std::invalid_argument &)
+        {
+            rejected = true;
+        }
+
+        TEST_CHECK(rejected);
+        TEST_CHECK(foreign.isValid());
+        TEST_CHECK(!entity.hasComponent<Value>());
+
+        // The rejected commands are gone
+        recordValue(world, entity, 2);
+        world.playbackCommands();
+        TEST_CHECK(entity.getComponent<Value>()->value == 2);
+    }
+
+    // Scopes order the commands of different threads; commands of several
+    // threads under one key have no order and are refused
+    void testThreadOrder()
+    {
+        Core::World world;
+        Core::Entity entity = world.create();
+
+        for (int i = 2; i >= 0; i--)
+        {
+            std::thread thread([&world, entity, i] () {
+                Core::EntityCommandBuffer::Scope scope(static_cast<std::uint32_t>(i));
+                recordValue(world, entity, i);
+            });
+            thread.join();
+        }
+
+        world.playbackCommands();
+        TEST_CHECK(entity.getComponent<Value>()->value == 2);
+
+        recordValue(world, entity, 3);
+        std::thread thread([&world, entity] () {
+            recordValue(world, entity, 4);
+        });
+        thread.join();
+
+        bool rejected = false;
+        try
+        {
+            world.playbackCommands();
+        }
+        catch (const std::logic_error &)
+        {
+            rejected = true;
+        }
+
+        TEST_CHECK(rejected);
+        TEST_CHECK(entity.getComponent<Value>()->value == 2);
+    }
+
+    // Commands recorded from a parallel query follow the chunks, not the
+    // threads that happened to run them
+    void testChunkOrder()
+    {
+        const int EntityCount = 5000;
+
+        Utilities::JobSystem jobSystem(4);
+
+        for (int repetition = 0; repetition < 10; repetition++)
+        {
+            Core::World world;
+            for (int i = 0; i < EntityCount; i++)
+            {
+                world.create().emplaceComponent<Value>(i);
+            }
+
+            {
+                Core::EntityCommandBuffer::Scope scope(0);
+                world.query<const Value>().parallelForEach(jobSystem, [&world] (const Value &value) {
+                    Core::EntityCommandBuffer &commands = world.getCommandBuffer();
+                    commands.addComponent(commands.create(), Spawned(value.value));
+                });
+            }
+
+            world.playbackCommands();
+
+            std::vector<int> spawned = getSpawned(world);
+            TEST_CHECK(spawned.size() == static_cast<std::size_t>(EntityCount));
+            for (std::size_t i = 0; i < spawned.size(); i++)
+            {
+                TEST_CHECK(spawned[i] == static_cast<int>(i));
+            }
+        }
+    }
+}
+
+int main()
+{
+    testRecordingOrder();
+    testSystemOrder();
+    testNestedBatchOrder();
+    testForeignEntity();
+    testThreadOrder();
+    testChunkOrder();
+
+    return TEST_RESULT();
+}
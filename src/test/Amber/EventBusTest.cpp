@@ -0,0 +1,225 @@
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "Amber/Core/EntityCommandBuffer.h"
+#include "Amber/Core/EventBus.h"
+#include "Amber/Utilities/JobSystem.h"
+#include "Amber/Utilities/ThreadCache.h"
+
+#include "Test.h"
+
+using namespace Amber;
+
+namespace
+{
+    struct Collision
+    {
+        int first;
+        int second;
+    };
+
+    struct Spawn
+    {
+        int kind;
+    };
+
+    // Events published from the chunks of a batch arrive in chunk order,
+    // whichever workers published them. Events of other types go to their
+    // own subscribers.
+    void testDelivery()
+    {
+        const int EventCount = 20000;
+
+        Utilities::JobSystem jobSystem(3);
+        Core::EventBus bus;
+
+        std::vector<int> received;
+        std::size_t spawnCount = 0;
+        bus.subscribe<Collision>([&received] (const Collision *events, std::size_t count) {
+            for (std::size_t i = 0; i < count; i++)
+            {
+                received.push_back(events[i].first);
+            }
+        });
+
+        bus.subscribe<Spawn>([&spawnCount] (const Spawn *, std::size_t count) {
+            spawnCount += count;
+        });
+
+        for (int repetition = 0; repetition < 5; repetition++)
+        {
+            received.clear();
+            spawnCount = 0;
+
+            {
+                Core::EntityCommandBuffer::Scope scope(0);
+                Core::EntityCommandBuffer::SortKey batch = Core::EntityCommandBuffer::Scope::fork();
+                jobSystem.parallelFor(EventCount, [&bus, &batch] (std::size_t i) {
+                    Core::EntityCommandBuffer::Scope chunk(batch, static_cast<std::uint32_t>(i));
+                    bus.publish(Collision { static_cast<int>(i), 0 });
+                });
+                bus.emplace<Spawn>(Spawn { 1 });
+            }
+
+            bus.dispatch();
+
+            bool ordered = received.size() == static_cast<std::size_t>(EventCount);
+            for (std::size_t i = 0; ordered && i < received.size(); i++)
+            {
+                ordered = received[i] == static_cast<int>(i);
+            }
+
+            TEST_CHECK(ordered);
+            TEST_CHECK(spawnCount == 1);
+        }
+
+        // Nothing is delivered twice
+        received.clear();
+        bus.dispatch();
+        TEST_CHECK(received.empty());
+        TEST_CHECK(spawnCount == 1);
+    }
+
+    // Events of one key from several threads have no order, they are
+    // refused rather than delivered in whatever order the threads ran
+    void testSharedKey()
+    {
+        Core::EventBus bus;
+
+        std::vector<int> kinds;
+        bus.subscribe<Spawn>([&kinds] (const Spawn *events, std::size_t count) {
+            for (std::size_t i = 0; i < count; i++)
+            {
+                kinds.push_back(events[i].kind);
+            }
+        });
+
+        bus.publish(Spawn { 1 });
+        std::thread thread([&bus] () {
+            bus.publish(Spawn { 2 });
+        });
+        thread.join();
+
+        bool rejected = false;
+        try
+        {
+            bus.dispatch();
+        }
+        catch (const std::logic_error &)
+        {
+            rejected = true;
+        }
+
+        TEST_CHECK(rejected);
+        TEST_CHECK(kinds.empty());
+
+        // Different keys are ordered by key, not by thread
+        std::thread scoped([&bus] () {
+            Core::EntityCommandBuffer::Scope scope(1);
+            bus.publish(Spawn { 2 });
+        });
+        scoped.join();
+
+        {
+            Core::EntityCommandBuffer::Scope scope(0);
+            bus.publish(Spawn { 1 });
+        }
+
+        bus.dispatch();
+        TEST_CHECK(kinds.size() == 2 && kinds[0] == 1 && kinds[1] == 2);
+    }
+
+    // Events published by handlers wait for the next dispatch
+    void testHandlerEvents()
+    {
+        Core::EventBus bus;
+
+        std::size_t spawnCount = 0;
+        bus.subscribe<Spawn>([&spawnCount] (const Spawn *, std::size_t count) {
+            spawnCount += count;
+        });
+
+        bus.subscribe<Collision>([&bus] (const Collision *events, std::size_t count) {
+            for (std::size_t i = 0; i < count; i++)
+            {
+                bus.publish(Spawn { events[i].first });
+            }
+        });
+
+        bus.publish(Collision { 1, 2 });
+        bus.publish(Collision { 3, 4 });
+        bus.dispatch();
+        TEST_CHECK(spawnCount == 0);
+
+        bus.dispatch();
+        TEST_CHECK(spawnCount == 2);
+    }
+
+    // A thread alternating between buses, as a server worker does between
+    // worlds, keeps the events of each apart
+    void testAlternatingBuses()
+    {
+        Core::EventBus first;
+        Core::EventBus second;
+
+        int firstSum = 0;
+        int secondSum = 0;
+        first.subscribe<Spawn>([&firstSum] (const Spawn *events, std::size_t count) {
+            for (std::size_t i = 0; i < count; i++)
+            {
+                firstSum += events[i].kind;
+            }
+        });
+
+        second.subscribe<Spawn>([&secondSum] (const Spawn *events, std::size_t count) {
+            for (std::size_t i = 0; i < count; i++)
+            {
+                secondSum += events[i].kind;
+            }
+        });
+
+        for (int i = 0; i < 100; i++)
+        {
+            first.publish(Spawn { 1 });
+            second.publish(Spawn { 2 });
+        }
+
+        first.dispatch();
+        second.dispatch();
+        TEST_CHECK(firstSum == 100);
+        TEST_CHECK(secondSum == 200);
+    }
+
+    // Owners of the same type do not evict each other's entries
+    void testThreadCache()
+    {
+        Utilities::ThreadCache<int> first;
+        Utilities::ThreadCache<int> second;
+        int firstValue = 1;
+        int secondValue = 2;
+
+        TEST_CHECK(first.get() == nullptr);
+        first.set(&firstValue);
+        second.set(&secondValue);
+
+        for (int i = 0; i < 10; i++)
+        {
+            TEST_CHECK(first.get() == &firstValue);
+            TEST_CHECK(second.get() == &secondValue);
+        }
+    }
+}
+
+int main()
+{
+    testDelivery();
+    testSharedKey();
+    testHandlerEvents();
+    testAlternatingBuses();
+    testThreadCache();
+
+    return TEST_RESULT();
+}
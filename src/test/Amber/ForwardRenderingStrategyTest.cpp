@@ -0,0 +1,367 @@
+#include <cstddef>
+#include <cstdint>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "Amber/Core/Transform.h"
+#include "Amber/Core/World.h"
+#include "Amber/Rendering/CommandBuffer.h"
+#include "Amber/Rendering/ForwardRenderingStrategy.h"
+#include "Amber/Rendering/Material.h"
+#include "Amber/Rendering/Mesh.h"
+#include "Amber/Rendering/RenderSnapshot.h"
+#include "Amber/Rendering/Scene.h"
+#include "Amber/Rendering/Backend/IContext.h"
+#include "Amber/Rendering/Backend/IProgram.h"
+#include "Amber/Rendering/Backend/IRenderer.h"
+#include "Amber/Rendering/Backend/Layout.h"
+#include "Amber/Utilities/JobSystem.h"
+
+#include "Test.h"
+
+using namespace Amber;
+
+namespace
+{
+    // Nothing is ever created, the strategy only needs valid references
+    class Context : public Rendering::IContext
+    {
+        public:
+            virtual void activate() override { activeContext = this; }
+            virtual void deactivate() override { activeContext = nullptr; }
+            virtual bool isActive() const override { return activeContext == this; }
+            virtual bool isMultithreadingSupported() const override { return false; }
+
+            virtual bool tryLock(const Rendering::Reference<Rendering::IBindable> &) override { return true; }
+            virtual void lock(const Rendering::Reference<Rendering::IBindable> &) override {}
+            virtual void unlock(const Rendering::Reference<Rendering::IBindable> &) override {}
+
+            virtual Rendering::Reference<Rendering::IBuffer> createHardwareBuffer(Rendering::IBuffer::Type) override { return {}; }
+            virtual void destroyHardwareBuffer(const Rendering::Reference<Rendering::IBuffer> &) override {}
+            virtual Rendering::Reference<Rendering::IRenderTarget> createRenderTarget() override { return {}; }
+            virtual Rendering::Reference<Rendering::IShader> createShader(Rendering::IShader::Type) override { return {}; }
+            virtual Rendering::Reference<Rendering::IProgram> createProgram() override { return {}; }
+            virtual Rendering::Reference<Rendering::ITexture> createTexture(Rendering::ITexture::Type, Rendering::ITexture::DataFormat) override { return {}; }
+            virtual Rendering::Reference<Rendering::IRenderTarget> getDefaultRenderTarget() override { return {}; }
+    };
+
+    // Without a per-instance mdl_Transform every mesh is a draw of its own
+    class Program : public Rendering::IProgram
+    {
+        public:
+            explicit Program(bool instanced = false)
+            {
+                if (instanced)
+                {
+                    layout.insertAttribute(Rendering::Layout::Attribute("mdl_Transform", Rendering::Layout::ComponentType::Float, 16, 1));
+                }
+            }
+
+            virtual void bind() override {}
+            virtual void unbind() override {}
+            virtual BindType getBindType() const override { return BindType::Program; }
+            virtual std::uint32_t getBindSlot() const override { return 0; }
+
+            virtual void link() override {}
+            virtual bool isLinked() const override { return true; }
+            virtual void addShader(Rendering::Reference<Rendering::IShader>) override {}
+
+            virtual const Rendering::Layout &getLayout() const override { return layout; }
+            virtual void setLayout(Rendering::Layout layout) override { this->layout = layout; }
+
+            virtual void setConstant(std::string, std::int32_t) override {}
+            virtual void setConstant(std::string, std::uint32_t) override {}
+            virtual void setConstant(std::string, float) override {}
+            virtual void setConstant(std::string, Eigen::Matrix4f) override {}
+            virtual void setConstant(std::string, Eigen::Matrix3f) override {}
+            virtual void setConstant(std::string, Eigen::Vector2f) override {}
+            virtual void setConstant(std::string, Eigen::Vector3f) override {}
+            virtual void setConstant(std::string, Eigen::Vector4f) override {}
+
+        private:
+            Rendering::Layout layout;
+    };
+
+    class VertexArray : public Rendering::IBindable
+    {
+        public:
+            virtual void bind() override {}
+            virtual void unbind() override {}
+            virtual BindType getBindType() const override { return BindType::VertexArray; }
+            virtual std::uint32_t getBindSlot() const override { return 0; }
+    };
+
+    struct Draw
+    {
+        const Rendering::IProgram *boundProgram;
+        const Rendering::RenderSnapshot::MeshInstance *mesh;
+        std::uint32_t instanceCount;
+
+        bool operator ==(const Draw &other) const
+        {
+            return boundProgram == other.boundProgram && mesh == other.mesh && instanceCount == other.instanceCount;
+        }
+    };
+
+    // Notes each draw with the program bound for it. Programs are bound
+    // again at the start of every buffer.
+    class Renderer : public Rendering::IRenderer
+    {
+        public:
+            Renderer()
+            {
+                context.activate();
+            }
+
+            virtual ~Renderer()
+            {
+                context.deactivate();
+            }
+
+            virtual void prepare(Rendering::IObject &) override {}
+            virtual void prepare(Rendering::Reference<Rendering::IProgram>) override {}
+            virtual void prepare(Rendering::Reference<Rendering::ITexture>) override {}
+            virtual void prepare(Rendering::Reference<Rendering::IRenderTarget>) override {}
+
+            virtual void render(Core::World &) override {}
+            virtual void render(const Rendering::IObject &, const Rendering::Material &) override {}
+
+            virtual Rendering::Reference<Rendering::IBindable> getVertexArray(const Rendering::IObject &) override
+            {
+                return Rendering::Reference<Rendering::IBindable>(&context, &vertexArray);
+            }
+
+            virtual void draw(const Rendering::IObject &) override {}
+            virtual void drawInstanced(const Rendering::IObject &, const float *, std::size_t) override {}
+
+            virtual void execute(const Rendering::CommandBuffer &buffer) override
+            {
+                const Rendering::IProgram *program = nullptr;
+                bufferCount++;
+                for (const Rendering::CommandBuffer::Command &command : buffer.getCommands())
+                {
+                    if (command.type == Rendering::CommandBuffer::CommandType::BindProgram)
+                    {
+                        program = static_cast<const Rendering::IProgram *>(command.object);
+                    }
+                    else if (command.type == Rendering::CommandBuffer::CommandType::Draw)
+                    {
+                        draws.push_back(Draw { program, static_cast<const Rendering::RenderSnapshot::MeshInstance *>(command.object), 1 });
+                    }
+                    else if (command.type == Rendering::CommandBuffer::CommandType::DrawInstanced)
+                    {
+                        draws.push_back(Draw { program, static_cast<const Rendering::RenderSnapshot::MeshInstance *>(command.object),
+                                               command.instanceCount });
+                    }
+                }
+            }
+
+            virtual void clear() override {}
+            virtual bool getRenderOption(RenderOption) const override { return false; }
+            virtual void setRenderOption(RenderOption, bool) override {}
+
+            virtual Rendering::IContext &getContext() override
+            {
+                return context;
+            }
+
+            std::vector<Draw> draws;
+            std::size_t bufferCount = 0;
+
+        private:
+            Context context;
+            VertexArray vertexArray;
+    };
+
+    void addMesh(Core::World &world, Rendering::Scene &scene, Rendering::IContext &context, Program &program,
+                 float depth, bool translucent)
+    {
+        // Without a camera the view is the identity, looking down negative z
+        Eigen::Matrix4f transform = Eigen::Matrix4f::Identity();
+        transform(2, 3) = -depth;
+
+        Core::Entity entity = world.create();
+        entity.emplaceComponent<Rendering::Mesh>();
+        Rendering::Material *material = entity.emplaceComponent<Rendering::Material>();
+        material->setProgram(Rendering::Reference<Rendering::IProgram>(&context, &program));
+        material->setTranslucency(translucent ? 0.5f : 0.0f);
+        entity.emplaceComponent<Core::Transform>(transform, world.getTransformHierarchy());
+
+        scene.addMesh(entity);
+    }
+
+    float getDepth(const Draw &draw)
+    {
+        return -draw.mesh->getTransform()(2, 3);
+    }
+
+    // Every mesh is drawn with its own program. Opaque meshes come first,
+    // each program's together and front to back, then translucent ones back
+    // to front.
+    void checkOrder(const std::vector<Draw> &draws, std::size_t meshCount)
+    {
+        TEST_CHECK(draws.size() == meshCount);
+
+        std::set<const Rendering::IProgram *> finishedPrograms;
+        bool bound = true;
+        bool grouped = true;
+        bool ordered = true;
+        for (std::size_t i = 0; i < draws.size(); i++)
+        {
+            const Draw &draw = draws[i];
+            bool translucent = draw.mesh->getMaterial().getTranslucency() > 0.0f;
+            bound = bound && draw.boundProgram == draw.mesh->getMaterial().getProgram().get();
+
+            if (i == 0)
+            {
+                continue;
+            }
+
+            const Draw &previous = draws[i - 1];
+            bool previousTranslucent = previous.mesh->getMaterial().getTranslucency() > 0.0f;
+            if (previousTranslucent)
+            {
+                ordered = ordered && translucent && getDepth(previous) >= getDepth(draw);
+            }
+            else if (!translucent)
+            {
+                if (previous.boundProgram != draw.boundProgram)
+                {
+                    finishedPrograms.insert(previous.boundProgram);
+                    grouped = grouped && finishedPrograms.count(draw.boundProgram) == 0;
+                }
+                else
+                {
+                    ordered = ordered && getDepth(previous) <= getDepth(draw);
+                }
+            }
+        }
+
+        TEST_CHECK(bound);
+        TEST_CHECK(grouped);
+        TEST_CHECK(ordered);
+    }
+
+    // Meshes recorded in no particular order come out sorted by their keys
+    void testKeyOrder()
+    {
+        const std::size_t ProgramCount = 4;
+        const std::size_t MeshCount = 200;
+
+        Renderer renderer;
+        std::vector<Program> programs(ProgramCount);
+        Core::World world;
+        Rendering::Scene scene;
+        for (std::size_t i = 0; i < MeshCount; i++)
+        {
+            addMesh(world, scene, renderer.getContext(), programs[(i * 7) % ProgramCount],
+                    static_cast<float>((i * 37) % 101) + 1.0f, i % 5 == 0);
+        }
+
+        Rendering::RenderSnapshot snapshot;
+        snapshot.extract(scene, 1, 1.0f);
+
+        Rendering::ForwardRenderingStrategy strategy;
+        strategy.render(snapshot, &renderer);
+
+        checkOrder(renderer.draws, MeshCount);
+        TEST_CHECK(strategy.getStats().programChanges < strategy.getStats().unsortedProgramChanges);
+    }
+
+    // More programs than the key has ids for are still drawn, and still
+    // grouped, by comparing the programs themselves
+    void testIdOverflow()
+    {
+        const std::size_t ProgramCount = 1500;
+        const std::size_t MeshCount = ProgramCount * 3;
+
+        Renderer renderer;
+        std::vector<Program> programs(ProgramCount);
+        Core::World world;
+        Rendering::Scene scene;
+        for (std::size_t i = 0; i < MeshCount; i++)
+        {
+            addMesh(world, scene, renderer.getContext(), programs[i % ProgramCount],
+                    static_cast<float>((i * 37) % 101) + 1.0f, i % 50 == 0);
+        }
+
+        Rendering::RenderSnapshot snapshot;
+        snapshot.extract(scene, 1, 1.0f);
+
+        Rendering::ForwardRenderingStrategy strategy;
+
+        // The second frame reuses the ids of the first
+        for (int frame = 0; frame < 2; frame++)
+        {
+            renderer.draws.clear();
+            strategy.render(snapshot, &renderer);
+            checkOrder(renderer.draws, MeshCount);
+            TEST_CHECK(strategy.getStats().drawCount == MeshCount);
+        }
+    }
+
+    // Recording ranges of the sorted draws on the job system draws the same
+    // as recording them in one go
+    void testParallelRecording()
+    {
+        const std::size_t ProgramCount = 40;
+        const std::size_t MeshCount = 10000;
+
+        Renderer renderer;
+        std::vector<Program> programs;
+        for (std::size_t i = 0; i < ProgramCount; i++)
+        {
+            programs.emplace_back(i % 2 == 0);
+        }
+
+        Core::World world;
+        Rendering::Scene scene;
+        for (std::size_t i = 0; i < MeshCount; i++)
+        {
+            addMesh(world, scene, renderer.getContext(), programs[(i * 7) % ProgramCount],
+                    static_cast<float>((i * 37) % 101) + 1.0f, i % 50 == 0);
+        }
+
+        Rendering::RenderSnapshot snapshot;
+        snapshot.extract(scene, 1, 1.0f);
+
+        Rendering::ForwardRenderingStrategy sequential;
+        sequential.render(snapshot, &renderer);
+        std::vector<Draw> expected = renderer.draws;
+
+        std::size_t instanceCount = 0;
+        for (const Draw &draw : expected)
+        {
+            instanceCount += draw.instanceCount;
+        }
+
+        TEST_CHECK(instanceCount == MeshCount);
+        TEST_CHECK(expected.size() == sequential.getStats().drawCallCount);
+        TEST_CHECK(expected.size() < MeshCount);
+
+        Utilities::JobSystem jobSystem(3);
+        Rendering::ForwardRenderingStrategy parallel(&jobSystem);
+        for (int repetition = 0; repetition < 5; repetition++)
+        {
+            renderer.draws.clear();
+            renderer.bufferCount = 0;
+            parallel.render(snapshot, &renderer);
+
+            TEST_CHECK(renderer.draws == expected);
+            TEST_CHECK(renderer.bufferCount > 1);
+            TEST_CHECK(parallel.getStats().drawCallCount == sequential.getStats().drawCallCount);
+        }
+    }
+}
+
+int main()
+{
+    testKeyOrder();
+    testIdOverflow();
+    testParallelRecording();
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,117 @@
+#include <cstddef>
+#include <memory>
+
+#include <Eigen/Core>
+
+#include "Amber/Core/Game.h"
+#include "Amber/Core/ISystem.h"
+#include "Amber/Core/Transform.h"
+#include "Amber/Core/World.h"
+#include "Amber/Math/Bounds.h"
+#include "Amber/Rendering/Material.h"
+#include "Amber/Rendering/Mesh.h"
+#include "Amber/Rendering/Scene.h"
+
+#include "Test.h"
+
+using namespace Amber;
+
+namespace
+{
+    // Keeps a scene in sync with the world like the rendering system does
+    class SceneSystem : public Core::ISystem
+    {
+        public:
+            SceneSystem()
+                : visibleCount(0)
+            {
+            }
+
+            virtual bool isOnSeparateThread() const override
+            {
+                return false;
+            }
+
+            virtual void runSingleIteration() override
+            {
+                scene.update();
+
+                visibleCount = 0;
+                scene.queryMeshes(Math::BoundingSphere{Eigen::Vector3f::Zero(), 1000.0f}, [this] (const Core::Entity &entity) {
+                    TEST_CHECK(entity.hasComponent<Rendering::Mesh>());
+                    visibleCount++;
+                });
+            }
+
+            virtual void run() override
+            {
+            }
+
+            virtual void processChanges(const Core::EntityChanges &changes) override
+            {
+                for (const Core::Entity &entity : changes.getDestroyed())
+                {
+                    scene.removeMesh(entity);
+                }
+
+                for (const Core::Entity &entity : changes.getAdded<Rendering::Mesh>())
+                {
+                    if (entity.hasComponents<Rendering::Mesh, Rendering::Material, Core::Transform>())
+                    {
+                        scene.addMesh(entity);
+                    }
+                }
+            }
+
+            Rendering::Scene scene;
+            std::size_t visibleCount;
+    };
+
+    Core::World createWorld(std::size_t meshCount)
+    {
+        Core::World world;
+
+        for (std::size_t i = 0; i < meshCount; i++)
+        {
+            Eigen::Matrix4f transform = Eigen::Matrix4f::Identity();
+            transform(0, 3) = static_cast<float>(i);
+
+            Core::Entity entity = world.create();
+            entity.emplaceComponent<Rendering::Mesh>()->setBoundingBox(
+                    Math::BoundingBox{Eigen::Vector3f::Constant(-0.5f), Eigen::Vector3f::Constant(0.5f)});
+            entity.emplaceComponent<Rendering::Material>();
+            entity.emplaceComponent<Core::Transform>(transform, world.getTransformHierarchy());
+        }
+
+        return world;
+    }
+}
+
+int main()
+{
+    Core::Game game;
+    game.addSystem(std::unique_ptr<Core::ISystem>(new SceneSystem()));
+    SceneSystem &system = static_cast<SceneSystem &>(*game.getSystems().front());
+
+    game.setWorld(createWorld(100));
+    game.runSingleIteration();
+    TEST_CHECK(system.scene.getMeshes().size() == 100);
+    TEST_CHECK(system.visibleCount == 100);
+
+    // The scene must not keep entities of the world that was replaced
+    game.setWorld(createWorld(30));
+    game.runSingleIteration();
+    TEST_CHECK(system.scene.getMeshes().size() == 30);
+    TEST_CHECK(system.visibleCount == 30);
+
+    for (const Core::Entity &entity : system.scene.getMeshes())
+    {
+        TEST_CHECK(entity.isValid());
+    }
+
+    game.setWorld(Core::World());
+    game.runSingleIteration();
+    TEST_CHECK(system.scene.getMeshes().empty());
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,298 @@
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "Amber/Utilities/JobSystem.h"
+
+#include "Test.h"
+
+using namespace Amber;
+
+namespace
+{
+    // Long enough for any correct run, short enough for a broken one to fail
+    const std::chrono::seconds Timeout(10);
+
+    bool waitUntil(const std::atomic<bool> &flag)
+    {
+        std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now() + Timeout;
+        while (!flag && std::chrono::steady_clock::now() < end)
+        {
+            std::this_thread::yield();
+        }
+
+        return flag;
+    }
+
+    bool waitUntilDone(const Utilities::JobSystem::Counter &counter)
+    {
+        std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now() + Timeout;
+        while (!counter.isDone() && std::chrono::steady_clock::now() < end)
+        {
+            std::this_thread::yield();
+        }
+
+        return counter.isDone();
+    }
+
+    // Jobs a busy worker queued for itself are taken by the others
+    void testStealing()
+    {
+        const std::size_t JobCount = 64;
+
+        Utilities::JobSystem jobSystem(3);
+
+        std::mutex mutex;
+        std::set<std::thread::id> threads;
+        std::thread::id submitter;
+        std::atomic<bool> stolen(false);
+
+        Utilities::JobSystem::Counter outer;
+        jobSystem.submit([&] () {
+            submitter = std::this_thread::get_id();
+
+            Utilities::JobSystem::Counter inner;
+            for (std::size_t i = 0; i < JobCount; i++)
+            {
+                jobSystem.submit([&] () {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    threads.insert(std::this_thread::get_id());
+                }, inner);
+            }
+
+            // Never runs them itself
+            stolen = waitUntilDone(inner);
+        }, outer);
+
+        TEST_CHECK(waitUntilDone(outer));
+        TEST_CHECK(stolen);
+        TEST_CHECK(!threads.empty() && threads.count(submitter) == 0);
+    }
+
+    // A counter is done once every job counted on it has finished, copies
+    // count the same jobs
+    void testCounters()
+    {
+        const std::size_t JobCount = 100;
+
+        Utilities::JobSystem jobSystem(2);
+        Utilities::JobSystem::Counter counter;
+        Utilities::JobSystem::Counter copy = counter;
+        TEST_CHECK(counter.isDone());
+
+        std::atomic<bool> open(false);
+        std::atomic<std::size_t> finished(0);
+        for (std::size_t i = 0; i < JobCount; i++)
+        {
+            jobSystem.submit([&open, &finished] () {
+                waitUntil(open);
+                finished++;
+            }, i % 2 == 0 ? counter : copy);
+        }
+
+        TEST_CHECK(!counter.isDone());
+        TEST_CHECK(!copy.isDone());
+
+        open = true;
+        jobSystem.wait(copy);
+        TEST_CHECK(counter.isDone());
+        TEST_CHECK(finished == JobCount);
+    }
+
+    // Continuations start once their dependency is done, and count on their
+    // own counter from the moment they are submitted
+    void testContinuations()
+    {
+        const std::size_t JobCount = 50;
+
+        Utilities::JobSystem jobSystem(3);
+
+        for (int repetition = 0; repetition < 20; repetition++)
+        {
+            Utilities::JobSystem::Counter first;
+            Utilities::JobSystem::Counter second;
+            Utilities::JobSystem::Counter third;
+
+            std::atomic<std::size_t> firstFinished(0);
+            std::atomic<std::size_t> firstSeen(0);
+            std::atomic<bool> thirdAfterSecond(false);
+            std::atomic<bool> secondDone(false);
+
+            for (std::size_t i = 0; i < JobCount; i++)
+            {
+                jobSystem.submit([&firstFinished] () {
+                    std::this_thread::sleep_for(std::chrono::microseconds(50));
+                    firstFinished++;
+                }, first);
+            }
+
+            jobSystem.submitAfter(first, [&] () {
+                firstSeen = firstFinished.load();
+                secondDone = true;
+            }, second);
+
+            jobSystem.submitAfter(second, [&] () {
+                thirdAfterSecond = secondDone.load();
+            }, third);
+
+            TEST_CHECK(!third.isDone());
+            jobSystem.wait(third);
+
+            TEST_CHECK(first.isDone() && second.isDone());
+            TEST_CHECK(firstSeen == JobCount);
+            TEST_CHECK(thirdAfterSecond);
+        }
+
+        // Nothing to wait for, the job is submitted right away
+        Utilities::JobSystem::Counter done;
+        Utilities::JobSystem::Counter counter;
+        std::atomic<bool> ran(false);
+        jobSystem.submitAfter(done, [&ran] () { ran = true; }, counter);
+        jobSystem.wait(counter);
+        TEST_CHECK(ran);
+    }
+
+    // Every index is visited exactly once, whatever the grain size, also
+    // from inside other jobs
+    void testParallelFor()
+    {
+        const std::size_t Count = 10000;
+
+        Utilities::JobSystem jobSystem(3);
+
+        for (std::size_t grainSize : { 0, 1, 7, 1000, 20000 })
+        {
+            std::vector<std::atomic<int>> visits(Count);
+            for (std::atomic<int> &visit : visits)
+            {
+                visit = 0;
+            }
+
+            jobSystem.parallelFor(Count, [&visits] (std::size_t i) {
+                visits[i]++;
+            }, grainSize);
+
+            bool once = true;
+            for (const std::atomic<int> &visit : visits)
+            {
+                once = once && visit == 1;
+            }
+
+            TEST_CHECK(once);
+        }
+
+        bool called = false;
+        jobSystem.parallelFor(0, [&called] (std::size_t) { called = true; });
+        TEST_CHECK(!called);
+
+        std::atomic<std::size_t> innerCount(0);
+        jobSystem.parallelFor(16, [&jobSystem, &innerCount] (std::size_t) {
+            jobSystem.parallelFor(100, [&innerCount] (std::size_t) {
+                innerCount++;
+            }, 10);
+        }, 1);
+        TEST_CHECK(innerCount == 1600);
+    }
+
+    // Partial results are combined in index order, so a reduction that only
+    // associates still gives the sequential result
+    void testParallelReduce()
+    {
+        const std::size_t Count = 100000;
+
+        Utilities::JobSystem jobSystem(3);
+
+        std::uint64_t sum = jobSystem.parallelReduce(Count, std::uint64_t(0), [] (std::size_t i) {
+            return static_cast<std::uint64_t>(i);
+        }, [] (std::uint64_t lhs, std::uint64_t rhs) {
+            return lhs + rhs;
+        });
+        TEST_CHECK(sum == std::uint64_t(Count) * (Count - 1) / 2);
+
+        // Affine maps x -> a * x + b compose associatively but not commutatively
+        struct Affine
+        {
+            std::uint64_t a;
+            std::uint64_t b;
+        };
+
+        auto map = [] (std::size_t i) {
+            return Affine { 2 * static_cast<std::uint64_t>(i) + 3, static_cast<std::uint64_t>(i) * 7 + 1 };
+        };
+
+        auto compose = [] (const Affine &first, const Affine &second) {
+            return Affine { second.a * first.a, second.a * first.b + second.b };
+        };
+
+        Affine expected = { 1, 0 };
+        for (std::size_t i = 0; i < Count; i++)
+        {
+            expected = compose(expected, map(i));
+        }
+
+        for (std::size_t grainSize : { 0, 1, 333 })
+        {
+            Affine result = jobSystem.parallelReduce(Count, Affine { 1, 0 }, map, compose, grainSize);
+            TEST_CHECK(result.a == expected.a && result.b == expected.b);
+        }
+
+        TEST_CHECK(jobSystem.parallelReduce(0, 5, [] (std::size_t) { return 1; }, [] (int lhs, int rhs) { return lhs + rhs; }) == 5);
+    }
+
+    // While an owner is current, only its jobs are run by the waiting thread
+    void testOwners()
+    {
+        Utilities::JobSystem jobSystem(1);
+        int first = 0;
+        int second = 0;
+
+        // Keeps the only worker busy, so queued jobs wait for us
+        std::atomic<bool> started(false);
+        std::atomic<bool> open(false);
+        Utilities::JobSystem::Counter blocker;
+        jobSystem.submit([&started, &open] () {
+            started = true;
+            waitUntil(open);
+        }, blocker);
+        TEST_CHECK(waitUntil(started));
+
+        Utilities::JobSystem::Counter counter;
+        {
+            Utilities::JobSystem::OwnerScope owner(&second);
+            jobSystem.submit([&second] () { second++; }, counter);
+        }
+
+        {
+            Utilities::JobSystem::OwnerScope owner(&first);
+            TEST_CHECK(!jobSystem.runPendingJob());
+            TEST_CHECK(second == 0);
+        }
+
+        {
+            Utilities::JobSystem::OwnerScope owner(&second);
+            TEST_CHECK(jobSystem.runPendingJob());
+            TEST_CHECK(second == 1);
+        }
+
+        open = true;
+        jobSystem.wait(blocker);
+        jobSystem.wait(counter);
+    }
+}
+
+int main()
+{
+    testStealing();
+    testCounters();
+    testContinuations();
+    testParallelFor();
+    testParallelReduce();
+    testOwners();
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,112 @@
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Amber/Core/IComponent.h"
+#include "Amber/Core/World.h"
+
+#include "Test.h"
+
+using namespace Amber;
+
+namespace
+{
+    struct Position : Core::IComponent
+    {
+        explicit Position(int value) : value(value) {}
+        int value;
+    };
+
+    struct Velocity : Core::IComponent
+    {
+        explicit Velocity(int value) : value(value) {}
+        int value;
+    };
+}
+
+AMBER_COMPONENT_TYPE(Position, 16)
+AMBER_COMPONENT_TYPE(Velocity, 17)
+
+namespace
+{
+    typedef Core::Query<const Position, const Velocity> ReadQuery;
+
+    std::size_t countVisited(ReadQuery query)
+    {
+        std::size_t count = 0;
+        query.forEachChunk([&count] (std::size_t size, const Position *, const Velocity *) {
+            count += size;
+        });
+
+        return count;
+    }
+
+    std::size_t countValue(ReadQuery query, int value)
+    {
+        std::size_t count = 0;
+        query.forEach([&count, value] (const Position &position, const Velocity &) {
+            count += position.value == value ? 1 : 0;
+        });
+
+        return count;
+    }
+}
+
+int main()
+{
+    const std::size_t EntityCount = 20000;
+
+    Core::World world;
+    std::vector<Core::Entity> entities;
+    for (std::size_t i = 0; i < EntityCount; i++)
+    {
+        Core::Entity entity = world.create();
+        entity.emplaceComponent<Position>(static_cast<int>(i));
+        entity.emplaceComponent<Velocity>(1);
+        entities.push_back(entity);
+    }
+
+    world.advanceChangeVersion();
+    std::uint32_t version = world.getChangeVersion();
+
+    // Nothing was written since the version was taken
+    TEST_CHECK(countVisited(world.query<const Position, const Velocity>().changedSince(version)) == 0);
+    TEST_CHECK(countVisited(world.query<const Position, const Velocity>().changedSince(version - 1)) == EntityCount);
+
+    // A mutable access marks the chunk of that component only
+    entities[5].getComponent<Position>()->value = -1;
+
+    std::size_t positionChanged = countVisited(world.query<const Position, const Velocity>().changedSince<Position>(version));
+    TEST_CHECK(positionChanged > 0 && positionChanged < EntityCount);
+    TEST_CHECK(countValue(world.query<const Position, const Velocity>().changedSince<Position>(version), -1) == 1);
+    TEST_CHECK(countVisited(world.query<const Position, const Velocity>().changedSince<Velocity>(version)) == 0);
+
+    // Const access and const query columns do not count as writes
+    world.advanceChangeVersion();
+    version = world.getChangeVersion();
+
+    const Core::Entity &constEntity = entities[7];
+    TEST_CHECK(constEntity.getComponent<Velocity>()->value == 1);
+    world.query<const Position, const Velocity>().forEach([] (const Position &, const Velocity &) {});
+    TEST_CHECK(countVisited(world.query<const Position, const Velocity>().changedSince(version)) == 0);
+
+    // Iterating a mutable column marks every visited chunk
+    world.query<Position, const Velocity>().forEach([] (Position &position, const Velocity &velocity) {
+        position.value += velocity.value;
+    });
+    TEST_CHECK(countVisited(world.query<const Position, const Velocity>().changedSince<Position>(version)) == EntityCount);
+    TEST_CHECK(countVisited(world.query<const Position, const Velocity>().changedSince<Velocity>(version)) == 0);
+
+    // Arguments may refer to the entity's own components, which move to the
+    // new archetype; the row left behind is filled by the other entity
+    Core::Entity first = world.create();
+    Core::Entity second = world.create();
+    first.emplaceComponent<Position>(10);
+    second.emplaceComponent<Position>(20);
+
+    const Position &position = *first.getComponent<Position>();
+    TEST_CHECK(first.emplaceComponent<Velocity>(position.value)->value == 10);
+    TEST_CHECK(second.getComponent<Position>()->value == 20);
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,156 @@
+#include <cstdint>
+#include <thread>
+
+#include <Eigen/Core>
+
+#include "Amber/Core/Transform.h"
+#include "Amber/Core/World.h"
+#include "Amber/Rendering/Camera.h"
+#include "Amber/Rendering/Material.h"
+#include "Amber/Rendering/Mesh.h"
+#include "Amber/Rendering/RenderSnapshot.h"
+#include "Amber/Rendering/RenderSnapshotBuffer.h"
+#include "Amber/Rendering/Scene.h"
+
+#include "Test.h"
+
+using namespace Amber;
+
+namespace
+{
+    void publish(Rendering::RenderSnapshotBuffer &snapshots, Rendering::Scene &scene, std::uint64_t tick)
+    {
+        snapshots.getBackSnapshot().extract(scene, tick, 1.0f);
+        snapshots.publish();
+    }
+
+    // Rendering on the same thread only sees snapshots once they are published
+    void testSingleThread()
+    {
+        Rendering::Scene scene;
+        Rendering::RenderSnapshotBuffer snapshots;
+
+        TEST_CHECK(snapshots.tryAcquire() == nullptr);
+
+        publish(snapshots, scene, 1);
+        const Rendering::RenderSnapshot *snapshot = snapshots.tryAcquire();
+        TEST_CHECK(snapshot != nullptr && snapshot->getTick() == 1);
+        snapshots.release();
+
+        TEST_CHECK(snapshots.tryAcquire() == nullptr);
+
+        // Only the latest of several published snapshots is seen
+        publish(snapshots, scene, 2);
+        publish(snapshots, scene, 3);
+        snapshot = snapshots.tryAcquire();
+        TEST_CHECK(snapshot != nullptr && snapshot->getTick() == 3);
+        snapshots.release();
+
+        snapshots.close();
+        publish(snapshots, scene, 4);
+        TEST_CHECK(snapshots.tryAcquire() == nullptr);
+        TEST_CHECK(snapshots.acquire() == nullptr);
+    }
+
+    // The writer never touches the snapshot being rendered, and the renderer
+    // sees ticks in order
+    void testSeparateThread()
+    {
+        const std::uint64_t TickCount = 20000;
+
+        Rendering::Scene scene;
+        Rendering::RenderSnapshotBuffer snapshots;
+
+        std::uint64_t renderedCount = 0;
+        std::uint64_t lastTick = 0;
+        bool ordered = true;
+        bool stable = true;
+
+        std::thread renderer([&] () {
+            while (const Rendering::RenderSnapshot *snapshot = snapshots.acquire())
+            {
+                std::uint64_t tick = snapshot->getTick();
+                ordered = ordered && tick > lastTick;
+                lastTick = tick;
+
+                std::this_thread::yield();
+                stable = stable && snapshot->getTick() == tick;
+
+                renderedCount++;
+                snapshots.release();
+            }
+        });
+
+        for (std::uint64_t tick = 1; tick <= TickCount; tick++)
+        {
+            publish(snapshots, scene, tick);
+        }
+
+        snapshots.close();
+
+        // The renderer may still hold a snapshot, publishing must not swap it out
+        for (std::uint64_t tick = TickCount + 1; tick <= TickCount + 100; tick++)
+        {
+            publish(snapshots, scene, tick);
+        }
+
+        renderer.join();
+
+        TEST_CHECK(renderedCount > 0);
+        TEST_CHECK(lastTick <= TickCount);
+        TEST_CHECK(ordered);
+        TEST_CHECK(stable);
+    }
+
+    // Snapshots taken through a camera hold what it saw and where it was,
+    // however it moves afterwards
+    void testCamera()
+    {
+        Core::World world;
+        Rendering::Scene scene;
+        for (float z : { -10.0f, 10.0f })
+        {
+            Eigen::Matrix4f transform = Eigen::Matrix4f::Identity();
+            transform(2, 3) = z;
+
+            Core::Entity entity = world.create();
+            entity.emplaceComponent<Rendering::Mesh>()->setBoundingBox(
+                    Math::BoundingBox{Eigen::Vector3f::Constant(-0.5f), Eigen::Vector3f::Constant(0.5f)});
+            entity.emplaceComponent<Rendering::Material>();
+            entity.emplaceComponent<Core::Transform>(transform, world.getTransformHierarchy());
+            scene.addMesh(entity);
+        }
+
+        Rendering::Camera camera;
+        camera.setLookAt(Eigen::Vector3f::Zero(), Eigen::Vector3f(0.0f, 0.0f, -1.0f), Eigen::Vector3f::UnitY());
+        camera.setPerspectiveProjection(1.0f, 1.0f, 0.1f, 100.0f);
+
+        Rendering::RenderSnapshot snapshot;
+        snapshot.extract(scene, camera, 1, 1.0f);
+        Eigen::Matrix4f viewMatrix = camera.getViewMatrix();
+        Eigen::Matrix4f projectionMatrix = camera.getProjectionMatrix();
+
+        camera.setLookAt(Eigen::Vector3f::Zero(), Eigen::Vector3f(0.0f, 0.0f, 1.0f), Eigen::Vector3f::UnitY());
+        camera.setPerspectiveProjection(2.0f, 1.0f, 0.1f, 100.0f);
+
+        TEST_CHECK(snapshot.getMeshes().size() == 1);
+        TEST_CHECK(snapshot.getMeshes().front().getTransform()(2, 3) == -10.0f);
+        TEST_CHECK(snapshot.getViewMatrix() == viewMatrix);
+        TEST_CHECK(snapshot.getProjectionMatrix() == projectionMatrix);
+        TEST_CHECK(snapshot.getViewMatrix() != camera.getViewMatrix());
+
+        // Without a camera everything is seen from the origin
+        snapshot.extract(scene, 2, 1.0f);
+        TEST_CHECK(snapshot.getMeshes().size() == 2);
+        TEST_CHECK(snapshot.getViewMatrix() == Eigen::Matrix4f::Identity());
+    }
+}
+
+int main()
+{
+    testSingleThread();
+    testSeparateThread();
+    testCamera();
+
+    return TEST_RESULT();
+}
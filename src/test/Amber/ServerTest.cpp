@@ -0,0 +1,128 @@
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "Amber/Core/Game.h"
+#include "Amber/Core/ISystem.h"
+#include "Amber/Core/Server.h"
+
+#include "Test.h"
+
+using namespace Amber;
+
+namespace
+{
+    // The game whose tick the calling thread is in, if any
+    thread_local const Core::Game *tickingGame = nullptr;
+
+    // Spreads busy work over the job system and notes jobs that ran inside
+    // another game's tick
+    class WorkSystem : public Core::ISystem
+    {
+        public:
+            WorkSystem(Core::Game &game, std::size_t jobCount, std::chrono::microseconds jobTime, std::atomic<std::size_t> &foreignJobs)
+                : game(&game),
+                  jobCount(jobCount),
+                  jobTime(jobTime),
+                  foreignJobs(&foreignJobs)
+            {
+            }
+
+            virtual bool isOnSeparateThread() const override
+            {
+                return false;
+            }
+
+            virtual void runSingleIteration() override
+            {
+                const Core::Game *previous = tickingGame;
+                tickingGame = game;
+
+                const Core::Game *owner = game;
+                std::chrono::microseconds time = jobTime;
+                std::atomic<std::size_t> *foreign = foreignJobs;
+                game->getJobSystem().parallelFor(jobCount, [owner, time, foreign] (std::size_t) {
+                    if (tickingGame != nullptr && tickingGame != owner)
+                    {
+                        (*foreign)++;
+                    }
+
+                    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now() + time;
+                    while (std::chrono::steady_clock::now() < end)
+                    {
+                    }
+                }, 1);
+
+                tickingGame = previous;
+            }
+
+            virtual void run() override
+            {
+            }
+
+            virtual void processChanges(const Core::EntityChanges &) override
+            {
+            }
+
+        private:
+            Core::Game *game;
+            std::size_t jobCount;
+            std::chrono::microseconds jobTime;
+            std::atomic<std::size_t> *foreignJobs;
+    };
+
+    Core::Game &addGame(Core::Server &server, std::chrono::nanoseconds budget, std::size_t jobCount, std::chrono::microseconds jobTime,
+                        std::atomic<std::size_t> &foreignJobs)
+    {
+        Core::Game &game = server.addGame(budget);
+        // Due on every iteration, however long the iterations take
+        game.setTickDuration(std::chrono::microseconds(1));
+        game.setMaxFrameDuration(std::chrono::hours(1));
+        game.addSystem(std::unique_ptr<Core::ISystem>(new WorkSystem(game, jobCount, jobTime, foreignJobs)));
+
+        return game;
+    }
+}
+
+int main()
+{
+    const int IterationCount = 50;
+
+    Core::Server server(3);
+    std::atomic<std::size_t> foreignJobs(0);
+
+    // A game that is always over budget next to small ones that never are
+    addGame(server, std::chrono::nanoseconds(1), 1000, std::chrono::microseconds(20), foreignJobs);
+    for (int i = 0; i < 3; i++)
+    {
+        addGame(server, std::chrono::seconds(10), 8, std::chrono::microseconds(200), foreignJobs);
+    }
+
+    for (int i = 0; i < IterationCount; i++)
+    {
+        server.runSingleIteration();
+    }
+
+    // Waiting for its jobs, a game's tick runs none of the other games'
+    TEST_CHECK(foreignJobs == 0);
+
+    for (std::size_t i = 0; i < server.getGameCount(); i++)
+    {
+        const Core::Server::Stats &stats = server.getStats(i);
+        TEST_CHECK(stats.tickCount == static_cast<std::uint64_t>(IterationCount));
+        TEST_CHECK(stats.skippedTickCount == 0);
+        TEST_CHECK(stats.maxTickTime >= stats.lastTickTime);
+        TEST_CHECK(stats.totalTickTime >= stats.maxTickTime);
+        TEST_CHECK(stats.overBudgetCount == (i == 0 ? stats.tickCount : 0));
+    }
+
+    // Removed games are no longer ticked
+    TEST_CHECK(server.removeGame(server.getGame(0)));
+    server.runSingleIteration();
+    TEST_CHECK(server.getGameCount() == 3);
+    TEST_CHECK(server.getStats(0).tickCount == static_cast<std::uint64_t>(IterationCount) + 1);
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,32 @@
+#ifndef TEST_H
+#define TEST_H
+
+#include <cstdio>
+
+// Behaviour tests are plain executables; a failed check is reported and
+// makes main() return non-zero through TEST_RESULT
+namespace Amber
+{
+    namespace Test
+    {
+        inline int &failureCount()
+        {
+            static int count = 0;
+            return count;
+        }
+    }
+}
+
+#define TEST_CHECK(condition) \
+    do \
+    { \
+        if (!(condition)) \
+        { \
+            std::fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+            Amber::Test::failureCount()++; \
+        } \
+    } while (false)
+
+#define TEST_RESULT() (Amber::Test::failureCount() == 0 ? 0 : 1)
+
+#endif // TEST_H
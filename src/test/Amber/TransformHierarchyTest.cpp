@@ -0,0 +1,170 @@
+#include <cstddef>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+#include <Eigen/StdVector>
+
+#include "Amber/Core/TransformHierarchy.h"
+
+#include "Test.h"
+
+using namespace Amber;
+
+namespace
+{
+    // The per-node transforms the hierarchy replaced: world matrices are the
+    // product of the local matrices up the parent chain
+    struct LegacyNode
+    {
+        Core::TransformHierarchy::Node node;
+        Eigen::Matrix4f localTransform;
+        int parent;
+        bool alive;
+    };
+
+    typedef std::vector<LegacyNode, Eigen::aligned_allocator<LegacyNode>> LegacyNodes;
+
+    Eigen::Matrix4f computeLegacyTransform(const LegacyNodes &nodes, int node)
+    {
+        return nodes[node].parent < 0 ? nodes[node].localTransform
+                                      : Eigen::Matrix4f(computeLegacyTransform(nodes, nodes[node].parent) * nodes[node].localTransform);
+    }
+
+    bool isAncestor(const LegacyNodes &nodes, int ancestor, int node)
+    {
+        for (int i = node; i >= 0; i = nodes[i].parent)
+        {
+            if (i == ancestor)
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    Eigen::Matrix4f createTransform(std::mt19937 &random)
+    {
+        std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+
+        Eigen::Affine3f transform = Eigen::Affine3f::Identity();
+        transform.translate(Eigen::Vector3f(distribution(random), distribution(random), distribution(random)));
+        transform.rotate(Eigen::AngleAxisf(distribution(random), Eigen::Vector3f(distribution(random), 1.0f, distribution(random)).normalized()));
+
+        return transform.matrix();
+    }
+}
+
+int main()
+{
+    std::mt19937 random(7);
+
+    Core::TransformHierarchy hierarchy;
+    LegacyNodes nodes;
+    std::vector<int> alive;
+
+    auto pick = [&random, &alive] () {
+        return alive[random() % alive.size()];
+    };
+
+    for (int step = 0; step < 5000; step++)
+    {
+        int operation = random() % 10;
+
+        if (operation < 4 || alive.size() < 2)
+        {
+            // Children are created under any node, not only below the last one
+            int parent = alive.empty() || random() % 4 == 0 ? -1 : pick();
+            Eigen::Matrix4f localTransform = createTransform(random);
+
+            Core::TransformHierarchy::Node node = hierarchy.create(localTransform, parent < 0 ? Core::TransformHierarchy::None : nodes[parent].node);
+            nodes.push_back(LegacyNode { node, localTransform, parent, true });
+            alive.push_back(static_cast<int>(nodes.size()) - 1);
+        }
+        else if (operation < 8)
+        {
+            int node = pick();
+            nodes[node].localTransform = createTransform(random);
+            hierarchy.setLocalTransform(nodes[node].node, nodes[node].localTransform);
+        }
+        else if (operation < 9)
+        {
+            int node = pick();
+            int parent = random() % 3 == 0 ? -1 : pick();
+
+            if (parent >= 0 && isAncestor(nodes, node, parent))
+            {
+                bool thrown = false;
+                try
+                {
+                    hierarchy.setParent(nodes[node].node, nodes[parent].node);
+                }
+                catch (const std::invalid_argument &)
+                {
+                    thrown = true;
+                }
+                TEST_CHECK(thrown);
+            }
+            else
+            {
+                hierarchy.setParent(nodes[node].node, parent < 0 ? Core::TransformHierarchy::None : nodes[parent].node);
+                nodes[node].parent = parent;
+            }
+        }
+        else
+        {
+            // Released nodes live on as long as their descendants
+            std::size_t index = random() % alive.size();
+            hierarchy.release(nodes[alive[index]].node);
+            nodes[alive[index]].alive = false;
+            alive.erase(alive.begin() + index);
+        }
+
+        if (step % 5 == 0)
+        {
+            hierarchy.update();
+
+            for (int node : alive)
+            {
+                TEST_CHECK(hierarchy.getWorldTransform(nodes[node].node).isApprox(computeLegacyTransform(nodes, node), 1e-4f));
+            }
+        }
+    }
+
+    // Nothing changes without new local transforms
+    hierarchy.update();
+    for (int node : alive)
+    {
+        Eigen::Matrix4f worldTransform = hierarchy.getWorldTransform(nodes[node].node);
+        hierarchy.update();
+        TEST_CHECK(hierarchy.getWorldTransform(nodes[node].node) == worldTransform);
+    }
+
+    // Moving a node changes its subtree and nothing else, also across rebuilds
+    {
+        Core::TransformHierarchy changes;
+        Core::TransformHierarchy::Node root = changes.create(Eigen::Matrix4f::Identity());
+        Core::TransformHierarchy::Node other = changes.create(Eigen::Matrix4f::Identity());
+        Core::TransformHierarchy::Node child = changes.create(Eigen::Matrix4f::Identity(), root);
+        changes.update();
+
+        TEST_CHECK(changes.getUpdateCount() == 1);
+        TEST_CHECK(changes.getLastChange(root) == 1 && changes.getLastChange(child) == 1 && changes.getLastChange(other) == 1);
+
+        changes.setLocalTransform(root, createTransform(random));
+        changes.update();
+        TEST_CHECK(changes.getLastChange(root) == 2 && changes.getLastChange(child) == 2 && changes.getLastChange(other) == 1);
+
+        changes.update();
+        TEST_CHECK(changes.getUpdateCount() == 3 && changes.getLastChange(root) == 2);
+
+        changes.setParent(other, child);
+        changes.update();
+        TEST_CHECK(changes.getLastChange(other) == 4 && changes.getLastChange(root) == 2 && changes.getLastChange(child) == 2);
+    }
+
+    return TEST_RESULT();
+}
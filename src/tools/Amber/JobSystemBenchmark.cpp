@@ -0,0 +1,133 @@
+// Measures how the job system scales from one thread up to the given number.
+// Each run uses a fresh system with one worker fewer than the thread count,
+// as the calling thread helps while it waits.
+//
+// Usage: JobSystemBenchmark [threads] [items] [repetitions] [pin]
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include "Amber/Utilities/JobSystem.h"
+
+namespace
+{
+    // Enough arithmetic per item that memory bandwidth does not dominate
+    float work(std::size_t item)
+    {
+        float x = static_cast<float>(item % 1024) * 0.001f;
+        for (int i = 0; i < 64; i++)
+        {
+            x = std::sin(x) * 0.5f + std::cos(x) * 0.5f;
+        }
+
+        return x;
+    }
+
+    template <typename F>
+    double measure(std::size_t repetitions, F f)
+    {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < repetitions; i++)
+        {
+            f();
+        }
+
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        return elapsed.count() / repetitions;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    using namespace Amber;
+
+    std::size_t threads = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : std::max(1u, std::thread::hardware_concurrency());
+    std::size_t items = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 1000000;
+    std::size_t repetitions = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 10;
+    bool pin = argc > 4 && std::strtoul(argv[4], nullptr, 10) != 0;
+
+    std::vector<float> results(items);
+    double checksum = 0.0;
+
+    double baseFor = 0.0;
+    double baseReduce = 0.0;
+    double baseGraph = 0.0;
+
+    std::cout << items << " items, " << repetitions << " repetitions" << (pin ? ", pinned workers" : "") << std::endl;
+    std::cout << "threads   parallelFor ms   parallelReduce ms   graph ms   speedup (for/reduce/graph)" << std::endl;
+
+    for (std::size_t threadCount = 1; threadCount <= threads; threadCount++)
+    {
+        Utilities::JobSystem jobSystem(threadCount - 1, pin);
+
+        double forTime = measure(repetitions, [&] () {
+            jobSystem.parallelFor(items, [&results] (std::size_t i) {
+                results[i] = work(i);
+            });
+        });
+
+        double reduceTime = measure(repetitions, [&] () {
+            checksum += jobSystem.parallelReduce(items, 0.0, [] (std::size_t i) {
+                return static_cast<double>(work(i));
+            }, [] (double a, double b) {
+                return a + b;
+            });
+        });
+
+        // A chain of stages, each fanning out into small jobs that wait for
+        // the previous stage through a counter
+        std::size_t stages = 16;
+        std::size_t jobsPerStage = 64;
+        std::size_t itemsPerJob = std::max<std::size_t>(1, items / (stages * jobsPerStage));
+
+        double graphTime = measure(repetitions, [&] () {
+            Utilities::JobSystem::Counter previous;
+            for (std::size_t stage = 0; stage < stages; stage++)
+            {
+                Utilities::JobSystem::Counter current;
+                for (std::size_t job = 0; job < jobsPerStage; job++)
+                {
+                    std::size_t begin = (stage * jobsPerStage + job) * itemsPerJob;
+                    jobSystem.submitAfter(previous, [&results, begin, itemsPerJob] () {
+                        for (std::size_t i = begin; i < begin + itemsPerJob && i < results.size(); i++)
+                        {
+                            results[i] = work(i);
+                        }
+                    }, current);
+                }
+
+                previous = current;
+            }
+
+            jobSystem.wait(previous);
+        });
+
+        if (threadCount == 1)
+        {
+            baseFor = forTime;
+            baseReduce = reduceTime;
+            baseGraph = graphTime;
+        }
+
+        std::cout << std::fixed << std::setprecision(2)
+                  << std::setw(7) << threadCount
+                  << std::setw(17) << forTime
+                  << std::setw(20) << reduceTime
+                  << std::setw(11) << graphTime
+                  << "   " << baseFor / forTime << " / " << baseReduce / reduceTime << " / " << baseGraph / graphTime << std::endl;
+    }
+
+    for (float result : results)
+    {
+        checksum += result;
+    }
+
+    std::cout << "Checksum: " << checksum << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,216 @@
+// Compares world transform propagation of the transform hierarchy against the
+// previous per-node implementation, which stored Eigen::Matrix4f values and
+// recomputed world matrices lazily by recursing up the parent chain.
+//
+// Usage: TransformBenchmark [characters] [bones] [frames]
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+#include <Eigen/StdVector>
+
+#include "Amber/Core/Transform.h"
+#include "Amber/Core/TransformHierarchy.h"
+
+namespace
+{
+    class LegacyTransform
+    {
+        public:
+            LegacyTransform(Eigen::Matrix4f transform, LegacyTransform *parent)
+                : localTransform(std::move(transform)),
+                  parent(parent),
+                  dirty(true)
+            {
+                if (parent != nullptr)
+                {
+                    parent->children.push_back(this);
+                }
+            }
+
+            const Eigen::Matrix4f &getTransform() const
+            {
+                if (dirty)
+                {
+                    calculatedTransform = parent != nullptr ? parent->getTransform() * localTransform : localTransform;
+                    dirty = false;
+                }
+
+                return calculatedTransform;
+            }
+
+            void setLocalTransform(Eigen::Matrix4f localTransform)
+            {
+                this->localTransform = std::move(localTransform);
+                markDirty();
+            }
+
+        private:
+            void markDirty()
+            {
+                dirty = true;
+                for (LegacyTransform *child : children)
+                {
+                    child->markDirty();
+                }
+            }
+
+            Eigen::Matrix4f localTransform;
+            LegacyTransform *parent;
+            std::vector<LegacyTransform *> children;
+
+            mutable Eigen::Matrix4f calculatedTransform;
+            mutable bool dirty;
+    };
+
+    // Skeleton bones hang off the previous bone or one of the first few, the
+    // way limbs branch off a spine
+    std::size_t getParentBone(std::size_t bone)
+    {
+        return bone < 4 ? bone - 1 : (bone % 3 == 0 ? bone % 4 : bone - 1);
+    }
+
+    // Poses are computed up front so that only transform updates are measured
+    const std::size_t PoseCount = 16;
+
+    Eigen::Matrix4f createBonePose(std::size_t bone, std::size_t frame)
+    {
+        Eigen::Affine3f pose = Eigen::Affine3f::Identity();
+        pose.translate(Eigen::Vector3f(0.0f, 0.1f, 0.0f));
+        pose.rotate(Eigen::AngleAxisf(0.01f * static_cast<float>((bone + frame) % 100), Eigen::Vector3f::UnitZ()));
+
+        return pose.matrix();
+    }
+
+    template <typename F>
+    double measure(std::size_t frames, std::size_t nodes, F frame)
+    {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < frames; i++)
+        {
+            frame(i);
+        }
+
+        std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+        return elapsed.count() / static_cast<double>(frames * nodes);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    using namespace Amber;
+
+    std::size_t characters = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000;
+    std::size_t bones = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 50;
+    std::size_t frames = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 100;
+    std::size_t nodes = characters * bones;
+
+    std::vector<Eigen::Matrix4f, Eigen::aligned_allocator<Eigen::Matrix4f>> poses;
+    for (std::size_t frame = 0; frame < PoseCount; frame++)
+    {
+        for (std::size_t bone = 0; bone < bones; bone++)
+        {
+            poses.push_back(createBonePose(bone, frame));
+        }
+    }
+
+    auto getBonePose = [&poses, bones] (std::size_t bone, std::size_t frame) -> const Eigen::Matrix4f & {
+        return poses[(frame % PoseCount) * bones + bone];
+    };
+
+    std::vector<std::unique_ptr<LegacyTransform>> legacy;
+    legacy.reserve(nodes);
+
+    Core::TransformHierarchy hierarchy;
+    std::vector<Core::Transform> transforms;
+    transforms.reserve(nodes);
+
+    for (std::size_t character = 0; character < characters; character++)
+    {
+        std::size_t root = character * bones;
+        for (std::size_t bone = 0; bone < bones; bone++)
+        {
+            Eigen::Matrix4f pose = getBonePose(bone, 0);
+            if (bone == 0)
+            {
+                legacy.emplace_back(new LegacyTransform(pose, nullptr));
+                transforms.emplace_back(pose, hierarchy);
+            }
+            else
+            {
+                std::size_t parent = root + getParentBone(bone);
+                legacy.emplace_back(new LegacyTransform(pose, legacy[parent].get()));
+                transforms.emplace_back(pose, transforms[parent]);
+            }
+        }
+    }
+
+    // Every bone is animated every frame, then every world transform is read
+    double checksum = 0.0;
+
+    double legacyTime = measure(frames, nodes, [&] (std::size_t frame) {
+        for (std::size_t i = 0; i < nodes; i++)
+        {
+            legacy[i]->setLocalTransform(getBonePose(i % bones, frame));
+        }
+
+        for (std::size_t i = 0; i < nodes; i++)
+        {
+            checksum += legacy[i]->getTransform()(0, 3);
+        }
+    });
+
+    double hierarchyTime = measure(frames, nodes, [&] (std::size_t frame) {
+        for (std::size_t i = 0; i < nodes; i++)
+        {
+            transforms[i].setLocalTransform(getBonePose(i % bones, frame));
+        }
+
+        hierarchy.update();
+
+        for (std::size_t i = 0; i < nodes; i++)
+        {
+            checksum -= transforms[i].getTransform()(0, 3);
+        }
+    });
+
+    // Propagation alone, with only the roots moving
+    double legacyRootTime = measure(frames, nodes, [&] (std::size_t frame) {
+        for (std::size_t i = 0; i < nodes; i += bones)
+        {
+            legacy[i]->setLocalTransform(getBonePose(0, frame));
+        }
+
+        for (std::size_t i = 0; i < nodes; i++)
+        {
+            legacy[i]->getTransform();
+        }
+    });
+
+    double hierarchyRootTime = measure(frames, nodes, [&] (std::size_t frame) {
+        for (std::size_t i = 0; i < nodes; i += bones)
+        {
+            transforms[i].setLocalTransform(getBonePose(0, frame));
+        }
+
+        hierarchy.update();
+    });
+
+#ifdef AMBER_SSE
+    const char *kernel = "SSE";
+#else
+    const char *kernel = "scalar";
+#endif
+
+    std::cout << characters << " characters x " << bones << " bones, " << frames << " frames, " << kernel << " kernel" << std::endl;
+    std::cout << "Animate all, ns per node:  legacy " << legacyTime << ", hierarchy " << hierarchyTime << std::endl;
+    std::cout << "Move roots, ns per node:   legacy " << legacyRootTime << ", hierarchy " << hierarchyRootTime << std::endl;
+    std::cout << "Checksum difference: " << checksum << std::endl;
+
+    return 0;
+}